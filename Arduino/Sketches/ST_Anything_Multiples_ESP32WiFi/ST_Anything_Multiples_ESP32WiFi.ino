@@ -33,6 +33,7 @@
 //    ----        ---            ----
 //    2017-08-14  Dan Ogorchock  Original Creation - Adapted from ESP8266 to work with ESP32 board
 //    2018-02-09  Dan Ogorchock  Added support for Hubitat Elevation Hub
+//    2026-10-18  agent          Added the optional SmartThingsTask network task
 //
 //   Special thanks to Joshua Spain for his contributions in porting ST_Anything to the ESP32!
 //
@@ -41,6 +42,7 @@
 // SmartThings Library for ESP32WiFi
 //******************************************************************************************
 #include <SmartThingsESP32WiFi.h>
+#include <SmartThingsTask.h>     //Optional - runs the WiFi communications in their own FreeRTOS task (see setup())
 
 //******************************************************************************************
 // ST_Anything Library 
@@ -281,6 +283,9 @@ void setup()
     //DHCP IP Assigment - Must set your router's DHCP server to provice a static IP address for this device's MAC address
     //st::Everything::SmartThing = new st::SmartThingsESP32WiFi(str_ssid, str_password, serverPort, hubIp, hubPort, st::receiveSmartString);
 
+    //Optional - move the WiFi communications to their own task on the other core, so a slow Hub never holds up the sensors
+    //st::Everything::SmartThing = new st::SmartThingsTask(st::Everything::SmartThing);
+
   //Run the Everything class' init() routine which establishes WiFi communications with SmartThings Hub
   st::Everything::init();
   
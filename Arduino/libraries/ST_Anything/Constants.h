@@ -40,6 +40,20 @@
 //    2016-06-04  Dan Ogorchock  Added improved support for Arduino Leonardo
 //    2017-02-07  Dan Ogorchock  Added support for new SmartThings v2.0 library (ThingShield, W5100, ESP8266)
 //    2017-08-14  Dan Ogorchock  Added support for ESP32
+//    2026-10-18  agent          Replaced RETURN_STRING_RESERVE with per board MESSAGE_QUEUE_SIZE / MESSAGE_SLOT_SIZE
+//    2026-10-18  agent          Added MAX_HARDWARE_INTERRUPTS / INTERRUPT_EDGE_QUEUE_SIZE for InterruptSensor's hardware interrupt mode
+//    2026-10-18  agent          Added ENABLE_PROFILER and PROFILER_REPORT_INTERVAL
+//    2026-10-18  agent          Added MEMORY_SAMPLE_INTERVAL and MEMORY_REPORT_INTERVAL
+//    2026-10-18  agent          Device capacity and queue size can be overridden with build flags (ST_MAX_SENSOR_COUNT, ...), 16 bit device counts, static RAM cost check
+//    2026-10-18  agent          Added NETWORK_TASK_* settings for SmartThingsTask
+//    2026-10-18  agent          Added ENABLE_MESSAGE_SPOOL and the SPOOL_* settings for st::MessageSpool
+//    2026-10-18  agent          MESSAGE_SLOT_SIZE holds the longest message a bundled device sends (MAX_VALUE_LENGTH), on every board
+//    2026-10-18  agent          Added FLUSH_WAIT_TIMEOUT
+//    2026-10-18  agent          MESSAGE_SLOT_SIZE can be overridden with ST_MESSAGE_SLOT_SIZE.  NOTE: a message longer than MESSAGE_SLOT_SIZE-1
+//                               (65 characters by default) is dropped - the old Return_String carried up to about 250 characters in total.
+//                               Sketches that send longer messages of their own must raise ST_MESSAGE_SLOT_SIZE (at most 255).
+//    2026-10-18  agent          MESSAGE_QUEUE_SIZE is 16 bit (ST_MESSAGE_QUEUE_SIZE is no longer limited to 255); added BATCH_MAX_MESSAGES
+//    2026-10-18  agent          Added ENABLE_REFRESH_SNAPSHOT - refreshSnapshot and the per-Device send times it needs are compiled only if it is defined
 //
 //******************************************************************************************
 
@@ -52,6 +66,9 @@
 //#define ENABLE_SERIAL			//If uncommented, will allow you to type in commands via the Arduino Serial Console Window (useful for debugging)
 //#define DISABLE_SMARTTHINGS	//If uncommented, will disable all ST Shield Library calls (e.g. you want to use this library without SmartThings for a different application)
 //#define DISABLE_REFRESH		//If uncommented, will disable periodic refresh of the sensors and executors states to the ST Cloud - improves performance, but may reduce data integrity
+//#define ENABLE_PROFILER		//If uncommented, will time every Device's update(), getData() and beSmart() calls (see Profiler.h) - uses extra RAM, intended for debugging
+//#define ENABLE_MESSAGE_SPOOL	//If uncommented, messages that cannot be sent while the WiFi/Ethernet link is down are kept in flash/EEPROM and sent once it is back (see MessageSpool.h) - ESP8266, ESP32 and AVR only
+//#define ENABLE_REFRESH_SNAPSHOT	//If uncommented, st::Everything::refreshSnapshot can be set (see Everything.h) - every Device then remembers when it last sent (4 bytes of RAM each)
 
 #if defined(__AVR_ATmega168__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega328P__) || defined(ARDUINO_AVR_UNO)
 #define BOARD_UNO
@@ -69,6 +86,85 @@
 #define BOARD_UNO	//assume user is using an UNO for the unknown case
 #endif
 
+//Device capacity and message queue size - the defaults for each board are below.  To change them for one sketch without
+//editing this file, define them as build flags, e.g. PlatformIO "build_flags = -DST_MAX_SENSOR_COUNT=80 -DST_MAX_EXECUTOR_COUNT=8"
+//or arduino-cli "--build-property compiler.cpp.extra_flags=-DST_MAX_SENSOR_COUNT=80".  (A #define in the sketch itself does
+//not reach the library's .cpp files.)  Every sensor costs 4 pointers of RAM and every executor 2, used or not.
+#if defined(BOARD_MEGA) || defined(BOARD_MKR1000) || defined(BOARD_ESP8266) || defined(BOARD_ESP32)
+	#ifndef ST_MAX_SENSOR_COUNT
+		#define ST_MAX_SENSOR_COUNT 30
+	#endif
+	#ifndef ST_MAX_EXECUTOR_COUNT
+		#define ST_MAX_EXECUTOR_COUNT 20
+	#endif
+#else
+	#ifndef ST_MAX_SENSOR_COUNT
+		#define ST_MAX_SENSOR_COUNT 10
+	#endif
+	#ifndef ST_MAX_EXECUTOR_COUNT
+		#define ST_MAX_EXECUTOR_COUNT 10
+	#endif
+#endif
+
+#if defined(BOARD_ESP32)
+	#ifndef ST_MESSAGE_QUEUE_SIZE
+		#define ST_MESSAGE_QUEUE_SIZE 64
+	#endif
+	#ifndef ST_STATIC_RAM_BUDGET
+		#define ST_STATIC_RAM_BUDGET 32768
+	#endif
+#elif defined(BOARD_ESP8266)
+	#ifndef ST_MESSAGE_QUEUE_SIZE
+		#define ST_MESSAGE_QUEUE_SIZE 32
+	#endif
+	#ifndef ST_STATIC_RAM_BUDGET
+		#define ST_STATIC_RAM_BUDGET 16384
+	#endif
+#elif defined(BOARD_MEGA) || defined(BOARD_MKR1000)
+	#ifndef ST_MESSAGE_QUEUE_SIZE
+		#define ST_MESSAGE_QUEUE_SIZE 16
+	#endif
+	#ifndef ST_STATIC_RAM_BUDGET
+		#if defined(BOARD_MEGA)
+			#define ST_STATIC_RAM_BUDGET 2048		//of 8K
+		#else
+			#define ST_STATIC_RAM_BUDGET 8192		//of 32K
+		#endif
+	#endif
+#else
+	#ifndef ST_MESSAGE_QUEUE_SIZE
+		#define ST_MESSAGE_QUEUE_SIZE 4			//Do not make too large due to UNO's 2K SRAM limitation
+	#endif
+	#ifndef ST_STATIC_RAM_BUDGET
+		#define ST_STATIC_RAM_BUDGET (256UL * sizeof(void*))	//512 bytes of the UNO's 2K (the rest is needed for the stack, Strings and the network library) - scaled for unknown boards with wider pointers
+	#endif
+#endif
+
+//Longest message a queue slot holds, including the null terminator.  By default (MAX_NAME_LENGTH + MAX_VALUE_LENGTH + 1 = 66) it fits
+//every message a bundled device sends; a longer message is dropped (and counted by st::MessageQueue).  A sketch that sends longer
+//messages of its own can raise it (up to 255) with a build flag, e.g. "-DST_MESSAGE_SLOT_SIZE=128" - every queue slot, and every
+//spooled message, then takes that much RAM/flash.
+//#define ST_MESSAGE_SLOT_SIZE 128
+
+#if defined(DISABLE_SMARTTHINGS)
+	#undef ENABLE_MESSAGE_SPOOL		//there is no link to wait for
+#endif
+#if defined(ENABLE_MESSAGE_SPOOL)
+	//st::MessageSpool storage - ESP8266/ESP32: maximum size of the spool file on LittleFS; AVR: bytes of EEPROM used, from ST_SPOOL_EEPROM_ADDRESS on
+	#ifndef ST_SPOOL_SIZE
+		#if defined(BOARD_ESP32) || defined(BOARD_ESP8266)
+			#define ST_SPOOL_SIZE 16384
+		#elif defined(BOARD_MEGA)
+			#define ST_SPOOL_SIZE 2048		//of 4K
+		#else
+			#define ST_SPOOL_SIZE 512		//of the UNO's 1K
+		#endif
+	#endif
+	#ifndef ST_SPOOL_EEPROM_ADDRESS
+		#define ST_SPOOL_EEPROM_ADDRESS 0	//move the spool up if the sketch keeps its own settings at the start of the EEPROM
+	#endif
+#endif
+
 namespace st
 {
 	class Constants
@@ -80,25 +176,67 @@ namespace st
 			//Serial debug console baud rate
 			static const unsigned long SERIAL_BAUDRATE=115200;			//Uncomment If NOT using pins 0,1 for ST Shield communications (default)
 			//static const unsigned int SERIAL_BAUDRATE=2400;			//Uncomment if using Pins 0,1 for ST Shield Communications
-			#if defined(BOARD_MEGA) || defined(BOARD_MKR1000) || defined(BOARD_ESP8266) || defined(BOARD_ESP32)
-				//Maximum number of SENSOR objects
-				static const byte MAX_SENSOR_COUNT=30;					//Used to limit the number of sensor devices allowed.  Be careful on Arduino UNO due to 2K SRAM limitation 
-				//Maximum number of EXECUTOR objects
-				static const byte MAX_EXECUTOR_COUNT=20;				//Used to limit the number of executor devices allowed.  Be careful on Arduino UNO due to 2K SRAM limitation 
+			//Maximum number of SENSOR objects (see ST_MAX_SENSOR_COUNT above)
+			static const uint16_t MAX_SENSOR_COUNT=ST_MAX_SENSOR_COUNT;		//Used to limit the number of sensor devices allowed.  Be careful on Arduino UNO due to 2K SRAM limitation 
+			//Maximum number of EXECUTOR objects (see ST_MAX_EXECUTOR_COUNT above)
+			static const uint16_t MAX_EXECUTOR_COUNT=ST_MAX_EXECUTOR_COUNT;	//Used to limit the number of executor devices allowed.  Be careful on Arduino UNO due to 2K SRAM limitation 
+			//Devices held in a st::Registry<...> do not count against either limit
+			//Outbound message queue - a ring buffer of MESSAGE_QUEUE_SIZE slots, each able to hold one message of up to MESSAGE_SLOT_SIZE-1 characters
+			//(sized independently of the device count - see ST_MESSAGE_QUEUE_SIZE above)
+			static const uint16_t MESSAGE_QUEUE_SIZE = ST_MESSAGE_QUEUE_SIZE;	//Maximum number of messages waiting to be sent to the hub
+			//Most queued messages st::Everything sends in one batch (batching enabled, or a refresh snapshot) - the rest go in the next one
+			static const byte BATCH_MAX_MESSAGES = MESSAGE_QUEUE_SIZE < 16 ? MESSAGE_QUEUE_SIZE : 16;
+			//Longest value (the text after "name ") sent by any bundled device - PS_AdafruitTCS34725_Illum_Color's "lux:colorTemp:red:green:blue:clear" (six 16 bit numbers)
+			static const byte MAX_VALUE_LENGTH = 35;
+			#if defined(ST_MESSAGE_SLOT_SIZE)
+				static const byte MESSAGE_SLOT_SIZE = ST_MESSAGE_SLOT_SIZE;	//Maximum length of one message (including null terminator!) - see ST_MESSAGE_SLOT_SIZE above
 			#else
-				//Maximum number of SENSOR objects
-				static const byte MAX_SENSOR_COUNT = 10;				//Used to limit the number of sensor devices allowed.  Be careful on Arduino UNO due to 2K SRAM limitation 
-				//Maximum number of EXECUTOR objects
-				static const byte MAX_EXECUTOR_COUNT = 10;				//Used to limit the number of executor devices allowed.  Be careful on Arduino UNO due to 2K SRAM limitation 
+				static const byte MESSAGE_SLOT_SIZE = MAX_NAME_LENGTH + MAX_VALUE_LENGTH + 1;	//Maximum length of one message (including null terminator!) - the longest name, a space and the longest value
+			#endif
+
+			//RAM used by st::Everything's device tables (m_Sensors, m_LoopSensors, m_PollSchedule, m_Executors and the name index) and the message queue
+			static const unsigned long DEVICE_TABLE_RAM = (unsigned long)sizeof(void*) * (4UL * MAX_SENSOR_COUNT + 2UL * MAX_EXECUTOR_COUNT);
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				static const unsigned long MESSAGE_QUEUE_RAM = (unsigned long)MESSAGE_QUEUE_SIZE * (MESSAGE_SLOT_SIZE + sizeof(unsigned long));	//each slot also remembers when it was queued
+			#else
+				static const unsigned long MESSAGE_QUEUE_RAM = (unsigned long)MESSAGE_QUEUE_SIZE * MESSAGE_SLOT_SIZE;
+			#endif
+			//InterruptSensors using hardware interrupt mode (see InterruptSensor::enableHardwareInterrupt()) - each one uses one attachInterrupt() slot and one edge queue
+			#if defined(BOARD_ESP32) || defined(BOARD_ESP8266) || defined(BOARD_MKR1000)
+				static const byte MAX_HARDWARE_INTERRUPTS = 8;			//Maximum number of InterruptSensors in hardware interrupt mode
+				static const byte INTERRUPT_EDGE_QUEUE_SIZE = 16;		//Edges buffered per sensor between run() passes (power of 2) - if it overflows, the pin is simply re-read
+			#elif defined(BOARD_MEGA)
+				static const byte MAX_HARDWARE_INTERRUPTS = 6;			//The MEGA has 6 external interrupt pins (2, 3, 18, 19, 20, 21)
+				static const byte INTERRUPT_EDGE_QUEUE_SIZE = 8;
+			#else
+				static const byte MAX_HARDWARE_INTERRUPTS = 2;			//The UNO has 2 external interrupt pins (2, 3)
+				static const byte INTERRUPT_EDGE_QUEUE_SIZE = 8;
+			#endif
+			#if defined(ENABLE_PROFILER)
+				static const int PROFILER_REPORT_INTERVAL=600;		//seconds - how often the profiler summary is sent to the hub and printed to Serial
+			#endif
+			//Memory telemetry (see MemoryStats.h)
+			static const int MEMORY_SAMPLE_INTERVAL=10;			//seconds - how often free heap, largest free block, fragmentation and stack headroom are measured
+			static const int MEMORY_REPORT_INTERVAL=600;		//seconds - how often the measurements are sent to the hub, if st::Everything::reportMemory is true
+			//SmartThingsTask (ESP32) - runs the communication method in its own FreeRTOS task, see SmartThingsTask.h
+			static const byte NETWORK_TASK_OUTBOUND_QUEUE_SIZE = 16;	//Messages buffered for the network task (power of 2, holds one fewer) - sized for a stalled connection at the default transmit interval
+			static const byte NETWORK_TASK_INBOUND_QUEUE_SIZE = 8;		//Hub commands buffered for the device loop (power of 2, holds one fewer)
+			static const uint16_t NETWORK_TASK_STACK_SIZE = 8192;		//bytes - the WiFi client and the transport's Strings run on this stack
+			static const byte NETWORK_TASK_PRIORITY = 1;				//same as the Arduino loop() task
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				//Message spool (see MessageSpool.h) - keeps the messages that could not be sent while the link was down
+				static const unsigned long SPOOL_SIZE = ST_SPOOL_SIZE;					//bytes of flash/EEPROM the spool may use (see ST_SPOOL_SIZE above)
+				static const unsigned int SPOOL_EEPROM_ADDRESS = ST_SPOOL_EEPROM_ADDRESS;	//AVR - first EEPROM address used by the spool
+				static const unsigned int SPOOL_REPLAY_INTERVAL = 1000;					//milliseconds - minimum time between two spooled messages once the link is back (new messages wait behind them, to keep the order)
 			#endif
-			//Size of reserved return string
-			static const byte RETURN_STRING_RESERVE = (MAX_SENSOR_COUNT + MAX_EXECUTOR_COUNT) * 5;	//Do not make too large due to UNO's 2K SRAM limitation
 			//Interval on which Device's refresh methods are called (in seconds) - most useful for Executors and InterruptSensors - only works if DISABLE_REFRESH is not defined above
 			static const int DEV_REFRESH_INTERVAL=300;				//seconds - Used to make sure the ST Cloud is kept current with device status (in case of missed updates to the ST Cloud) - primarily for Executors and InterruptSensors - only works if DISABLE_REFRESH is not defined above
 
 			//NOTE:  The following constant was removed and replaced by a user defineable interval in the SmartThings library constaructors to permit different values for each communication method (i.e. ThingShield requires 1000ms, whereas Ethernet is ~100ms) 
 			//Minumum interval between sending packets of data to ThingShield (in milliseconds) - noticed issue where ST Hub/Cloud could not keep up with rapid data transfer
 			//static const int SENDSTRINGS_INTERVAL = 100;
+			//Longest time st::Everything::flushStrings() (setup, sendSmartStringNow()) waits for the communication method to become ready to send - after that the messages stay queued and run() sends them
+			static const unsigned int FLUSH_WAIT_TIMEOUT = 5000;	//milliseconds
 			// ------------------------------------------------------------------------------- 
 			// --- SmartThings specific items 
 			// -------------------------------------------------------------------------------
@@ -148,7 +286,18 @@ namespace st
 			//#endif
 			// -------------------------------------------------------------------------------
 	};
+
+	//compile time checks of the capacity settings - raise ST_STATIC_RAM_BUDGET if the board really has the RAM to spare
+	static_assert(ST_MAX_SENSOR_COUNT > 0 && ST_MAX_SENSOR_COUNT <= 0xFFFE, "ST_MAX_SENSOR_COUNT must be between 1 and 65534");
+	static_assert(ST_MAX_EXECUTOR_COUNT > 0 && ST_MAX_EXECUTOR_COUNT <= 0xFFFE, "ST_MAX_EXECUTOR_COUNT must be between 1 and 65534");
+	static_assert(ST_MESSAGE_QUEUE_SIZE > 0 && ST_MESSAGE_QUEUE_SIZE <= 0xFFFF, "ST_MESSAGE_QUEUE_SIZE must be between 1 and 65535");
+	#if defined(ST_MESSAGE_SLOT_SIZE)
+		static_assert(ST_MESSAGE_SLOT_SIZE >= Constants::MAX_NAME_LENGTH + Constants::MAX_VALUE_LENGTH + 1 && ST_MESSAGE_SLOT_SIZE <= 255,
+			"ST_MESSAGE_SLOT_SIZE must be between 66 (MAX_NAME_LENGTH + MAX_VALUE_LENGTH + 1 - the bundled devices' messages) and 255");
+	#endif
+	static_assert(Constants::DEVICE_TABLE_RAM + Constants::MESSAGE_QUEUE_RAM <= ST_STATIC_RAM_BUDGET,
+		"device tables + message queue exceed ST_STATIC_RAM_BUDGET - lower ST_MAX_SENSOR_COUNT / ST_MAX_EXECUTOR_COUNT / ST_MESSAGE_QUEUE_SIZE (sensor = 4 pointers, executor = 2 pointers, queue = MESSAGE_QUEUE_SIZE * MESSAGE_SLOT_SIZE bytes)");
 }
 
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
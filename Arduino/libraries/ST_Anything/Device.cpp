@@ -12,6 +12,12 @@
 //    ----        ---            ----
 //    2015-01-03  Dan & Daniel   Original Creation
 //    2018-08-15  Dan Ogorchock  Workaround for strcpy_P() ESP32 crash bug
+//    2026-10-18  agent          Added compareName() for allocation free name lookups
+//    2026-10-18  agent          Added getLastSent()
+//    2026-10-18  agent          Added the st::Profiler slot
+//    2026-10-18  agent          Moved the flash to flash name comparison here from Everything (compareNames())
+//    2026-10-18  agent          16 bit st::Profiler slot
+//    2026-10-18  agent          m_nLastSent only if ENABLE_REFRESH_SNAPSHOT is defined
 //
 //******************************************************************************************
 
@@ -27,6 +33,12 @@ namespace st
 	//constructor
 	Device::Device(const __FlashStringHelper *name):
 		m_pName(name)
+	#if defined(ENABLE_REFRESH_SNAPSHOT)
+		, m_nLastSent(0)
+	#endif
+	#if defined(ENABLE_PROFILER)
+		, m_nProfileSlot(0xFFFF)
+	#endif
 	{
 		if(debug)
 		{
@@ -61,8 +73,35 @@ namespace st
 #endif
 
 	}
+
+	int Device::compareName(const char *str, unsigned int len) const
+	{
+		const char *name = (const char*)m_pName;
+		for (unsigned int i = 0; i < len; i++)
+		{
+			char c = pgm_read_byte(name + i);
+			if (c != str[i])
+			{
+				return (unsigned char)str[i] - (unsigned char)c;
+			}
+		}
+		return 0 - (unsigned char)pgm_read_byte(name + len);	//equal only if the name ends here too
+	}
+
+	int Device::compareNames(const Device *a, const Device *b)
+	{
+		const char *nameA = (const char*)a->m_pName;
+		const char *nameB = (const char*)b->m_pName;
+		char cA, cB;
+		do
+		{
+			cA = pgm_read_byte(nameA++);
+			cB = pgm_read_byte(nameB++);
+		} while (cA != '\0' && cA == cB);
+		return (unsigned char)cA - (unsigned char)cB;
+	}
 	
 
 	//debug flag to determine if debug print statements are executed (set value in your sketch)
 	bool Device::debug=false;
-}
\ No newline at end of file
+}
\ No newline at end of file
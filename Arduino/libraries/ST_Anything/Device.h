@@ -12,6 +12,10 @@
 //    ----        ---            ----
 //    2015-01-03  Dan & Daniel   Original Creation
 //    2019-02-09  Dan Ogorchock  Moved update() from Sensor to Device
+//    2026-10-18  agent          Added getNameF() and compareName() for allocation free name lookups
+//    2026-10-18  agent          Added getLastSent() - kept up to date by st::Everything when refreshSnapshot is enabled
+//    2026-10-18  agent          Added the st::Profiler slot (only if ENABLE_PROFILER is defined in Constants.h)
+//    2026-10-18  agent          m_nLastSent and getLastSent() only exist if ENABLE_REFRESH_SNAPSHOT is defined in Constants.h
 //
 //
 //******************************************************************************************
@@ -21,6 +25,7 @@
 
 #include <Arduino.h>
 //#include <avr/pgmspace.h>
+#include "Constants.h"
 
 namespace st
 {
@@ -28,6 +33,12 @@ namespace st
 	{
 		private:
 			const __FlashStringHelper *m_pName;
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			unsigned long m_nLastSent;	//millis() when a message from this device was last sent to the hub (0 = never/not tracked)
+		#endif
+		#if defined(ENABLE_PROFILER)
+			uint16_t m_nProfileSlot;		//index of this device's histograms in st::Profiler
+		#endif
 			
 		public:
 			//constructor
@@ -48,10 +59,28 @@ namespace st
 
 			//gets
 			const String getName() const;
+			inline const __FlashStringHelper* getNameF() const {return m_pName;}	//name as stored in flash - no String is created
+
+			//compares the first len characters of str against the device name (strcmp() style result, no String is created)
+			int compareName(const char *str, unsigned int len) const;
+
+			//compares the names of two devices directly from flash (strcmp() style result) - used to keep name indexes sorted
+			static int compareNames(const Device *a, const Device *b);
+
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			inline unsigned long getLastSent() const {return m_nLastSent;}
+		#endif
 				
 			//debug flag to determine if debug print statements are executed (set value in your sketch)
 			static bool debug;
+
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			friend class Everything;	//updates m_nLastSent
+		#endif
+		#if defined(ENABLE_PROFILER)
+			friend class Profiler;		//assigns m_nProfileSlot
+		#endif
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -105,17 +105,17 @@ namespace st
 		//}
 
 		if (m_nCurrentAlarmState == both) {
-			Everything::sendSmartString(getName() + F(" both"));
+			Message(getNameF()).value(F("both")).send();
 		}
 		else if(m_nCurrentAlarmState == siren) {
-			Everything::sendSmartString(getName() + F(" siren"));
+			Message(getNameF()).value(F("siren")).send();
 		}
 		else if(m_nCurrentAlarmState == strobe) {
-			Everything::sendSmartString(getName() + F(" strobe"));
+			Message(getNameF()).value(F("strobe")).send();
 		}
 		else if(m_nCurrentAlarmState == off) {
 		//else {
-			Everything::sendSmartString(getName() + F(" off"));
+			Message(getNameF()).value(F("off")).send();
 		}
 	}
 
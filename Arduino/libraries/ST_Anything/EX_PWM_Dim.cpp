@@ -193,8 +193,8 @@ namespace st
 
 	void EX_PWM_Dim::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
-		Everything::sendSmartString(getName() + " " + m_nSetLevel);
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
+		Message(getNameF()).value(m_nSetLevel).send();
 	}
 
 
@@ -160,7 +160,7 @@ namespace st
 	
 	void EX_RGBW_Dim::init()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	void EX_RGBW_Dim::beSmart(const String &str)
@@ -186,12 +186,12 @@ namespace st
 
 		writeRGBWToPins();
 
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_RGBW_Dim::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_RGBW_Dim::setRedPin(byte pin, byte channel)
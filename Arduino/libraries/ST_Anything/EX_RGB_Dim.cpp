@@ -147,7 +147,7 @@ namespace st
 	
 	void EX_RGB_Dim::init()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	void EX_RGB_Dim::beSmart(const String &str)
@@ -173,12 +173,12 @@ namespace st
 
 		writeRGBToPins();
 
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_RGB_Dim::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_RGB_Dim::setRedPin(byte pin, byte channel)
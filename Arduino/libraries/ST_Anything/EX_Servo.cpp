@@ -186,7 +186,13 @@ namespace st
 
 	void EX_Servo::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + String(m_nCurrentLevel) + ":" + String(m_nTargetAngle) + ":" + String(m_nCurrentRate));
+		Message msg(getNameF());
+		msg.value(m_nCurrentLevel);
+		msg.print(':');
+		msg.print(m_nTargetAngle);
+		msg.print(':');
+		msg.print(m_nCurrentRate);
+		msg.send();
 	}
 
 	void EX_Servo::setPWMPin(byte pin)
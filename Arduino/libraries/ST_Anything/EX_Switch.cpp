@@ -57,7 +57,7 @@ namespace st
 	
 	void EX_Switch::init()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	void EX_Switch::beSmart(const String &str)
@@ -78,12 +78,12 @@ namespace st
 		
 		writeStateToPin();
 		
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_Switch::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_Switch::setPin(byte pin)
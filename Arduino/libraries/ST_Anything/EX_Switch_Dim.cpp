@@ -123,8 +123,8 @@ namespace st
 
 	void EX_Switch_Dim::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
-		Everything::sendSmartString(getName() + " " + m_nCurrentLevel);
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
+		Message(getNameF()).value(m_nCurrentLevel).send();
 	}
 
 	void EX_Switch_Dim::setSwitchPin(byte pin)
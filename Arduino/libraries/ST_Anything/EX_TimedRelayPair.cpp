@@ -166,7 +166,7 @@ namespace st
 	void EX_TimedRelayPair::refresh()
 	{
 		//Queue the relay status update the ST Cloud
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("open") : F("closed")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("open") : F("closed")).send();
 	}
 
 	//void EX_TimedRelayPair::setOutputPin(byte pin)
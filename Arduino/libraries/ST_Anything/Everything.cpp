@@ -27,12 +27,40 @@
 //    2019-02-24  Dan Ogorchock  Added new special callOnMsgRcvd2 callback capability. Allows recvd string to be manipulated in the sketch before being processed by Everything.
 //    2021-01-31  Marcus van Ierssel Improved the automatic refresh to prevent it from blocking other updates.
 //    2021-05-23  Dan Ogorchock  Address EXP8266 v3.0.0 board support package compatibility issue with Strings  
+//    2026-10-18  agent          Replaced the '|' delimited Return_String with the fixed slot st::MessageQueue ring buffer
+//    2026-10-18  agent          Made sendStrings() non-blocking - queued messages are paced out by run() instead of delay()
+//    2026-10-18  agent          Added optional coalescing of queued PollingSensor readings (coalesceReadings)
+//    2026-10-18  agent          Send the whole queue in one transmission when the SmartThings object has batching enabled
+//    2026-10-18  agent          getDeviceByName() uses a sorted name index (binary search, no String allocations)
+//    2026-10-18  agent          Added const char* versions of sendSmartString()/sendSmartStringNow() for st::Message
+//    2026-10-18  agent          PollingSensors are polled from a deadline ordered min-heap - only the sensors that are due are woken
+//    2026-10-18  agent          Capture all GPIO inputs once per run() (st::GpioSnapshot) before updating the InterruptSensors
+//    2026-10-18  agent          Added autoPhase - initDevices() staggers the first poll of PollingSensors that have no offset
+//    2026-10-18  agent          Added refreshSnapshot - one refresh pass that skips recently sent devices and goes out as one batch
+//    2026-10-18  agent          Added optional st::Profiler hooks (ENABLE_PROFILER in Constants.h) and the "profile" command
+//    2026-10-18  agent          Added st::MemoryStats sampling on a timer, reportMemory and the "memory" command
+//    2026-10-18  agent          Added addRegistry() for compile time device lists (st::Registry<...>)
+//    2026-10-18  agent          Device counts are 16 bit (capacity is set in Constants.h / by build flags)
+//    2026-10-18  agent          Messages stay queued while the communication method is busy with a transmission (isReadyToSend())
+//    2026-10-18  agent          Messages are kept in st::MessageSpool while the link is down and replayed, oldest first, once it is back (ENABLE_MESSAGE_SPOOL)
+//    2026-10-18  agent          Messages are spooled while the hub is considered down, and the debug statistics include the hub health counters
+//    2026-10-18  agent          The debug output tells a message that is too long for a queue slot from one dropped because the queue is full
+//    2026-10-18  agent          Only messages queued as readings are coalesced - an event sent from getData() (e.g. a PS_Adafruit_MPR121 button press) is not
+//    2026-10-18  agent          autoPhase only plans PollingSensors created with PollingSensor::OFFSET_AUTO, so a sketch can pin a sensor to offset 0
+//    2026-10-18  agent          flushStrings() spools the queued messages instead of waiting while the link is down (ENABLE_MESSAGE_SPOOL)
+//    2026-10-18  agent          flushStrings() no longer waits for a link that is down, nor more than FLUSH_WAIT_TIMEOUT for the communication method
+//    2026-10-18  agent          transmitStrings() returns at once if the queue is empty
+//    2026-10-18  agent          Messages the communication method gives up on are taken back (popUndelivered()) and queued or spooled again
+//    2026-10-18  agent          The message-too-long debug output points at ST_MESSAGE_SLOT_SIZE
+//    2026-10-18  agent          transmitStrings() counts in 16 bits and batches at most BATCH_MAX_MESSAGES, instead of a stack array of MESSAGE_QUEUE_SIZE pointers
+//    2026-10-18  agent          The refreshSnapshot code is compiled only if ENABLE_REFRESH_SNAPSHOT is defined
 //
 //******************************************************************************************
 
 //#include <Arduino.h>
 //#include <avr/pgmspace.h>
 #include "Everything.h"
+#include "SmartThingsHubHealth.h"
 
 long freeRam();	//freeRam() function prototype - useful in determining how much SRAM is available on Arduino
 #if defined(ARDUINO_ARCH_SAMD)
@@ -40,20 +68,253 @@ extern "C" char* sbrk(int incr);
 #endif
 namespace st
 {
-	
 //private
+	void Everything::addToDeviceIndex(Device *device)
+	{
+		//insertion sort - only runs while devices are being added in setup()
+		int index = m_nSensorCount + m_nExecutorCount;
+		while (index > 0 && Device::compareNames(m_DeviceIndex[index - 1], device) > 0)
+		{
+			m_DeviceIndex[index] = m_DeviceIndex[index - 1];
+			--index;
+		}
+		m_DeviceIndex[index] = device;
+	}
+
+	bool Everything::registerSensor(Sensor *sensor)
+	{
+		if(m_nSensorCount>=Constants::MAX_SENSOR_COUNT)
+		{
+			if(debug)
+			{
+				Serial.print(F("Did not add sensor named "));
+				Serial.print(sensor->getName());
+				Serial.println(F("(You've exceeded maximum number of sensors; edit Constants.h)"));
+			}
+			return false;
+		}
+		else
+		{
+			addToDeviceIndex(sensor);
+			m_Sensors[m_nSensorCount]=sensor;
+			++m_nSensorCount;
+			#if defined(ENABLE_PROFILER)
+				Profiler::attach(sensor);
+			#endif
+		}
+		
+		if(debug)
+		{
+			Serial.print(F("Everything: adding sensor named "));
+			Serial.println(sensor->getName());
+			Serial.print(F("Everything: Free RAM = "));
+			Serial.println(freeRam());
+		}
+		return true;
+	}
+
+	bool Everything::pollsBefore(uint16_t a, uint16_t b)
+	{
+		//signed difference keeps the order correct across millis() rollover
+		return (int32_t)(uint32_t)(m_PollSchedule[a]->m_nNextPoll - m_PollSchedule[b]->m_nNextPoll) < 0;
+	}
+
+	void Everything::siftUp(uint16_t index)
+	{
+		while (index > 0)
+		{
+			uint16_t parent = (index - 1) / 2;
+			if (!pollsBefore(index, parent))
+			{
+				break;
+			}
+			PollingSensor *temp = m_PollSchedule[parent];
+			m_PollSchedule[parent] = m_PollSchedule[index];
+			m_PollSchedule[index] = temp;
+			index = parent;
+		}
+	}
+
+	void Everything::siftDown(uint16_t index)
+	{
+		while (true)
+		{
+			uint16_t first = index;
+			uint16_t left = 2 * index + 1;
+			uint16_t right = left + 1;
+			if (left < m_nPollCount && pollsBefore(left, first))
+			{
+				first = left;
+			}
+			if (right < m_nPollCount && pollsBefore(right, first))
+			{
+				first = right;
+			}
+			if (first == index)
+			{
+				break;
+			}
+			PollingSensor *temp = m_PollSchedule[first];
+			m_PollSchedule[first] = m_PollSchedule[index];
+			m_PollSchedule[index] = temp;
+			index = first;
+		}
+	}
+
+	//how close (in milliseconds) the periodic firing times of two sensors come: phases a and b repeat every
+	//intervalA and intervalB, so their differences are all the values (a - b) + k*gcd(intervalA, intervalB)
+	static unsigned long phaseDistance(unsigned long a, unsigned long intervalA, unsigned long b, unsigned long intervalB)
+	{
+		unsigned long g = intervalA;
+		unsigned long r = intervalB;
+		while (r != 0)
+		{
+			unsigned long t = g % r;
+			g = r;
+			r = t;
+		}
+		if (g == 0)
+		{
+			return 0xFFFFFFFF;
+		}
+		unsigned long d = (a >= b ? a - b : b - a) % g;
+		return min(d, g - d);
+	}
+
+	//Greedy phase planner - each unplanned sensor (shortest interval first) gets the offset whose firing times
+	//overlap least with the sensors already placed.  Two sensors overlap if they fire closer together than the
+	//longer of their measured getData() times plus one transmit interval (the time to send the reading).
+	//Among equally good offsets, the one furthest from its nearest neighbour wins, so the load is spread out.
+	void Everything::planPhases()
+	{
+		const byte MAX_CANDIDATES = 32;
+		unsigned long transmit = 0;
+		#ifndef DISABLE_SMARTTHINGS
+			transmit = SmartThing->getTransmitInterval();
+		#endif
+
+		while (true)
+		{
+			//next unplanned sensor with the shortest interval
+			uint16_t next = 0xFFFF;
+			for (uint16_t i = 0; i < m_nPollCount; ++i)
+			{
+				if (m_PollSchedule[i]->m_bAutoOffset && (next == 0xFFFF || m_PollSchedule[i]->m_nInterval < m_PollSchedule[next]->m_nInterval))
+				{
+					next = i;
+				}
+			}
+			if (next == 0xFFFF)
+			{
+				break;
+			}
+
+			PollingSensor *sensor = m_PollSchedule[next];
+			unsigned long interval = sensor->m_nInterval;
+			unsigned long step = max(interval / MAX_CANDIDATES, sensor->m_nReadingMicros / 1000 + transmit);
+			if (step == 0)
+			{
+				step = 1;
+			}
+
+			unsigned long bestPhase = 0;
+			unsigned long bestScore = 0xFFFFFFFF;
+			unsigned long bestNearest = 0;
+			for (unsigned long phase = 0; phase < interval; phase += step)
+			{
+				unsigned long score = 0;
+				unsigned long nearest = 0xFFFFFFFF;
+				for (uint16_t j = 0; j < m_nPollCount; ++j)
+				{
+					if (m_PollSchedule[j]->m_bAutoOffset || m_PollSchedule[j]->m_nInterval <= 0)	//only sensors whose offset is known
+					{
+						continue;
+					}
+					PollingSensor *other = m_PollSchedule[j];
+					unsigned long window = max(sensor->m_nReadingMicros, other->m_nReadingMicros) / 1000 + transmit;
+					unsigned long distance = phaseDistance(phase, interval, other->m_nOffset % other->m_nInterval, other->m_nInterval);
+					if (distance < window)
+					{
+						score += window - distance;
+					}
+					nearest = min(nearest, distance);
+				}
+				if (score < bestScore || (score == bestScore && nearest > bestNearest))
+				{
+					bestScore = score;
+					bestNearest = nearest;
+					bestPhase = phase;
+				}
+			}
+
+			sensor->m_nOffset = bestPhase;
+			sensor->m_bAutoOffset = false;
+		}
+
+		if (debug)
+		{
+			Serial.println(F("Everything: PollingSensor schedule (interval ms, offset ms, getData() us)"));
+			for (uint16_t i = 0; i < m_nPollCount; ++i)
+			{
+				Serial.print(F("Everything:   "));
+				Serial.print(m_PollSchedule[i]->getName());
+				Serial.print(F(" "));
+				Serial.print(m_PollSchedule[i]->m_nInterval);
+				Serial.print(F(" "));
+				Serial.print(m_PollSchedule[i]->m_nOffset);
+				Serial.print(F(" "));
+				Serial.println(m_PollSchedule[i]->m_nReadingMicros);
+			}
+		}
+	}
+
+	void Everything::pollDueSensors()
+	{
+		if (!m_bSchedulerStarted)
+		{
+			return;
+		}
+
+		//poll() always moves the deadline past now, so each sensor is polled at most once per pass
+		unsigned long now = millis();
+		while (m_nPollCount > 0 && m_PollSchedule[0]->isDue(now))
+		{
+			m_PollSchedule[0]->poll(now);
+			siftDown(0);
+		}
+	}
+
 	void Everything::updateDevices()
 	{
-		for(unsigned int index=0; index<m_nSensorCount; ++index)
+		pollDueSensors();
+
+		GpioSnapshot::capture();	//one consistent read of every input port for all of the InterruptSensors below
+
+		for(unsigned int index=0; index<m_nLoopSensorCount; ++index)
 		{
-			m_Sensors[index]->update();
-			sendStrings();
+			#if defined(ENABLE_PROFILER)
+				unsigned long start = micros();
+				m_LoopSensors[index]->update();
+				Profiler::record(m_LoopSensors[index], Profiler::UPDATE, micros() - start);
+			#else
+				m_LoopSensors[index]->update();
+			#endif
+		}
+
+		if (m_pRegistry != 0)
+		{
+			m_pRegistry->update();	//one virtual call - the registry calls each of its devices directly
 		}
 
 		for (unsigned int i = 0; i<m_nExecutorCount; ++i)
 		{
-			m_Executors[i]->update();
-			sendStrings();
+			#if defined(ENABLE_PROFILER)
+				unsigned long start = micros();
+				m_Executors[i]->update();
+				Profiler::record(m_Executors[i], Profiler::UPDATE, micros() - start);
+			#else
+				m_Executors[i]->update();
+			#endif
 		}
 	}
 	
@@ -74,48 +335,365 @@ namespace st
 	}
 #endif
 	
-	void Everything::sendStrings()
+	//sends the oldest message in the queue to ST Shield and removes it from the queue
+	//if the SmartThings object has batching enabled, the queued messages (up to BATCH_MAX_MESSAGES of them) are sent in one transmission instead
+	void Everything::transmitStrings()
 	{
-		unsigned int index;
-		//Loop through the Return_String buffer and send each "|" delimited string to ST Shield
-		while(Return_String.length()>=1 && Return_String[0]!='|')
+		if (m_MessageQueue.isEmpty())
 		{
-			index=Return_String.indexOf("|");
-			if(debug)
+			return;		//nothing to send (e.g. the queue was sent by a callout the communication method ran meanwhile)
+		}
+
+		#if defined(ENABLE_MESSAGE_SPOOL)
+			if (!m_MessageSpool.isEmpty() || !SmartThing->isLinkUp())
 			{
-				Serial.print(F("Everything: Sending: "));
-				Serial.println(Return_String.substring(0, index));
-				//Serial.print(F("Everything: getTransmitInterval() = "));
-				//Serial.println(SmartThing->getTransmitInterval());
+				spoolStrings();		//the link is down (send() would lose them), or older messages are still spooled (they go first)
+				return;
 			}
-			#ifndef DISABLE_SMARTTHINGS
-//			if (millis() - sendstringsLastMillis < Constants::SENDSTRINGS_INTERVAL)
-			if (millis() - sendstringsLastMillis < SmartThing->getTransmitInterval())
+		#endif
+
+		uint16_t count = 1;
+		#ifndef DISABLE_SMARTTHINGS
+			bool batching = SmartThing->isBatchingEnabled();
+			#if defined(ENABLE_REFRESH_SNAPSHOT)
+				bool snapshot = m_bSnapshotPending && !batching && SmartThing->supportsBatching();	//a refresh snapshot is sent in batches even if batching is not enabled
+			#else
+				const bool snapshot = false;
+			#endif
+			if (batching || snapshot)
+			{
+				count = m_MessageQueue.count();
+				if (count > Constants::BATCH_MAX_MESSAGES)
 				{
-//					delay(Constants::SENDSTRINGS_INTERVAL - (millis() - sendstringsLastMillis)); //Added due to slow ST Hub/Cloud Processing.  Events were being missed.  DGO 2015-03-28
-					delay(SmartThing->getTransmitInterval() - (millis() - sendstringsLastMillis)); //modified to allow different values for each method of communicating to ST cloud.  DGO 2017-04-26
+					count = Constants::BATCH_MAX_MESSAGES;
+				}
 			}
-				SmartThing->send(Return_String.substring(0, index));
-				sendstringsLastMillis = millis();
+		#endif
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			m_bSnapshotPending = false;
+		#endif
+
+		const char* messages[Constants::BATCH_MAX_MESSAGES];
+		for (uint16_t i = 0; i < count; i++)
+		{
+			messages[i] = m_MessageQueue.peek(i);
+			if(debug)
+			{
+				Serial.print(F("Everything: Sending: "));
+				Serial.println(messages[i]);
+			}
+		}
+
+		#ifndef DISABLE_SMARTTHINGS
+			if (snapshot) SmartThing->enableBatching(true);
+			#if defined(ENABLE_PROFILER)
+				unsigned long start = micros();
+				SmartThing->sendBatch(messages, count);
+				Profiler::recordSend(micros() - start);
+			#else
+				SmartThing->sendBatch(messages, count);
 			#endif
+			if (snapshot) SmartThing->enableBatching(false);
+			sendstringsLastMillis = millis();
+		#endif
+
+		for (uint16_t i = 0; i < count; i++)
+		{
 			#if defined(ENABLE_SERIAL) && defined(DISABLE_SMARTTHINGS)
-				Serial.println(Return_String.substring(0, index));
+				Serial.println(messages[i]);
 			#endif
-			
+
 			if(callOnMsgSend!=0)
 			{
-				callOnMsgSend(Return_String.substring(0, index));
+				callOnMsgSend(messages[i]);
+			}
+
+			#if defined(ENABLE_REFRESH_SNAPSHOT)
+				if (refreshSnapshot)
+				{
+					markSent(messages[i]);
+				}
+			#endif
+		}
+
+		for (uint16_t i = 0; i < count; i++)
+		{
+			m_MessageQueue.pop();
+		}
+
+		#if defined(ENABLE_REFRESH_SNAPSHOT) && !defined(DISABLE_SMARTTHINGS)
+			if (snapshot && !m_MessageQueue.isEmpty())
+			{
+				m_bSnapshotPending = true;		//the rest of the snapshot goes in the next batch
+			}
+		#endif
+	}
+
+#if defined(ENABLE_MESSAGE_SPOOL)
+	void Everything::spoolStrings()
+	{
+		while (!m_MessageQueue.isEmpty())
+		{
+			const char *message = m_MessageQueue.peek();
+			if (m_MessageSpool.push(message, strlen(message), m_MessageQueue.getQueuedMillis(0)))
+			{
+				if (debug)
+				{
+					Serial.print(F("Everything: Spooled: "));
+					Serial.println(message);
+				}
+			}
+			else if (debug)
+			{
+				Serial.print(F("Everything: ERROR: \""));
+				Serial.print(message);
+				Serial.println(F("\" dropped - the message spool could not be written"));
+			}
+			m_MessageQueue.pop();
+		}
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			m_bSnapshotPending = false;
+		#endif
+	}
+
+	//Spooled messages are sent one at a time with " @<milliseconds since it was queued>" appended (" @?" if it was
+	//queued before the last restart) - hub drivers that only look at the first two words of a message ignore it
+	void Everything::replaySpool()
+	{
+		if ((millis() - m_nReplayLastMillis < Constants::SPOOL_REPLAY_INTERVAL) || (millis() - sendstringsLastMillis < (unsigned long)SmartThing->getTransmitInterval()))
+		{
+			return;
+		}
+		if (!SmartThing->isLinkUp())
+		{
+			m_nReplayLastMillis = millis();		//look again after another SPOOL_REPLAY_INTERVAL
+			return;
+		}
+		MessageSpool::Record record;
+		if (!SmartThing->isReadyToSend() || !m_MessageSpool.peek(record))
+		{
+			return;
+		}
+
+		char message[Constants::MESSAGE_SLOT_SIZE + 13];	//" @" and up to 10 digits
+		if (record.thisBoot)
+		{
+			snprintf(message, sizeof(message), "%s @%lu", record.message, (unsigned long)(uint32_t)(millis() - record.capturedMillis));
+		}
+		else
+		{
+			snprintf(message, sizeof(message), "%s @?", record.message);
+		}
+		if (debug)
+		{
+			Serial.print(F("Everything: Replaying: "));
+			Serial.println(message);
+		}
+
+		const char* messages[] = { message };
+		SmartThing->sendBatch(messages, 1);
+		sendstringsLastMillis = millis();
+		m_nReplayLastMillis = sendstringsLastMillis;
+
+		if (callOnMsgSend != 0)
+		{
+			callOnMsgSend(record.message);
+		}
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			if (refreshSnapshot)
+			{
+				markSent(record.message);
+			}
+		#endif
+		m_MessageSpool.pop();
+	}
+#endif
+
+	//messages the communication method has given up on (e.g. its retries ran out while the hub was down) - they
+	//are older than anything still queued, so they go back to the front of the queue, or into the spool if that
+	//is where transmitStrings() would put them
+#ifndef DISABLE_SMARTTHINGS
+	void Everything::takeBackUndelivered()
+	{
+		String message;
+		uint16_t pos = 0;
+		while (SmartThing->popUndelivered(message))
+		{
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				if (!m_MessageSpool.isEmpty() || !SmartThing->isLinkUp())
+				{
+					if (!m_MessageSpool.push(message.c_str(), message.length(), millis()) && debug)
+					{
+						Serial.print(F("Everything: ERROR: \""));
+						Serial.print(message);
+						Serial.println(F("\" dropped - the message spool could not be written"));
+					}
+					continue;
+				}
+			#endif
+			if (m_MessageQueue.insert(pos, message.c_str(), message.length()))
+			{
+				pos++;
+			}
+			else if (debug)
+			{
+				Serial.print(F("Everything: ERROR: \""));
+				Serial.print(message);
+				Serial.println(F("\" not delivered, and there is no room to queue it again"));
+			}
+		}
+	}
+#endif
+
+	//Non-blocking - releases the next queued message only once the transmit interval of the communication method has elapsed and it has finished its previous transmission, otherwise returns immediately
+	void Everything::sendStrings()
+	{
+		#ifndef DISABLE_SMARTTHINGS
+			takeBackUndelivered();
+		#endif
+		#if defined(ENABLE_MESSAGE_SPOOL)
+			if (!m_MessageSpool.isEmpty())
+			{
+				replaySpool();		//spooled messages are older than anything in the queue
+			}
+			if (!m_MessageQueue.isEmpty() && !SmartThing->isReadyToSend() && !SmartThing->isLinkUp())
+			{
+				spoolStrings();		//the hub is considered down (circuit breaker open) - it may be a while before anything can be sent
+			}
+		#endif
+		#ifndef DISABLE_SMARTTHINGS
+			if (!m_MessageQueue.isEmpty() && (millis() - sendstringsLastMillis >= (unsigned long)SmartThing->getTransmitInterval()) && SmartThing->isReadyToSend())  //each communication method specifies its own throttling interval (ThingShield ~1000ms, Ethernet ~100ms)
+			{
+				transmitStrings();
+			}
+		#else
+			while (!m_MessageQueue.isEmpty())
+			{
+				transmitStrings();
 			}
+		#endif
+	}
 
-			Return_String=Return_String.substring(index+1);
+	//Blocking - sends every queued message right now, waiting out the transmit interval between messages - only used during setup and for sendSmartStringNow()
+	//Never waits for a link that is down (or a hub whose circuit breaker is open), nor longer than FLUSH_WAIT_TIMEOUT for the communication method to become ready:
+	//the messages are spooled (ENABLE_MESSAGE_SPOOL), or stay queued for run() to send
+	void Everything::flushStrings()
+	{
+		while (!m_MessageQueue.isEmpty())
+		{
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				if (!m_MessageSpool.isEmpty() || !SmartThing->isLinkUp())
+				{
+					spoolStrings();		//what transmitStrings() would do - decided before waiting for the link
+					return;
+				}
+			#endif
+			#ifndef DISABLE_SMARTTHINGS
+				if (millis() - sendstringsLastMillis < (unsigned long)SmartThing->getTransmitInterval())
+				{
+					delay(SmartThing->getTransmitInterval() - (millis() - sendstringsLastMillis)); //Added due to slow ST Hub/Cloud Processing.  Events were being missed.  DGO 2015-03-28
+				}
+				unsigned long waitStart = millis();
+				while (!SmartThing->isReadyToSend())
+				{
+					if (!SmartThing->isLinkUp())
+					{
+						#if defined(ENABLE_MESSAGE_SPOOL)
+							break;		//transmitStrings() spools them
+						#else
+							return;		//left queued - sendStrings() sends them once the link is back
+						#endif
+					}
+					if (millis() - waitStart >= Constants::FLUSH_WAIT_TIMEOUT)
+					{
+						return;		//left queued
+					}
+					yield();
+				}
+				takeBackUndelivered();		//given up on while waiting - they go before the rest of the queue
+			#endif
+			transmitStrings();
 		}
-		Return_String.remove(0);	//clear the Return_String buffer
 	}
 	
+#if defined(ENABLE_REFRESH_SNAPSHOT)
+	void Everything::markSent(const char *message)
+	{
+		unsigned int nameLength = 0;
+		while (message[nameLength] != '\0' && message[nameLength] != ' ')
+		{
+			nameLength++;
+		}
+		Device *device = getDeviceByName(message, nameLength);
+		if (device != 0)
+		{
+			device->m_nLastSent = millis() | 1;	//never 0, which means "not sent yet"
+		}
+	}
+
+	void Everything::refreshSnapshotPass()
+	{
+		const byte HEADROOM = Constants::MESSAGE_QUEUE_SIZE < 8 ? (Constants::MESSAGE_QUEUE_SIZE + 1) / 2 : 4;	//free slots needed before refreshing another Device (some queue several messages)
+		const uint16_t total = m_nExecutorCount + m_nSensorCount + (m_pRegistry != 0 ? m_pRegistry->count() : 0);
+
+		while (m_nRefreshCursor < total && m_MessageQueue.capacity() - m_MessageQueue.count() >= HEADROOM)
+		{
+			Device *device;
+			if (m_nRefreshCursor < m_nExecutorCount)
+			{
+				device = m_Executors[m_nRefreshCursor];
+			}
+			else if (m_nRefreshCursor < m_nExecutorCount + m_nSensorCount)
+			{
+				device = m_Sensors[m_nRefreshCursor - m_nExecutorCount];
+			}
+			else
+			{
+				device = m_pRegistry->getDevice(m_nRefreshCursor - m_nExecutorCount - m_nSensorCount);
+			}
+			m_nRefreshCursor++;
+
+			//the hub already has a value from this Device that is newer than one refresh interval
+			if (m_bRefreshSkipRecent && device->m_nLastSent != 0 && millis() - device->m_nLastSent < long(Constants::DEV_REFRESH_INTERVAL) * 1000)
+			{
+				continue;
+			}
+			device->refresh();
+		}
+
+		m_bSnapshotPending = !m_MessageQueue.isEmpty();
+
+		if (m_nRefreshCursor >= total)
+		{
+			m_nRefreshCursor = 0;
+			m_bRefreshSkipRecent = true;
+			refLastMillis = millis();
+		}
+		else
+		{
+			//queue is full - carry on once it has been sent
+			#ifndef DISABLE_SMARTTHINGS
+				refLastMillis = millis() - long(Constants::DEV_REFRESH_INTERVAL) * 1000 + 2 * SmartThing->getTransmitInterval();
+			#else
+				refLastMillis = millis() - long(Constants::DEV_REFRESH_INTERVAL) * 1000;
+			#endif
+		}
+	}
+#endif
+
 	void Everything::refreshDevices()
 	{
+		#if defined(ENABLE_REFRESH_SNAPSHOT)
+			if (refreshSnapshot)
+			{
+				refreshSnapshotPass();
+				return;
+			}
+		#endif
+
 		static int refresh_Executor = 0;
 		static int refresh_Sensor = 0;
+		static unsigned int refresh_Registry = 0;
 		/*
 		for(unsigned int i=0; i<m_nExecutorCount; ++i)
 		{
@@ -141,29 +719,64 @@ namespace st
 			refresh_Sensor++;
 			refLastMillis = millis() - long(Constants::DEV_REFRESH_INTERVAL) * 1000 + 4 * SmartThing->getTransmitInterval();
 		}
+		else if (m_pRegistry != 0 && refresh_Registry < m_pRegistry->count()) {
+			m_pRegistry->getDevice(refresh_Registry)->refresh();
+			sendStrings();
+			refresh_Registry++;
+			refLastMillis = millis() - long(Constants::DEV_REFRESH_INTERVAL) * 1000 + 4 * SmartThing->getTransmitInterval();
+		}
 		else {
 			refLastMillis = millis();
 			refresh_Executor = 0;
 			refresh_Sensor = 0;
+			refresh_Registry = 0;
 		}
 	}
 
 //public
 	void Everything::init()
 	{
+		MemoryStats::init();	//paint the unused stack before anything else uses it
 		Serial.begin(Constants::SERIAL_BAUDRATE);
-		Return_String.reserve(st::Constants::RETURN_STRING_RESERVE);	//allocate Return_String buffer one time to prevent Heap Fragmentation.  RETURN_STRING_RESERVE is set in Constants.h
 		
 		if(debug)
 		{
 			Serial.println(F("Everything: init started"));
 			Serial.print(F("Everything: Free RAM = "));
 			Serial.println(freeRam());
+			Serial.print(F("Everything: device tables = "));
+			Serial.print(Constants::DEVICE_TABLE_RAM);
+			Serial.print(F(" bytes ("));
+			Serial.print(Constants::MAX_SENSOR_COUNT);
+			Serial.print(F(" sensors, "));
+			Serial.print(Constants::MAX_EXECUTOR_COUNT);
+			Serial.print(F(" executors), message queue = "));
+			Serial.print(Constants::MESSAGE_QUEUE_RAM);
+			Serial.println(F(" bytes"));
 		}
 		
 		#ifndef DISABLE_SMARTTHINGS
 			SmartThing->init();
 		#endif
+
+		#if defined(ENABLE_MESSAGE_SPOOL)
+			bool spoolReady = m_MessageSpool.begin();		//finds the messages spooled before the restart - replayed by run() once the link is up
+			if (debug)
+			{
+				if (spoolReady)
+				{
+					Serial.print(F("Everything: Message Spool holds "));
+					Serial.print(m_MessageSpool.count());
+					Serial.print(F(" messages from before the restart (room for "));
+					Serial.print(m_MessageSpool.capacity());
+					Serial.println(F(")"));
+				}
+				else
+				{
+					Serial.println(F("Everything: ERROR: Message Spool storage is not available - messages will be lost while the link is down"));
+				}
+			}
+		#endif
 		
 		
 		if(debug)
@@ -183,17 +796,42 @@ namespace st
 			Serial.println(freeRam());
 		}
 		
+		GpioSnapshot::capture();
+
 		for(unsigned int index=0; index<m_nSensorCount; ++index)
 		{
 			m_Sensors[index]->init();
-			sendStrings();
+			flushStrings();
 		}
 		
 		for(unsigned int index=0; index<m_nExecutorCount; ++index)
 		{
 			m_Executors[index]->init();
-			sendStrings();
+			flushStrings();
 		}
+
+		if (m_pRegistry != 0)
+		{
+			m_pRegistry->init();	//flushes after each device, like the loops above
+		}
+
+		if (autoPhase)
+		{
+			planPhases();
+		}
+
+		//start the poll scheduler - first deadlines are interval + offset from now, just like the first update() used to be
+		unsigned long now = millis();
+		for (uint16_t index = 0; index < m_nPollCount; ++index)
+		{
+			m_PollSchedule[index]->schedule(now);
+			m_PollSchedule[index]->m_bScheduled = true;
+		}
+		for (uint16_t index = m_nPollCount / 2; index > 0; --index)
+		{
+			siftDown(index - 1);
+		}
+		m_bSchedulerStarted = true;
 		
 		if(debug)
 		{
@@ -207,6 +845,10 @@ namespace st
 	
 	void Everything::run()
 	{
+		#if defined(ENABLE_PROFILER)
+			unsigned long runStart = micros();
+		#endif
+
 		updateDevices();			//call each st::Sensor object to refresh data
 
 		#ifndef DISABLE_SMARTTHINGS
@@ -217,7 +859,7 @@ namespace st
 			readSerial();			//read data from the Arduino IDE Serial Monitor window (useful for debugging sometimes)
 		#endif
 		
-		sendStrings();				//send any pending updates to ST Cloud
+		sendStrings();				//send the next pending update to ST Cloud, if the transmit interval has elapsed (never blocks)
 		
 		#ifndef DISABLE_REFRESH		//Added new check to allow user to disable REFRESH feature - setting is in Constants.h)
 		if ((bTimersPending == 0) && ((millis() - refLastMillis) >= long(Constants::DEV_REFRESH_INTERVAL) * 1000))  //DEV_REFRESH_INTERVAL is set in Constants.h
@@ -227,61 +869,149 @@ namespace st
 		}
 		#endif
 		
-		if((debug) && (millis()%60000==0) && (millis()!=lastmillis))
+		if (millis() - m_nMemorySampleMillis >= long(Constants::MEMORY_SAMPLE_INTERVAL) * 1000)
+		{
+			m_nMemorySampleMillis = millis();
+			MemoryStats::sample();
+		}
+
+		if (reportMemory && (millis() - m_nMemoryReportMillis >= long(Constants::MEMORY_REPORT_INTERVAL) * 1000))
+		{
+			m_nMemoryReportMillis = millis();
+			MemoryStats::send();
+		}
+
+		if((debug) && (millis() - lastmillis >= 60000))
 		{
 			lastmillis = millis();
-			Serial.print(F("Everything: Free Ram = "));  
-			Serial.println(freeRam());
+			MemoryStats::print();
+			Serial.print(F("Everything: Message Queue high water mark = "));
+			Serial.print(m_MessageQueue.getHighWaterMark());
+			Serial.print(F("/"));
+			Serial.print(m_MessageQueue.capacity());
+			Serial.print(F(", dropped = "));
+			Serial.print(m_MessageQueue.getDropCount());
+			Serial.print(F(", coalesced = "));
+			Serial.println(m_MessageQueue.getCoalescedCount());
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				Serial.print(F("Everything: Message Spool = "));
+				Serial.print(m_MessageSpool.count());
+				Serial.print(F("/"));
+				Serial.print(m_MessageSpool.capacity());
+				Serial.print(F(", spooled = "));
+				Serial.print(m_MessageSpool.getSpooledCount());
+				Serial.print(F(", replayed = "));
+				Serial.print(m_MessageSpool.getReplayedCount());
+				Serial.print(F(", dropped = "));
+				Serial.println(m_MessageSpool.getDropCount());
+			#endif
+			#ifndef DISABLE_SMARTTHINGS
+				const HubHealth *health = SmartThing->getHubHealth();
+				if (health != 0)
+				{
+					Serial.print(F("Everything: Hub Health = "));
+					Serial.print(health->getState() == HubHealth::Closed ? F("closed") : health->getState() == HubHealth::Open ? F("open") : F("half-open"));
+					Serial.print(F(", answered = "));
+					Serial.print(health->getSuccessCount());
+					Serial.print(F(", failed = "));
+					Serial.print(health->getFailureCount());
+					Serial.print(F(", trips = "));
+					Serial.print(health->getTripCount());
+					Serial.print(F(", probes = "));
+					Serial.print(health->getProbeCount());
+					Serial.print(F(", rejected = "));
+					Serial.print(health->getRejectedCount());
+					Serial.print(F(", backoff = "));
+					Serial.println(health->getBackoff());
+				}
+			#endif
 		}
+
+		#if defined(ENABLE_PROFILER)
+			Profiler::recordLoop(micros() - runStart);
+			Profiler::run();		//periodic summary to the hub and Serial
+		#endif
 	}
 	
 	bool Everything::sendSmartString(const String &str)
 	{
-		//while(str.length()>1 && str[0]=='|') //get rid of leading pipes (messes up sendStrings()'s parsing technique)
-		//{
-		//	str=str.substring(1);
-		//}
-		if((str.length()==1 && str[0]=='|') || str.length()==0)
+		return sendSmartString(str.c_str(), str.length());
+	}
+
+	bool Everything::sendSmartString(const char *str, unsigned int len, bool reading)
+	{
+		if(len==0)
 		{
 			return false;
 		}
 		
-		if(Return_String.length()+str.length()>=Constants::RETURN_STRING_RESERVE)
+		if(!m_MessageQueue.push(str, len, coalesceReadings && reading))	//add the new message to the queue to be sent to ST Shield (readings may replace an older unsent reading)
 		{
 			if (debug)
 			{
 				Serial.print(F("Everything: ERROR: \""));
 				Serial.print(str);
-				Serial.println(F("\" would overflow the Return_String 'buffer'"));
+				if (len >= Constants::MESSAGE_SLOT_SIZE)
+				{
+					Serial.print(F("...\" dropped - message longer than "));	//str is cut off at the slot size by st::Message
+					Serial.print(Constants::MESSAGE_SLOT_SIZE - 1);
+					Serial.print(F(" chars - raise ST_MESSAGE_SLOT_SIZE (see Constants.h) ("));
+				}
+				else
+				{
+					Serial.print(F("\" dropped - message queue full ("));
+				}
+				Serial.print(m_MessageQueue.getDropCount());
+				Serial.println(F(" dropped so far)"));
 			}
 			return false;
 		}
-		else
-		{
-			Return_String+=str+"|";		//add the new message to the queue to be sent to ST Shield with a "|" delimiter
-			return true;
-		}
+		return true;
 	}
 
 	bool Everything::sendSmartStringNow(const String &str)
 	{
-		bool queued = sendSmartString(str);
-		if (queued) sendStrings(); //send any pending updates to ST Cloud immediately
+		return sendSmartStringNow(str.c_str(), str.length());
+	}
+
+	bool Everything::sendSmartStringNow(const char *str, unsigned int len)
+	{
+		bool queued = sendSmartString(str, len);
+		if (queued) flushStrings(); //send any pending updates to ST Cloud immediately
 		return queued;
 	}
 
 	Device* Everything::getDeviceByName(const String &str)
 	{
-		for(unsigned int index=0; index<m_nSensorCount; ++index)
+		return getDeviceByName(str.c_str(), str.length());
+	}
+
+	Device* Everything::getDeviceByName(const char *name, unsigned int len)
+	{
+		//binary search of the sorted device index - finds the first device with a matching name
+		int low = 0;
+		int high = m_nSensorCount + m_nExecutorCount;
+		while (low < high)
+		{
+			int mid = (low + high) / 2;
+			if (m_DeviceIndex[mid]->compareName(name, len) > 0)
+			{
+				low = mid + 1;
+			}
+			else
+			{
+				high = mid;
+			}
+		}
+
+		if (low < m_nSensorCount + m_nExecutorCount && m_DeviceIndex[low]->compareName(name, len) == 0)
 		{
-			if(m_Sensors[index]->getName()==str)
-				return (Device*)m_Sensors[index];
+			return m_DeviceIndex[low];
 		}
-		
-		for(unsigned int index=0; index<m_nExecutorCount; ++index)
+
+		if (m_pRegistry != 0)
 		{
-			if(m_Executors[index]->getName()==str)
-				return (Device*)m_Executors[index];
+			return m_pRegistry->getDeviceByName(name, len);
 		}
 		
 		return 0; //null if no such device present
@@ -289,31 +1019,115 @@ namespace st
 	
 	bool Everything::addSensor(Sensor *sensor)
 	{
-		if(m_nSensorCount>=Constants::MAX_SENSOR_COUNT)
+		if (!registerSensor(sensor))
 		{
-			if(debug)
-			{
-				Serial.print(F("Did not add sensor named "));
-				Serial.print(sensor->getName());
-				Serial.println(F("(You've exceeded maximum number of sensors; edit Constants.h)"));
-			}
 			return false;
 		}
-		else
+		m_LoopSensors[m_nLoopSensorCount++] = sensor;
+		return true;
+	}
+
+	bool Everything::addSensor(PollingSensor *sensor)
+	{
+		if (!registerSensor(sensor))
 		{
-			m_Sensors[m_nSensorCount]=sensor;
-			++m_nSensorCount;
+			return false;
 		}
-		
-		if(debug)
+
+		if (sensor->getUpdateEveryLoop())
 		{
-			Serial.print(F("Everything: adding sensor named "));
-			Serial.println(sensor->getName());
-			Serial.print(F("Everything: Free RAM = "));
-			Serial.println(freeRam());
+			m_LoopSensors[m_nLoopSensorCount++] = sensor;
+		}
+
+		m_PollSchedule[m_nPollCount] = sensor;
+		if (m_bSchedulerStarted)	//added after initDevices() - start timing it now
+		{
+			sensor->schedule(millis());
+			sensor->m_bScheduled = true;
+			siftUp(m_nPollCount++);
+		}
+		else
+		{
+			m_nPollCount++;	//the heap is built once all deadlines are set in initDevices()
 		}
 		return true;
 	}
+
+	void Everything::reschedule(PollingSensor *sensor)
+	{
+		if (!sensor->m_bScheduled)
+		{
+			return;
+		}
+
+		for (uint16_t index = 0; index < m_nPollCount; ++index)
+		{
+			if (m_PollSchedule[index] == sensor)
+			{
+				siftUp(index);
+				siftDown(index);
+				return;
+			}
+		}
+	}
+
+	unsigned long Everything::getTimeUntilNextPoll()
+	{
+		if (!m_bSchedulerStarted || m_nPollCount == 0)
+		{
+			return 0xFFFFFFFF;
+		}
+
+		unsigned long now = millis();
+		if (m_PollSchedule[0]->isDue(now))
+		{
+			return 0;
+		}
+		return (uint32_t)(m_PollSchedule[0]->m_nNextPoll - now);
+	}
+
+	unsigned long Everything::getTimeUntilNextWork()
+	{
+		unsigned long wait = getTimeUntilNextPoll();
+		unsigned long elapsed;
+
+		#ifndef DISABLE_SMARTTHINGS
+			if (!m_MessageQueue.isEmpty())
+			{
+				elapsed = millis() - sendstringsLastMillis;
+				unsigned long interval = SmartThing->getTransmitInterval();
+				wait = min(wait, elapsed >= interval ? 0 : interval - elapsed);
+			}
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				if (!m_MessageSpool.isEmpty())
+				{
+					elapsed = millis() - m_nReplayLastMillis;
+					unsigned long interval = Constants::SPOOL_REPLAY_INTERVAL;
+					wait = min(wait, elapsed >= interval ? 0 : interval - elapsed);
+				}
+			#endif
+			if (!SmartThing->isReadyToSend() && wait > 1)
+			{
+				wait = 1;	//a transmission is in progress - it only advances while run() is called
+			}
+		#else
+			if (!m_MessageQueue.isEmpty())
+			{
+				wait = 0;
+			}
+		#endif
+
+		#ifndef DISABLE_REFRESH
+			if (bTimersPending == 0)
+			{
+				elapsed = millis() - refLastMillis;
+				unsigned long interval = long(Constants::DEV_REFRESH_INTERVAL) * 1000;
+				wait = min(wait, elapsed >= interval ? 0 : interval - elapsed);
+			}
+		#endif
+
+		return wait;
+	}
 	
 	bool Everything::addExecutor(Executor *executor)
 	{
@@ -329,8 +1143,12 @@ namespace st
 		}
 		else
 		{
+			addToDeviceIndex(executor);
 			m_Executors[m_nExecutorCount]=executor;
 			++m_nExecutorCount;
+			#if defined(ENABLE_PROFILER)
+				Profiler::attach(executor);
+			#endif
 		}
 		
 		if(debug)
@@ -343,6 +1161,38 @@ namespace st
 		return true;
 	}
 	
+	bool Everything::addRegistry(RegistryBase *registry)
+	{
+		if (m_pRegistry != 0)
+		{
+			if(debug)
+			{
+				Serial.println(F("Everything: ERROR: only one Registry can be added"));
+			}
+			return false;
+		}
+		m_pRegistry = registry;
+
+		for (unsigned int i = 0; i < registry->count(); ++i)
+		{
+			#if defined(ENABLE_PROFILER)
+				Profiler::attach(registry->getDevice(i));
+			#endif
+			if(debug)
+			{
+				Serial.print(F("Everything: adding registry device named "));
+				Serial.println(registry->getDevice(i)->getName());
+			}
+		}
+
+		if(debug)
+		{
+			Serial.print(F("Everything: Free RAM = "));
+			Serial.println(freeRam());
+		}
+		return true;
+	}
+	
 	//friends!
 	void receiveSmartString(String message)
 	{
@@ -360,14 +1210,49 @@ namespace st
 
 		if (message == "refresh")
 		{
-			Everything::refreshDevices();
+			#if defined(ENABLE_REFRESH_SNAPSHOT)
+				if (Everything::refreshSnapshot)
+				{
+					Everything::m_nRefreshCursor = 0;
+					Everything::m_bRefreshSkipRecent = false;	//the hub asked for everything - do not skip recently sent Devices
+					Everything::refreshSnapshotPass();
+				}
+				else
+			#endif
+			{
+				Everything::refreshDevices();
+			}
 		}
+		else if (message == "memory")
+		{
+			MemoryStats::sample();
+			MemoryStats::print();
+			MemoryStats::send();
+		}
+		#if defined(ENABLE_PROFILER)
+		else if (message == "profile")
+		{
+			Profiler::printReport();
+			Profiler::sendSummary();
+		}
+		else if (message == "profile reset")
+		{
+			Profiler::reset();
+		}
+		#endif
 		else if (message.length() > 1)		//ignore empty string messages from the ST Hub
 		{
-			Device *p = Everything::getDeviceByName(message.substring(0, message.indexOf(' ')));
+			int nameLength = message.indexOf(' ');
+			Device *p = Everything::getDeviceByName(message.c_str(), nameLength < 0 ? message.length() : nameLength);
 			if (p != 0)
 			{
-				p->beSmart(message);	//pass the incoming SmartThings Shield message to the correct Device's beSmart() routine
+				#if defined(ENABLE_PROFILER)
+					unsigned long start = micros();
+					p->beSmart(message);	//pass the incoming SmartThings Shield message to the correct Device's beSmart() routine
+					Profiler::record(p, Profiler::BESMART, micros() - start);
+				#else
+					p->beSmart(message);	//pass the incoming SmartThings Shield message to the correct Device's beSmart() routine
+				#endif
 			}
 		}
 		
@@ -380,15 +1265,37 @@ namespace st
 	
 	//initialize static members
 	st::SmartThings* Everything::SmartThing=0; //initialize pointer to null
-	String Everything::Return_String;
+	MessageQueue Everything::m_MessageQueue;
 	Sensor* Everything::m_Sensors[Constants::MAX_SENSOR_COUNT];
 	Executor* Everything::m_Executors[Constants::MAX_EXECUTOR_COUNT];
-	byte Everything::m_nSensorCount=0;
-	byte Everything::m_nExecutorCount=0;
+	Device* Everything::m_DeviceIndex[Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT];
+	uint16_t Everything::m_nSensorCount=0;
+	uint16_t Everything::m_nExecutorCount=0;
+	Sensor* Everything::m_LoopSensors[Constants::MAX_SENSOR_COUNT];
+	uint16_t Everything::m_nLoopSensorCount=0;
+	PollingSensor* Everything::m_PollSchedule[Constants::MAX_SENSOR_COUNT];
+	uint16_t Everything::m_nPollCount=0;
+	bool Everything::m_bSchedulerStarted=false;
+	RegistryBase* Everything::m_pRegistry=0;
 	unsigned long Everything::lastmillis=0;
+	unsigned long Everything::m_nMemorySampleMillis=0;
+	unsigned long Everything::m_nMemoryReportMillis=0;
 	unsigned long Everything::refLastMillis=0;
 	unsigned long Everything::sendstringsLastMillis=0;
 	bool Everything::debug=false;
+	bool Everything::coalesceReadings=false;
+	bool Everything::reportMemory=false;
+	bool Everything::autoPhase=false;
+	#if defined(ENABLE_REFRESH_SNAPSHOT)
+		bool Everything::refreshSnapshot=false;
+		uint16_t Everything::m_nRefreshCursor=0;
+		bool Everything::m_bRefreshSkipRecent=true;
+		bool Everything::m_bSnapshotPending=false;
+	#endif
+	#if defined(ENABLE_MESSAGE_SPOOL)
+		MessageSpool Everything::m_MessageSpool;
+		unsigned long Everything::m_nReplayLastMillis=0;
+	#endif
 	byte Everything::bTimersPending=0;	//initialize variable
 	void (*Everything::callOnMsgSend)(const String &msg)=0; //initialize this callback function to null
 	void (*Everything::callOnMsgRcvd)(const String &msg)=0; //initialize this callback function to null
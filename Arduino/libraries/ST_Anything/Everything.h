@@ -26,6 +26,26 @@
 //    2019-02-09  Dan Ogorchock  Add update() call to Executors in support of devices like EX_Servo that need a non-blocking mechanism
 //    2019-02-24  Dan Ogorchock  Added new special callOnMsgRcvd2 callback capability. Allows recvd string to be manipulated in the sketch before being processed by Everything.
 //    2021-05-23  Dan Ogorchock  Address EXP8266 v3.0.0 board support package compatibility issue with Strings  
+//    2026-10-18  agent          Replaced the '|' delimited Return_String with the fixed slot st::MessageQueue ring buffer
+//    2026-10-18  agent          Made sendStrings() non-blocking - queued messages are paced out by run() instead of delay()
+//    2026-10-18  agent          Added optional coalescing of queued PollingSensor readings (coalesceReadings)
+//    2026-10-18  agent          Send the whole queue in one transmission when the SmartThings object has batching enabled
+//    2026-10-18  agent          getDeviceByName() uses a sorted name index (binary search, no String allocations)
+//    2026-10-18  agent          Added const char* versions of sendSmartString()/sendSmartStringNow() for st::Message
+//    2026-10-18  agent          PollingSensors are polled from a deadline ordered min-heap - only the sensors that are due are woken
+//    2026-10-18  agent          Capture all GPIO inputs once per run() (st::GpioSnapshot) before updating the InterruptSensors
+//    2026-10-18  agent          Added autoPhase - initDevices() staggers the first poll of PollingSensors that have no offset
+//    2026-10-18  agent          Added refreshSnapshot - one refresh pass that skips recently sent devices and goes out as one batch
+//    2026-10-18  agent          Added optional st::Profiler hooks (ENABLE_PROFILER in Constants.h) and the "profile" command
+//    2026-10-18  agent          Added st::MemoryStats sampling on a timer, reportMemory and the "memory" command
+//    2026-10-18  agent          Added addRegistry() for compile time device lists (st::Registry<...>)
+//    2026-10-18  agent          Device counts are 16 bit (capacity is set in Constants.h / by build flags)
+//    2026-10-18  agent          Messages are kept in st::MessageSpool while the link is down and replayed, oldest first, once it is back (ENABLE_MESSAGE_SPOOL)
+//    2026-10-18  agent          Only messages queued as readings (sendSmartString(..., true), Message::sendReading()) are coalesced - events sent from getData() are not
+//    2026-10-18  agent          autoPhase only plans PollingSensors created with PollingSensor::OFFSET_AUTO, so a sketch can pin a sensor to offset 0
+//    2026-10-18  agent          flushStrings() no longer waits for a link that is down, nor more than FLUSH_WAIT_TIMEOUT for the communication method
+//    2026-10-18  agent          Batches (batching enabled, refresh snapshot) hold at most BATCH_MAX_MESSAGES
+//    2026-10-18  agent          refreshSnapshot only exists if ENABLE_REFRESH_SNAPSHOT is defined in Constants.h (it costs every Device 4 bytes of RAM)
 //
 //******************************************************************************************
 
@@ -36,6 +56,14 @@
 #include "Constants.h"
 #include "Sensor.h"
 #include "Executor.h"
+#include "PollingSensor.h"
+#include "GpioSnapshot.h"
+#include "Profiler.h"
+#include "MemoryStats.h"
+#include "Registry.h"
+#include "MessageQueue.h"
+#include "MessageSpool.h"
+#include "Message.h"
 
 #include "SmartThings.h"
 
@@ -47,30 +75,69 @@ namespace st
 	{
 		private:
 			static Sensor* m_Sensors[Constants::MAX_SENSOR_COUNT];		//array of Sensor objects that st::Everything will keep track of
-			static byte m_nSensorCount;	//number of st::Sensor objects added to st::Everything in your sketch Setup() routine
+			static uint16_t m_nSensorCount;	//number of st::Sensor objects added to st::Everything in your sketch Setup() routine
 			
 			static Executor* m_Executors[Constants::MAX_EXECUTOR_COUNT]; //array of Executor objects that st::Everything will keep track of
-			static byte m_nExecutorCount;//number of st::Executor objects added to st::Everything in your sketch Setup() routine
+			static uint16_t m_nExecutorCount;//number of st::Executor objects added to st::Everything in your sketch Setup() routine
+
+			static Device* m_DeviceIndex[Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT]; //every Sensor and Executor, sorted by name, for binary search in getDeviceByName()
+			static void addToDeviceIndex(Device *device);	//inserts a newly added device into m_DeviceIndex[], keeping it sorted
+			static bool registerSensor(Sensor *sensor);		//common part of both addSensor() versions
+
+			static Sensor* m_LoopSensors[Constants::MAX_SENSOR_COUNT];	//Sensors whose update() is called on every pass of run() (InterruptSensors, etc...)
+			static uint16_t m_nLoopSensorCount;	//number of Sensors in m_LoopSensors[]
+
+			static PollingSensor* m_PollSchedule[Constants::MAX_SENSOR_COUNT];	//min-heap of PollingSensors ordered by their next deadline - m_PollSchedule[0] is due first
+			static uint16_t m_nPollCount;		//number of PollingSensors in m_PollSchedule[]
+
+			static RegistryBase* m_pRegistry;	//devices added with addRegistry() - held by value in the registry, not in the arrays above
+			static bool m_bSchedulerStarted;//true once initDevices() has set the first deadlines
+			static bool pollsBefore(uint16_t a, uint16_t b);	//wrap-safe comparison of the deadlines of two heap entries
+			static void siftUp(uint16_t index);	//restores the heap order after an entry's deadline moved earlier
+			static void siftDown(uint16_t index);	//restores the heap order after an entry's deadline moved later
+			static void pollDueSensors();	//polls every PollingSensor whose deadline has been reached
+			static void planPhases();		//chooses offsets for PollingSensors created with PollingSensor::OFFSET_AUTO (see autoPhase)
 			
 			
 			//static SmartThingsNetworkState_t stNetworkState;
 		
 			//static void updateNetworkState();	//keeps track of the current ST Shield to Hub network status
 			static void updateDevices();		//simply calls update on all the sensors
-			static void sendStrings();			//sends all updates from the devices in Return_String
+			static void sendStrings();			//sends the next update from the message queue once the transmit interval has elapsed - never blocks
+			static void flushStrings();			//sends all updates from the message queue right now, delaying between messages as required - blocks, but not while the link is down nor longer than FLUSH_WAIT_TIMEOUT
+			static void transmitStrings();		//sends the oldest update in the message queue (or up to BATCH_MAX_MESSAGES queued updates in one batch, if batching is enabled)
+			#ifndef DISABLE_SMARTTHINGS
+				static void takeBackUndelivered();	//queues (or spools) again the messages the communication method has given up on, ahead of the newer ones
+			#endif
 			static unsigned long sendstringsLastMillis;	//keep track of how long since last time we sent data to ST Cloud, to enable throttling
 
 			static unsigned long lastmillis;	//used to keep track of last time run() has output freeRam() info
+			static unsigned long m_nMemorySampleMillis;	//last time run() called MemoryStats::sample()
+			static unsigned long m_nMemoryReportMillis;	//last time run() sent the MemoryStats to the hub
 			
 			//stuff for refreshing Devices
 			static unsigned long refLastMillis;	//used to keep track of last time run() has called refreshDevices()
 			static void refreshDevices();		//simply calls refresh on all the Devices
+			#if defined(ENABLE_REFRESH_SNAPSHOT)
+				static void refreshSnapshotPass();	//refreshSnapshot mode - refreshes as many Devices as the queue has room for, in one pass
+				static uint16_t m_nRefreshCursor;		//refreshSnapshot mode - next Device to refresh (Executors first, then Sensors)
+				static bool m_bRefreshSkipRecent;	//refreshSnapshot mode - false while a refresh requested by the hub is in progress
+				static bool m_bSnapshotPending;		//refreshSnapshot mode - the next transmissions send the queue in batches (of up to BATCH_MAX_MESSAGES)
+				static void markSent(const char *message);	//records the send time on the Device the message belongs to
+			#endif
 
 			#ifdef ENABLE_SERIAL
 				static void readSerial();		//reads data from Arduino IDE Serial Monitor, if enabled in Constants.h
 			#endif
 		
-			static String Return_String;		//static buffer for string data queued for transfer to SmartThings Shield - prevents dynamic memory allocation heap fragmentation
+			static MessageQueue m_MessageQueue;	//static ring buffer for string data queued for transfer to SmartThings Shield - prevents dynamic memory allocation heap fragmentation
+
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				static MessageSpool m_MessageSpool;	//messages kept in flash/EEPROM while the communication method's link is down (see MessageSpool.h)
+				static unsigned long m_nReplayLastMillis;	//last time replaySpool() sent a spooled message (or found the link still down)
+				static void spoolStrings();		//moves every queued message into the spool
+				static void replaySpool();		//sends the oldest spooled message once the link is back, at most every SPOOL_REPLAY_INTERVAL
+			#endif
 		
 		public:
 			static void init();					//st::Everything initialization routine called in your sketch setup() routine 
@@ -79,15 +146,40 @@ namespace st
 			
 			static bool sendSmartString(const String &str); //sendSmartString() may edit the string reference passed to it - queues messages - preferable
 			static bool sendSmartStringNow(const String &str); //sendSmartStringNow() may edit the string reference passed to it - sends messages immediate - only for special circumstances
+			static bool sendSmartString(const char *str, unsigned int len, bool reading=false);	//queues the first len chars of str - used by st::Message, no String is created - a reading may be coalesced (see coalesceReadings)
+			static bool sendSmartStringNow(const char *str, unsigned int len);	//queues the first len chars of str and sends immediately - only for special circumstances
 
 			static Device* getDeviceByName(const String &str);	//returns pointer to Device object by name
+			static Device* getDeviceByName(const char *name, unsigned int len);	//returns pointer to Device object by name (first len chars of name) - no String is created
+
+			static const MessageQueue& getMessageQueue() {return m_MessageQueue;}	//gives access to the queue statistics (count, high water mark, dropped messages)
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				static const MessageSpool& getMessageSpool() {return m_MessageSpool;}	//gives access to the spool statistics (count, spooled, replayed, dropped messages)
+			#endif
 			
 			static bool addSensor(Sensor *sensor);		//adds a Sensor object to st::Everything's m_Sensors[] array - called in your sketch setup() routine
+			static bool addSensor(PollingSensor *sensor);//adds a PollingSensor - it is only woken by the poll scheduler when its interval has elapsed
 			static bool addExecutor(Executor *executor);//adds a Executor object to st::Everything's m_Executors[] array - called in your sketch setup() routine
+			static bool addRegistry(RegistryBase *registry);//adds every device held by a st::Registry<...> (only one registry per sketch) - called in your sketch setup() routine
 		
+			static void reschedule(PollingSensor *sensor);	//called by PollingSensor when its deadline is changed (setInterval(), offset())
+			static unsigned long getTimeUntilNextPoll();	//milliseconds until the next PollingSensor is due (0 if one is due now, 0xFFFFFFFF if there are none)
+			static unsigned long getTimeUntilNextWork();	//milliseconds until run() next has timed work to do (polls, queued messages, refresh) - the loop may yield or light sleep this long
+															//NOTE: InterruptSensors and Executors are still checked on every run() pass and are not included
+
 			static byte bTimersPending;	//number of time critical events in progress - if > 0, do NOT perform refreshDevices() routine 
 
 			static bool debug;	//debug flag to determine if debug print statements are executed - set value in your sketch's setup() routine
+
+			static bool autoPhase;	//if true, initDevices() picks the offset of every PollingSensor created with offset PollingSensor::OFFSET_AUTO, so polls and their transmissions are spread out - set value in your sketch's setup() routine
+
+			#if defined(ENABLE_REFRESH_SNAPSHOT)
+				static bool refreshSnapshot;	//if true, the periodic refresh runs as one pass over all Devices, skips Devices that sent within DEV_REFRESH_INTERVAL, and goes out in batches (of up to BATCH_MAX_MESSAGES) where the SmartThings object supports it - set value in your sketch's setup() routine (requires ENABLE_REFRESH_SNAPSHOT in Constants.h)
+			#endif
+
+			static bool reportMemory;	//if true, the MemoryStats (free heap, largest block, fragmentation, min free heap, stack headroom) are sent to the hub every MEMORY_REPORT_INTERVAL seconds - set value in your sketch's setup() routine
+
+			static bool coalesceReadings;	//if true, a new reading (Message::sendReading()) replaces the same attribute's older reading still waiting in the queue (events are never merged) - set value in your sketch's setup() routine
 			
 			static void (*callOnMsgSend)(const String &msg); //If this function pointer is assigned, the function it points to will be called upon every time a string is sent to the cloud.		
 			static void (*callOnMsgRcvd)(const String &msg); //If this function pointer is assigned, the function it points to will be called upon every time a string is received from the cloud.
@@ -99,6 +191,7 @@ namespace st
 			#endif
 
 			friend SmartThingsCallout_t receiveSmartString; //callback function to act on data received from SmartThings Shield - called from SmartThings Shield Library
+			friend class RegistryBase;	//flushes the queue between the init() calls of its devices
 			
 			//SmartThings Object
 			//#ifndef DISABLE_SMARTTHINGS
@@ -0,0 +1,121 @@
+//******************************************************************************************
+//  File: GpioSnapshot.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::GpioSnapshot is a static class which reads the GPIO input registers once per
+//			  pass through st::Everything::run() and lets every InterruptSensor take its pin's
+//			  bit from that copy.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          The host simulation uses the AVR code path against its mock port registers
+//
+//
+//******************************************************************************************
+
+#include "GpioSnapshot.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+	#include <soc/gpio_reg.h>
+#endif
+
+namespace st
+{
+//public
+	bool GpioSnapshot::registerPin(byte pin, byte &port, Mask &mask)
+	{
+		port = NO_PORT;
+		mask = 0;
+
+#if defined(ARDUINO_ARCH_AVR) || defined(ST_HOSTSIM)
+		byte p = digitalPinToPort(pin);
+		if (p == NOT_A_PIN || p >= PORT_COUNT)
+		{
+			return false;
+		}
+		port = p;
+		mask = digitalPinToBitMask(pin);
+#elif defined(ARDUINO_ARCH_ESP32)
+		if (pin < 32)
+		{
+			port = 0;
+			mask = (Mask)1 << pin;
+		}
+	#if defined(GPIO_IN1_REG)
+		else if (pin < 64)
+		{
+			port = 1;
+			mask = (Mask)1 << (pin - 32);
+		}
+	#endif
+		else
+		{
+			return false;
+		}
+#elif defined(ARDUINO_ARCH_ESP8266)
+		if (pin < 16)
+		{
+			port = 0;
+			mask = (Mask)1 << pin;
+		}
+		else if (pin == 16)
+		{
+			port = 1;
+			mask = 1;
+		}
+		else
+		{
+			return false;	//A0 is analog only
+		}
+#else
+		(void)pin;
+		return false;
+#endif
+
+		m_nUsedPorts |= (uint16_t)1 << port;
+		return true;
+	}
+
+	void GpioSnapshot::capture()
+	{
+		if (m_nUsedPorts == 0)
+		{
+			return;
+		}
+
+#if defined(ARDUINO_ARCH_AVR) || defined(ST_HOSTSIM)
+		for (byte p = 1; p < PORT_COUNT; p++)
+		{
+			if (m_nUsedPorts & ((uint16_t)1 << p))
+			{
+				m_Ports[p] = *portInputRegister(p);
+			}
+		}
+#elif defined(ARDUINO_ARCH_ESP32)
+		m_Ports[0] = REG_READ(GPIO_IN_REG);
+	#if defined(GPIO_IN1_REG)
+		if (m_nUsedPorts & 0x02)
+		{
+			m_Ports[1] = REG_READ(GPIO_IN1_REG);
+		}
+	#endif
+#elif defined(ARDUINO_ARCH_ESP8266)
+		m_Ports[0] = GPI;
+		if (m_nUsedPorts & 0x02)
+		{
+			m_Ports[1] = GP16I & 0x01;
+		}
+#endif
+		m_bCaptured = true;
+	}
+
+	//initialize static members
+	GpioSnapshot::Mask GpioSnapshot::m_Ports[GpioSnapshot::PORT_COUNT];
+	uint16_t GpioSnapshot::m_nUsedPorts=0;
+	bool GpioSnapshot::m_bCaptured=false;
+}
@@ -0,0 +1,78 @@
+//******************************************************************************************
+//  File: GpioSnapshot.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::GpioSnapshot is a static class which reads the GPIO input registers once per
+//			  pass through st::Everything::run() and lets every InterruptSensor take its pin's
+//			  bit from that copy.  This replaces one digitalRead() (and its pin to port lookup) per
+//			  sensor per loop with one register read per port, and all sensors see the inputs as
+//			  they were at the same instant.
+//
+//			  The pin to port/bit lookup is done once, when the pin is registered:
+//				- AVR (UNO, MEGA, ...)	PINx registers via portInputRegister()
+//				- ESP32					GPIO_IN_REG (pins 0-31) and GPIO_IN1_REG (pins 32-39)
+//				- ESP8266				GPI (pins 0-15) and GP16I (pin 16)
+//				- host simulation		the mock core's AVR style PINx registers (extras/hostsim)
+//			  Any other board, or a pin with no port (e.g. ESP8266 A0), falls back to digitalRead().
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          The host simulation uses the AVR code path against its mock port registers
+//
+//
+//******************************************************************************************
+
+#ifndef ST_GPIOSNAPSHOT_H
+#define ST_GPIOSNAPSHOT_H
+
+#include <Arduino.h>
+
+namespace st
+{
+	class GpioSnapshot
+	{
+		public:
+			#if defined(ARDUINO_ARCH_AVR) || defined(ST_HOSTSIM)
+				typedef uint8_t Mask;		//AVR ports are 8 bits wide
+				static const byte PORT_COUNT = 13;	//port numbers returned by digitalPinToPort() (PA=1 ... PL=12 on the MEGA)
+			#elif defined(ARDUINO_ARCH_ESP32)
+				typedef uint32_t Mask;
+				static const byte PORT_COUNT = 2;	//GPIO_IN_REG, GPIO_IN1_REG
+			#elif defined(ARDUINO_ARCH_ESP8266)
+				typedef uint32_t Mask;
+				static const byte PORT_COUNT = 2;	//GPI, GP16I
+			#else
+				typedef uint32_t Mask;
+				static const byte PORT_COUNT = 1;	//unused - every pin falls back to digitalRead()
+			#endif
+			static const byte NO_PORT = 0xFF;	//port value for pins that must be read with digitalRead()
+
+			//looks up the port and bit of pin and includes that port in every capture() - returns false if the pin will fall back to digitalRead()
+			static bool registerPin(byte pin, byte &port, Mask &mask);
+
+			//reads the input register of every registered port - called by st::Everything once per run()
+			static void capture();
+
+			//returns the level of a registered pin as of the last capture() (digitalRead() if there is no port, or nothing has been captured yet)
+			static inline bool read(byte pin, byte port, Mask mask)
+			{
+				if (port == NO_PORT || !m_bCaptured)
+				{
+					return digitalRead(pin);
+				}
+				return (m_Ports[port] & mask) != 0;
+			}
+
+		private:
+			static Mask m_Ports[PORT_COUNT];	//register values from the last capture()
+			static uint16_t m_nUsedPorts;		//bit n set if port n has a registered pin
+			static bool m_bCaptured;			//true once capture() has run
+	};
+}
+
+#endif
@@ -60,7 +60,7 @@ namespace st
 	void IS_Button::refresh()
 	{
 		//Send 'init' message to allow Parent Driver to set numberOfButtons attribute automatically
-		Everything::sendSmartString(getName() + F(" init"));
+		Message(getNameF()).value(F("init")).send();
 	}
 
 	void IS_Button::update()
@@ -73,7 +73,7 @@ namespace st
 			{
 				m_bHeldSent = true;
 				//add the "held" event to the buffer to be queued for transfer to SmartThings
-				Everything::sendSmartString(getName() + F(" held"));
+				Message(getNameF()).value(F("held")).send();
 			}
 
 		}
@@ -100,10 +100,10 @@ namespace st
 			if ((millis() - m_lTimeBtnPressed) < m_lreqNumMillisHeld)
 			{
 				//immediately send the "pushed" event to the Hub (to make sure it arrives before the 'released' event)
-				Everything::sendSmartStringNow(getName() + F(" pushed"));
+				Message(getNameF()).value(F("pushed")).sendNow();
 			}
 			//add the "released" event to the buffer to be queued for transfer to Hub
-			Everything::sendSmartString(getName() + F(" released"));
+			Message(getNameF()).value(F("released")).send();
 
 			m_bHeldSent = false;
 		}
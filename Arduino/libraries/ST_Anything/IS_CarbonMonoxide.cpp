@@ -55,19 +55,19 @@ namespace st
 	//called periodically by Everything class to ensure ST Cloud is kept consistent with the state of the contact sensor
 	void IS_CarbonMonoxide::refresh()
 	{
-		Everything::sendSmartString(getName() + (getStatus() ? F(" clear") : F(" detected")));
+		Message(getNameF()).value(getStatus() ? F("clear") : F("detected")).send();
 	}
 
 	void IS_CarbonMonoxide::runInterrupt()
 	{
 		//add the "closed" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" clear"));
+		Message(getNameF()).value(F("clear")).send();
 	}
 	
 	void IS_CarbonMonoxide::runInterruptEnded()
 	{
 		//add the "open" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" detected"));
+		Message(getNameF()).value(F("detected")).send();
 	}
 
 }
\ No newline at end of file
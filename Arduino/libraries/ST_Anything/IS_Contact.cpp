@@ -56,19 +56,19 @@ namespace st
 	//called periodically by Everything class to ensure ST Cloud is kept consistent with the state of the contact sensor
 	void IS_Contact::refresh()
 	{
-		Everything::sendSmartString(getName() + (getStatus() ? F(" closed") : F(" open")));
+		Message(getNameF()).value(getStatus() ? F("closed") : F("open")).send();
 	}
 
 	void IS_Contact::runInterrupt()
 	{
 		//add the "closed" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" closed"));
+		Message(getNameF()).value(F("closed")).send();
 	}
 	
 	void IS_Contact::runInterruptEnded()
 	{
 		//add the "open" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" open"));
+		Message(getNameF()).value(F("open")).send();
 	}
 
 }
@@ -117,7 +117,7 @@ namespace st
 			}
 			if (m_bUseMomentary) {
 				//Queue the door status update the ST Cloud 
-				Everything::sendSmartStringNow(getName() + (getStatus() ? F(" opening") : F(" closing")));
+				Message(getNameF()).value(getStatus() ? F("opening") : F("closing")).sendNow();
 			}
 		}
 		else if (s == F("off"))
@@ -137,19 +137,19 @@ namespace st
 	//called periodically by Everything class to ensure ST Cloud is kept consistent with the state of the contact sensor
 	void IS_DoorControl::refresh()
 	{
-		Everything::sendSmartString(getName() + (getStatus() ? F(" closed") : F(" open")));
+		Message(getNameF()).value(getStatus() ? F("closed") : F("open")).send();
 	}
 
 	void IS_DoorControl::runInterrupt()
 	{
 		//add the "closed" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" closed"));
+		Message(getNameF()).value(F("closed")).send();
 	}
 	
 	void IS_DoorControl::runInterruptEnded()
 	{
 		//add the "open" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" open"));
+		Message(getNameF()).value(F("open")).send();
 	}
 
 	void IS_DoorControl::setOutputPin(byte pin)
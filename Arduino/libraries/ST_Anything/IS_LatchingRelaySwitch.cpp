@@ -188,19 +188,19 @@ namespace st
 	{
 		//Queue the relay status update the Hub
 		//Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
-		Everything::sendSmartString(getName() + (getStatus() ? F(" off") : F(" on")));
+		Message(getNameF()).value(getStatus() ? F("off") : F("on")).send();
 	}
 
 	void IS_LatchingRelaySwitch::runInterrupt()
 	{
 		//add the "closed" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" off"));
+		Message(getNameF()).value(F("off")).send();
 	}
 	
 	void IS_LatchingRelaySwitch::runInterruptEnded()
 	{
 		//add the "open" event to the buffer to be queued for transfer to the ST Shield
-		Everything::sendSmartString(getName() + F(" on"));
+		Message(getNameF()).value(F("on")).send();
 	}
 
 }
@@ -67,14 +67,14 @@ namespace st
 	//called periodically by Everything class to ensure ST Cloud is kept consistent with the state of the motion sensor
 	void IS_Motion::refresh()
 	{
-		Everything::sendSmartString(getName() + (getStatus() ? F(" active") : F(" inactive")));
+		Message(getNameF()).value(getStatus() ? F("active") : F("inactive")).send();
 	}
 
 	void IS_Motion::runInterrupt()
 	{
 		if (m_inactiveTimerRunning == false) {
 			//add the "active" event to the buffer to be queued for transfer to the ST Shield
-			Everything::sendSmartString(getName() + F(" active"));
+			Message(getNameF()).value(F("active")).send();
 		}
 		//cancel any inactivity timer that may be running
 		m_inactiveTimerRunning = false;
@@ -96,7 +96,7 @@ namespace st
 			if ((m_inactiveTimerRunning == true) && (millis() > m_inactiveTimer + m_inactiveTimeout)) {
 				m_inactiveTimerRunning = false;
 				//add the "inactive" event to the buffer to be queued for transfer to the ST Shield
-				Everything::sendSmartString(getName() + F(" inactive"));
+				Message(getNameF()).value(F("inactive")).send();
 			}
 		}
 		else
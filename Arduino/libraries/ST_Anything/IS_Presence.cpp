@@ -54,19 +54,19 @@ namespace st
 	//called periodically by Everything class to ensure ST Cloud is kept consistent with the state of the presence sensor
 	void IS_Presence::refresh()
 	{
-		Everything::sendSmartString(getName() + (getStatus() ? F(" present") : F(" notpresent")));
+		Message(getNameF()).value(getStatus() ? F("present") : F("notpresent")).send();
 	}
 
 	void IS_Presence::runInterrupt()
 	{
 		//add the "present" event to the buffer to be queued for transfer to Hubitat/SmartThings
-		Everything::sendSmartString(getName() + F(" present"));
+		Message(getNameF()).value(F("present")).send();
 	}
 	
 	void IS_Presence::runInterruptEnded()
 	{
 		//add the "notpresent" event to the buffer to be queued for transfer to Hubitat/SmartThings
-		Everything::sendSmartString(getName() + F(" notpresent"));
+		Message(getNameF()).value(F("notpresent")).send();
 	}
 
 }
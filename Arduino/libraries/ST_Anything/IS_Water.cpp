@@ -55,19 +55,19 @@ namespace st
 	//called periodically by Everything class to ensure the Hub is kept consistent with the state of the water sensor
 	void IS_Water::refresh()
 	{
-		Everything::sendSmartString(getName() + (getStatus() ? F(" wet") : F(" dry")));
+		Message(getNameF()).value(getStatus() ? F("wet") : F("dry")).send();
 	}
 
 	void IS_Water::runInterrupt()
 	{
 		//add the "closed" event to the buffer to be queued for transfer to the hub
-		Everything::sendSmartString(getName() + F(" wet"));
+		Message(getNameF()).value(F("wet")).send();
 	}
 	
 	void IS_Water::runInterruptEnded()
 	{
 		//add the "open" event to the buffer to be queued for transfer to the hub
-		Everything::sendSmartString(getName() + F(" dry"));
+		Message(getNameF()).value(F("dry")).send();
 	}
 
 }
@@ -13,6 +13,10 @@
 //    2015-01-03  Dan & Daniel   Original Creation
 //	  2015-03-17  Dan			 Added optional "numReqCounts" constructor argument/capability
 //    2019-09-22  Dan Ogorchock  ESP8266 support for using A0 pin as a digital input
+//    2026-10-18  agent          Added optional hardware interrupt mode - timestamped edges from an ISR, debounced on time instead of loop counts
+//    2026-10-18  agent          Polled mode reads the pin from st::GpioSnapshot instead of calling digitalRead() per sensor
+//    2026-10-18  agent          ESP8266 A0 is sampled on a time interval instead of every 1000 passes through loop()
+//    2026-10-18  agent          Only instantiate a trampoline for each of the MAX_HARDWARE_INTERRUPTS slots
 //
 //
 //******************************************************************************************
@@ -22,9 +26,106 @@
 #include "Constants.h"
 #include "Everything.h"
 
+//ISRs must be placed in IRAM on the ESP8266 and ESP32
+#if defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32)
+	#ifndef IRAM_ATTR
+		#define IRAM_ATTR ICACHE_RAM_ATTR
+	#endif
+	#define ST_ISR_ATTR IRAM_ATTR
+#else
+	#define ST_ISR_ATTR
+#endif
+
 namespace st
 {
+#if defined(ARDUINO_ARCH_ESP8266)
+	static const unsigned long A0_SAMPLE_INTERVAL = 20;	//in milliseconds - reading an analog input every pass through loop() is too slow
+#endif
+
 //private
+	//the ISR - keep it short, everything else is done by update()
+	void ST_ISR_ATTR InterruptSensor::handleEdge(byte slot)
+	{
+		HardwareSlot &hw = m_HardwareSlots[slot];
+		Edge edge;
+		edge.micros = micros();
+		edge.level = digitalRead(hw.sensor->m_nInterruptPin);
+		if (!hw.edges.push(edge))
+		{
+			hw.overflow = true;
+		}
+	}
+
+	template<byte SLOT> void ST_ISR_ATTR InterruptSensor::trampoline()
+	{
+		handleEdge(SLOT);
+	}
+
+	template<byte SLOT> InterruptSensor::Isr InterruptSensor::getTrampoline(byte slot)
+	{
+		return slot == SLOT ? &trampoline<SLOT> : getTrampoline<SLOT + 1>(slot);
+	}
+
+	template<> InterruptSensor::Isr InterruptSensor::getTrampoline<Constants::MAX_HARDWARE_INTERRUPTS>(byte)
+	{
+		return 0;
+	}
+
+	void InterruptSensor::setStatus(bool inputState)
+	{
+		if (inputState == m_bInterruptState && !m_bStatus) //new interrupt
+		{
+			m_bStatus = true;
+			m_bInitRequired = false;
+			runInterrupt();
+		}
+		else if ((inputState != m_bInterruptState && m_bStatus) || m_bInitRequired) //interrupt has ended OR Init called us
+		{
+			m_bStatus = false;
+			m_bInitRequired = false;
+			runInterruptEnded();
+		}
+	}
+
+	//Hardware interrupt mode - a level is only believed once it has been stable for debounceMicros
+	void InterruptSensor::processEdges()
+	{
+		HardwareSlot &hw = m_HardwareSlots[m_nHardwareSlot];
+		Edge edge;
+		while (hw.edges.pop(edge))
+		{
+			//the previous level lasted until this edge - accept it if that was long enough
+			if (hw.pending && (unsigned long)(uint32_t)(edge.micros - hw.pendingMicros) >= hw.debounceMicros)
+			{
+				hw.lastEdgeMicros = hw.pendingMicros;
+				setStatus(hw.pendingLevel);
+			}
+			hw.pending = true;
+			hw.pendingLevel = edge.level;
+			hw.pendingMicros = edge.micros;
+		}
+
+		if (hw.overflow)
+		{
+			//edges were lost - start again from the pin's current level
+			hw.overflow = false;
+			hw.pending = true;
+			hw.pendingLevel = digitalRead(m_nInterruptPin);
+			hw.pendingMicros = micros();
+			if (debug)
+			{
+				Serial.print(F("InterruptSensor: edge queue overflow on "));
+				Serial.println(getName());
+			}
+		}
+
+		if (hw.pending && (unsigned long)(uint32_t)(micros() - hw.pendingMicros) >= hw.debounceMicros)
+		{
+			hw.pending = false;
+			hw.lastEdgeMicros = hw.pendingMicros;
+			setStatus(hw.pendingLevel);
+		}
+	}
 
 	//Checks to see if the pin has changed state.  If so calls appropriate function.
 	void InterruptSensor::checkIfTriggered()
@@ -33,20 +134,19 @@ namespace st
 #if defined(ARDUINO_ARCH_ESP8266)
             if (m_nInterruptPin == A0) 
 			{
-				if (m_nLoopCounter == 1000) {				//reading an analog input every pass through loop() is too slow
+				if (millis() - m_nLastAnalogMillis >= A0_SAMPLE_INTERVAL) {	//reading an analog input every pass through loop() is too slow
 					inputState = analogRead(A0) > 512 ? HIGH : LOW;
-					m_nLoopCounter = 0;
+					m_nLastAnalogMillis = millis();
 				}
 				else {
-					m_nLoopCounter++;
 					return;
 				}
 			}
 			else {
-				inputState = digitalRead(m_nInterruptPin);
+				inputState = GpioSnapshot::read(m_nInterruptPin, m_nInputPort, m_nInputMask);
 			}
 #else
-            inputState = digitalRead(m_nInterruptPin);
+            inputState = GpioSnapshot::read(m_nInterruptPin, m_nInputPort, m_nInputMask);
 #endif
 			if (inputState == m_bInterruptState && !m_bStatus) //new interrupt
 			{
@@ -83,7 +183,8 @@ namespace st
 		m_nRequiredCounts(numReqCounts),
 		m_nCurrentUpCount(0),
 		m_nCurrentDownCount(numReqCounts),
-		m_nLoopCounter(0)
+		m_nLastAnalogMillis(0),
+		m_nHardwareSlot(NO_HARDWARE_SLOT)
 		{
 			setInterruptPin(pin);
 		}
@@ -97,13 +198,74 @@ namespace st
 	//initialization function
 	void InterruptSensor::init()
 	{
-		checkIfTriggered();
+		if (isHardwareInterrupt())
+		{
+			//attach first so no edge after the initial read is missed
+			HardwareSlot &hw = m_HardwareSlots[m_nHardwareSlot];
+			hw.edges.clear();
+			hw.overflow = false;
+			hw.pending = false;
+			attachInterrupt(digitalPinToInterrupt(m_nInterruptPin), getTrampoline<0>(m_nHardwareSlot), CHANGE);
+			hw.lastEdgeMicros = micros();
+			setStatus(digitalRead(m_nInterruptPin));
+		}
+		else
+		{
+			checkIfTriggered();
+		}
 	}
 	
 	//update function 
 	void InterruptSensor::update()
 	{
-		checkIfTriggered();
+		if (isHardwareInterrupt())
+		{
+			processEdges();
+		}
+		else
+		{
+			checkIfTriggered();
+		}
+	}
+
+	bool InterruptSensor::enableHardwareInterrupt(unsigned long debounceMicros)
+	{
+		if (isHardwareInterrupt())
+		{
+			m_HardwareSlots[m_nHardwareSlot].debounceMicros = debounceMicros;
+			return true;
+		}
+
+#if defined(ARDUINO_ARCH_ESP8266)
+		if (m_nInterruptPin == A0)
+		{
+			return false;
+		}
+#endif
+		if (digitalPinToInterrupt(m_nInterruptPin) == NOT_AN_INTERRUPT || m_nHardwareSlotCount >= Constants::MAX_HARDWARE_INTERRUPTS)
+		{
+			if (debug)
+			{
+				Serial.print(F("InterruptSensor: hardware interrupt not available for "));
+				Serial.print(getName());
+				Serial.println(F(" - polling the pin instead"));
+			}
+			return false;
+		}
+
+		m_nHardwareSlot = m_nHardwareSlotCount++;
+		HardwareSlot &hw = m_HardwareSlots[m_nHardwareSlot];
+		hw.sensor = this;
+		hw.overflow = false;
+		hw.pending = false;
+		hw.debounceMicros = debounceMicros;
+		hw.lastEdgeMicros = 0;
+		return true;
+	}
+
+	unsigned long InterruptSensor::getLastEdgeMicros() const
+	{
+		return isHardwareInterrupt() ? m_HardwareSlots[m_nHardwareSlot].lastEdgeMicros : 0;
 	}
 
 	//handles start of an interrupt - all derived classes should implement this virtual function
@@ -111,7 +273,7 @@ namespace st
 	{
 		if(debug)
 		{
-			Everything::sendSmartString(getName()+F(" triggered ") + (m_bInterruptState?F("HIGH"):F("LOW)")));
+			Message(getNameF()).value(F("triggered")).value(m_bInterruptState?F("HIGH"):F("LOW)")).send();
 		}
 	}
 	
@@ -120,7 +282,7 @@ namespace st
 	{
 		if(debug)
 		{
-			Everything::sendSmartString(getName()+F(" ended ") + (m_bInterruptState?F("LOW)"):F("HIGH)")));
+			Message(getNameF()).value(F("ended")).value(m_bInterruptState?F("LOW)"):F("HIGH)")).send();
 		}
 	}
 	
@@ -128,6 +290,7 @@ namespace st
 	void InterruptSensor::setInterruptPin(byte pin)
 	{
 		m_nInterruptPin=pin;
+		GpioSnapshot::registerPin(pin, m_nInputPort, m_nInputMask);
 
 #if defined(ARDUINO_ARCH_ESP8266)
         if (pin == A0)
@@ -148,4 +311,8 @@ namespace st
 	
 	//debug flag to determine if debug print statements are executed (set value in your sketch)
 	bool InterruptSensor::debug=false;
-}
\ No newline at end of file
+
+	//hardware interrupt mode static members
+	InterruptSensor::HardwareSlot InterruptSensor::m_HardwareSlots[Constants::MAX_HARDWARE_INTERRUPTS];
+	byte InterruptSensor::m_nHardwareSlotCount=0;
+}
\ No newline at end of file
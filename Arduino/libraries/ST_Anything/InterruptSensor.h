@@ -4,6 +4,16 @@
 //
 //  Summary:  st::InterruptSensor is a generic class which inherits from st::Sensor.  This is the
 //			  parent class for the st::IS_Motion, IS_Contact, and IS_DoorControl classes.
+//
+//			  By default the pin is checked with digitalRead() on every pass through loop(), and
+//			  numReqCounts debounces by counting passes.  If enableHardwareInterrupt() is called in
+//			  your sketch's setup() (before st::Everything::initDevices()), the pin is instead watched
+//			  with attachInterrupt().  The ISR only records the time (micros()) and level of each edge
+//			  in a lock-free queue; update() then debounces those edges on their timestamps, so the
+//			  debounce time and the edge times no longer depend on how long the rest of loop() takes.
+//
+//			  For Example:  sensor1.enableHardwareInterrupt(20000);	//20ms debounce
+//
 //			  In general, this file should not need to be modified.   
 //
 //  Change History:
@@ -13,6 +23,9 @@
 //    2015-01-03  Dan & Daniel   Original Creation
 //	  2015-03-17  Dan			 Added optional "numReqCounts" constructor argument/capability
 //    2019-09-22  Dan Ogorchock  ESP8266 support for using A0 pin as a digital input
+//    2026-10-18  agent          Added optional hardware interrupt mode - timestamped edges from an ISR, debounced on time instead of loop counts
+//    2026-10-18  agent          Polled mode reads the pin from st::GpioSnapshot instead of calling digitalRead() per sensor
+//    2026-10-18  agent          Only instantiate a trampoline for each of the MAX_HARDWARE_INTERRUPTS slots
 //
 //
 //******************************************************************************************
@@ -21,6 +34,9 @@
 #define ST_INTERRUPTSENSOR_H
 
 #include "Sensor.h"
+#include "Constants.h"
+#include "SpscQueue.h"
+#include "GpioSnapshot.h"
 
 namespace st
 {
@@ -35,9 +51,40 @@ namespace st
 			long m_nRequiredCounts;	//Number of required counts (checks of the pin) before believing the pin is high/low
 			long m_nCurrentUpCount;
 			long m_nCurrentDownCount;
-			long m_nLoopCounter;
+			unsigned long m_nLastAnalogMillis;	//ESP8266 A0 only - time of the last analogRead()
+			byte m_nHardwareSlot;	//index into m_HardwareSlots[] if hardware interrupt mode is enabled, otherwise NO_HARDWARE_SLOT
+			byte m_nInputPort;		//st::GpioSnapshot port of m_nInterruptPin (GpioSnapshot::NO_PORT if it must be read with digitalRead())
+			GpioSnapshot::Mask m_nInputMask;	//bit of m_nInterruptPin within that port
 
 			void checkIfTriggered(); 
+			void processEdges();	//hardware interrupt mode - debounces the queued edges and calls runInterrupt()/runInterruptEnded()
+			void setStatus(bool inputState);	//calls runInterrupt()/runInterruptEnded() if inputState changes m_bStatus
+
+			struct Edge
+			{
+				unsigned long micros;	//time of the edge
+				bool level;				//pin level right after the edge
+			};
+
+			struct HardwareSlot
+			{
+				InterruptSensor *sensor;
+				SpscQueue<Edge, Constants::INTERRUPT_EDGE_QUEUE_SIZE> edges;	//written by the ISR, read by update()
+				volatile bool overflow;	//set by the ISR if an edge could not be queued
+				bool pending;			//true if pendingLevel has not yet been stable for the debounce time
+				bool pendingLevel;
+				unsigned long pendingMicros;	//time the pin changed to pendingLevel
+				unsigned long debounceMicros;	//how long a level must be stable before it is believed
+				unsigned long lastEdgeMicros;	//time of the edge that caused the current status
+			};
+
+			static const byte NO_HARDWARE_SLOT = 0xFF;
+			static HardwareSlot m_HardwareSlots[Constants::MAX_HARDWARE_INTERRUPTS];
+			static byte m_nHardwareSlotCount;
+			typedef void (*Isr)();
+			template<byte SLOT> static void trampoline();	//one plain ISR function per slot for attachInterrupt()
+			template<byte SLOT> static Isr getTrampoline(byte slot);	//trampoline<slot>() - only instantiated for slots below MAX_HARDWARE_INTERRUPTS
+			static void handleEdge(byte slot);		//the ISR itself - records micros() and the pin level
 			
 		public:
 			//constructor
@@ -64,9 +111,15 @@ namespace st
 			inline bool getStatus() const {return m_bStatus;}	//whether or not the device is currently interrupted
 			
 			
+			inline bool isHardwareInterrupt() const {return m_nHardwareSlot != NO_HARDWARE_SLOT;}
+			unsigned long getLastEdgeMicros() const;	//hardware interrupt mode - micros() at the debounced edge that caused the current status (0 otherwise)
+			
 			//sets
 			void setInterruptPin(byte pin);
 			void setInterruptState(bool b) {m_bInterruptState=b;}
+
+			//switches to hardware interrupt mode - returns false (and keeps polling) if the pin has no interrupt or all MAX_HARDWARE_INTERRUPTS are in use
+			bool enableHardwareInterrupt(unsigned long debounceMicros = 10000);
 	
 			//debug flag to determine if debug print statements are executed (set value in your sketch)
 			static bool debug;
@@ -75,4 +128,4 @@ namespace st
 }
 
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+//******************************************************************************************
+//  File: MemoryStats.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MemoryStats is a static class which keeps track of free heap, the largest free
+//			  block, fragmentation, the minimum free heap ever seen and the stack headroom.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include "MemoryStats.h"
+#include "Everything.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+	#include <esp_heap_caps.h>
+#elif defined(ARDUINO_ARCH_SAMD)
+	#include <malloc.h>
+	extern "C" char* sbrk(int incr);
+#endif
+
+namespace st
+{
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_SAMD)
+	//stack painting - the RAM between the top of the heap and the stack is filled with STACK_PAINT in
+	//init(); the stack overwrites it as it grows down, the heap as it grows up.  Whatever paint is
+	//left is RAM that neither has ever used.
+	static const uint8_t STACK_PAINT = 0xC5;
+	static const uint8_t STACK_PAINT_MARGIN = 32;	//bytes below the stack pointer left unpainted (init()'s own frame and interrupts)
+	static uint8_t *paintStart = 0;
+	static uint8_t *paintEnd = 0;
+
+	#if defined(ARDUINO_ARCH_AVR)
+		extern char __heap_start;
+		extern char *__brkval;
+
+		//avr-libc's malloc() free list
+		struct __freelist
+		{
+			size_t sz;
+			struct __freelist *nx;
+		};
+		extern struct __freelist *__flp;
+
+		static uint8_t* heapTop()
+		{
+			return (uint8_t*)(__brkval == 0 ? &__heap_start : __brkval);
+		}
+	#else
+		static uint8_t* heapTop()
+		{
+			return (uint8_t*)sbrk(0);
+		}
+	#endif
+#endif
+
+//public
+	void MemoryStats::init()
+	{
+	#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_SAMD)
+		uint8_t top;
+		paintStart = heapTop();
+		paintEnd = &top - STACK_PAINT_MARGIN;
+		for (uint8_t *p = paintStart; p < paintEnd; p++)
+		{
+			*p = STACK_PAINT;
+		}
+	#endif
+		sample();
+	}
+
+	void MemoryStats::sample()
+	{
+		long freeHeap = -1;
+		long largest = -1;
+		long fragmentation = -1;
+
+	#if defined(ARDUINO_ARCH_ESP8266)
+		freeHeap = ESP.getFreeHeap();
+		largest = ESP.getMaxFreeBlockSize();
+		fragmentation = ESP.getHeapFragmentation();
+		m_nStackHeadroom = ESP.getFreeContStack();
+	#elif defined(ARDUINO_ARCH_ESP32)
+		freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+		largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+		m_nMinFreeHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);	//kept by the heap itself - catches every dip, not only the ones seen by sample()
+		m_nStackHeadroom = uxTaskGetStackHighWaterMark(NULL);				//loop() task, in bytes
+	#elif defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_SAMD)
+		uint8_t top;
+		uint8_t *heap = heapTop();
+		long gap = &top - heap;		//never allocated space between the heap and the stack
+
+		#if defined(ARDUINO_ARCH_AVR)
+			//blocks that were freed below the top of the heap
+			long freed = 0;
+			largest = gap;
+			for (struct __freelist *fp = __flp; fp != 0; fp = fp->nx)
+			{
+				freed += fp->sz;
+				if ((long)fp->sz > largest)
+				{
+					largest = fp->sz;
+				}
+			}
+		#else
+			//newlib does not report the size of its largest free chunk - the space above the heap is the best estimate
+			long freed = mallinfo().fordblks;
+			largest = gap;
+		#endif
+		freeHeap = gap + freed;
+
+		//skip past anything the heap wrote above its current top (it may have shrunk), then count the paint that is left
+		uint8_t *p = heap > paintStart ? heap : paintStart;
+		while (p < paintEnd && *p != STACK_PAINT)
+		{
+			p++;
+		}
+		uint8_t *q = p;
+		while (q < paintEnd && *q == STACK_PAINT)
+		{
+			q++;
+		}
+		m_nStackHeadroom = paintEnd > paintStart ? q - p : -1;
+	#endif
+
+		if (freeHeap > 0 && largest >= 0 && fragmentation < 0)
+		{
+			fragmentation = 100 - (largest * 100) / freeHeap;
+		}
+
+	#if !defined(ARDUINO_ARCH_ESP32)
+		if (freeHeap >= 0 && (m_nMinFreeHeap < 0 || freeHeap < m_nMinFreeHeap))
+		{
+			m_nMinFreeHeap = freeHeap;
+		}
+	#endif
+
+		m_nFreeHeap = freeHeap;
+		m_nLargestBlock = largest;
+		m_nFragmentation = fragmentation;
+	}
+
+	void MemoryStats::print()
+	{
+		Serial.print(F("MemoryStats: free heap = "));
+		Serial.print(m_nFreeHeap);
+		Serial.print(F(", largest free block = "));
+		Serial.print(m_nLargestBlock);
+		Serial.print(F(", fragmentation = "));
+		Serial.print(m_nFragmentation);
+		Serial.print(F("%, min free heap = "));
+		Serial.print(m_nMinFreeHeap);
+		Serial.print(F(", stack headroom = "));
+		Serial.println(m_nStackHeadroom);
+	}
+
+	void MemoryStats::send()
+	{
+		//one token after the name, so the hub keeps it as a single attribute value - short enough for the UNO's message slots
+		Message msg(F("memory"));
+		msg.print(' ');
+		msg.print(m_nFreeHeap);
+		msg.print(':');
+		msg.print(m_nLargestBlock);
+		msg.print(':');
+		msg.print(m_nFragmentation);
+		msg.print(':');
+		msg.print(m_nMinFreeHeap);
+		msg.print(':');
+		msg.print(m_nStackHeadroom);
+		msg.send();
+	}
+
+	//initialize static members
+	long MemoryStats::m_nFreeHeap=-1;
+	long MemoryStats::m_nLargestBlock=-1;
+	long MemoryStats::m_nFragmentation=-1;
+	long MemoryStats::m_nMinFreeHeap=-1;
+	long MemoryStats::m_nStackHeadroom=-1;
+}
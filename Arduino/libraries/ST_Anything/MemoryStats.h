@@ -0,0 +1,79 @@
+//******************************************************************************************
+//  File: MemoryStats.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MemoryStats is a static class which keeps track of the memory health of the
+//			  microcontroller.  freeRam() only reports how much heap is free; on a node that has
+//			  been running for weeks the problem is usually that the free heap has been broken into
+//			  pieces too small to use (fragmentation).  st::MemoryStats reports:
+//				- free heap
+//				- the largest free block (the biggest allocation that can still succeed)
+//				- fragmentation (100 - largest free block * 100 / free heap), in percent
+//				- the minimum free heap ever seen
+//				- the stack headroom - the fewest bytes that have ever been left unused by the stack
+//
+//			  How each value is found depends on the board:
+//				- ESP8266	ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(), ESP.getHeapFragmentation(),
+//							ESP.getFreeContStack()
+//				- ESP32		heap_caps_get_free_size(), heap_caps_get_largest_free_block(),
+//							heap_caps_get_minimum_free_size(), uxTaskGetStackHighWaterMark()
+//				- AVR		walks the malloc free list; the stack headroom is measured by "painting" the
+//							unused RAM between the heap and the stack in init() and checking later
+//							how much of the paint is left
+//				- SAMD		same stack painting as AVR, mallinfo() for the free heap inside the arena
+//
+//			  st::Everything calls sample() every MEMORY_SAMPLE_INTERVAL seconds (see Constants.h).  If
+//			  st::Everything::reportMemory is true, the values are also sent to the hub every
+//			  MEMORY_REPORT_INTERVAL seconds as "memory <free>:<largest>:<frag%>:<min free>:<stack>".
+//			  Values that cannot be measured on a board are reported as -1.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef ST_MEMORYSTATS_H
+#define ST_MEMORYSTATS_H
+
+#include <Arduino.h>
+
+namespace st
+{
+	class MemoryStats
+	{
+		private:
+			static long m_nFreeHeap;
+			static long m_nLargestBlock;
+			static long m_nFragmentation;
+			static long m_nMinFreeHeap;
+			static long m_nStackHeadroom;
+
+		public:
+			//paints the unused stack area (AVR/SAMD) - called by Everything::init() as early as possible
+			static void init();
+
+			//measures everything now
+			static void sample();
+
+			//prints the values from the last sample() to Serial
+			static void print();
+
+			//queues the values from the last sample() for transfer to the hub
+			static void send();
+
+			//gets (values from the last sample(), -1 if not available on this board)
+			static long getFreeHeap() {return m_nFreeHeap;}
+			static long getLargestFreeBlock() {return m_nLargestBlock;}
+			static long getFragmentation() {return m_nFragmentation;}	//percent
+			static long getMinFreeHeap() {return m_nMinFreeHeap;}
+			static long getStackHeadroom() {return m_nStackHeadroom;}
+	};
+}
+
+#endif
@@ -0,0 +1,145 @@
+//******************************************************************************************
+//  File: Message.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Message is a small Print-style builder for the "name value" strings that devices
+//			  send to the hub.  The text is formatted directly into a fixed size buffer on the stack
+//			  and then copied into st::Everything's message queue, so building and queueing a
+//			  message never allocates a String on the heap.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Added sendReading()
+//
+//
+//******************************************************************************************
+
+#include "Message.h"
+#include "Everything.h"
+
+namespace st
+{
+//private
+	Message& Message::separator()
+	{
+		write(' ');
+		return *this;
+	}
+
+//public
+	//constructors
+	Message::Message() :
+		m_nLength(0),
+		m_bOverflow(false)
+	{
+		m_Buffer[0] = '\0';
+	}
+
+	Message::Message(const __FlashStringHelper *name) :
+		m_nLength(0),
+		m_bOverflow(false)
+	{
+		m_Buffer[0] = '\0';
+		print(name);
+	}
+
+	Message::Message(const String &name) :
+		m_nLength(0),
+		m_bOverflow(false)
+	{
+		m_Buffer[0] = '\0';
+		print(name);
+	}
+
+	size_t Message::write(uint8_t c)
+	{
+		//leave room for the null terminator
+		if (m_nLength >= Constants::MESSAGE_SLOT_SIZE - 1)
+		{
+			m_bOverflow = true;
+			return 0;
+		}
+		m_Buffer[m_nLength++] = c;
+		m_Buffer[m_nLength] = '\0';
+		return 1;
+	}
+
+	size_t Message::write(const uint8_t *buffer, size_t size)
+	{
+		size_t n = 0;
+		while (n < size && write(buffer[n]))
+		{
+			n++;
+		}
+		return n;
+	}
+
+	Message& Message::value(const __FlashStringHelper *v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(const char *v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(const String &v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(int v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(unsigned int v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(long v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(unsigned long v)
+	{
+		separator().print(v);
+		return *this;
+	}
+
+	Message& Message::value(double v, byte decimals)
+	{
+		separator().print(v, decimals);
+		return *this;
+	}
+
+	bool Message::send() const
+	{
+		//an overflowed message is passed on with a length that cannot fit, so it is counted as a drop by the queue
+		return Everything::sendSmartString(m_Buffer, m_bOverflow ? Constants::MESSAGE_SLOT_SIZE : m_nLength);
+	}
+
+	bool Message::sendReading() const
+	{
+		return Everything::sendSmartString(m_Buffer, m_bOverflow ? Constants::MESSAGE_SLOT_SIZE : m_nLength, true);
+	}
+
+	bool Message::sendNow() const
+	{
+		return Everything::sendSmartStringNow(m_Buffer, m_bOverflow ? Constants::MESSAGE_SLOT_SIZE : m_nLength);
+	}
+}
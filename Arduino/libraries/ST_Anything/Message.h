@@ -0,0 +1,87 @@
+//******************************************************************************************
+//  File: Message.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Message is a small Print-style builder for the "name value" strings that devices
+//			  send to the hub.  The text is formatted directly into a fixed size buffer on the stack
+//			  (one message slot long - see MESSAGE_SLOT_SIZE in Constants.h) and then copied into
+//			  st::Everything's message queue, so building and queueing a message never allocates
+//			  a String on the heap.  This matters on the UNO and MEGA where repeated String
+//			  concatenation fragments the small heap.
+//
+//			  Because st::Message inherits from the Arduino Print class, anything that can be
+//			  printed to Serial can be added to a message (print(), println() are all available).
+//			  The value() helpers add the single space separator and return the message, so the
+//			  common cases fit on one line.
+//
+//			  For Example:  Message(getNameF()).value(m_fSensorValue).send();						//"voltage1 3.30"
+//							Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();	//"switch1 on"
+//							Message(getNameF()).value(m_fTemperature, 1).sendNow();					//"temperature1 72.5" - sent immediately
+//							Message(getNameF()).value(m_fTemperature, 1).sendReading();				//"temperature1 72.5" - may replace an older unsent temperature1
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Added sendReading() - only messages sent this way are coalesced (Everything::coalesceReadings)
+//
+//
+//******************************************************************************************
+
+#ifndef ST_MESSAGE_H
+#define ST_MESSAGE_H
+
+#include <Arduino.h>
+#include "Constants.h"
+
+namespace st
+{
+	class Message: public Print
+	{
+		private:
+			char m_Buffer[Constants::MESSAGE_SLOT_SIZE];	//formatted message (always null terminated)
+			byte m_nLength;									//number of characters in m_Buffer
+			bool m_bOverflow;								//true if more was written than fits in one message slot
+
+			Message& separator();							//adds the ' ' between the name and the value
+
+		public:
+			//constructors
+			Message();
+			Message(const __FlashStringHelper *name);		//starts the message with a device name stored in flash (see Device::getNameF())
+			Message(const String &name);					//starts the message with a name held in a String (e.g. user supplied attribute names)
+
+			//Print interface - everything printed is appended to the message
+			virtual size_t write(uint8_t c);
+			virtual size_t write(const uint8_t *buffer, size_t size);
+			using Print::write;
+
+			//append a space followed by the value - return the message so calls can be chained
+			Message& value(const __FlashStringHelper *v);
+			Message& value(const char *v);
+			Message& value(const String &v);
+			Message& value(int v);
+			Message& value(unsigned int v);
+			Message& value(long v);
+			Message& value(unsigned long v);
+			Message& value(double v, byte decimals=2);
+
+			//queue the message for transfer to the hub - returns false if it was dropped (queue full or message too long)
+			bool send() const;
+			//queue a measured value (temperature, illuminance, ...) - if Everything::coalesceReadings is true it replaces the same
+			//attribute's older reading still waiting in the queue.  Never use it for events (button presses, alarms, state changes)
+			bool sendReading() const;
+			//queue the message and send everything queued immediately (see Everything::sendSmartStringNow())
+			bool sendNow() const;
+
+			//gets
+			inline const char* c_str() const { return m_Buffer; }
+			inline byte length() const { return m_nLength; }
+			inline bool overflowed() const { return m_bOverflow; }
+	};
+}
+
+#endif
@@ -0,0 +1,186 @@
+//******************************************************************************************
+//  File: MessageQueue.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MessageQueue is a fixed size ring buffer of fixed length message slots used by
+//			  st::Everything to hold the strings queued for transfer to the SmartThings/Hubitat hub.
+//			  All storage is allocated once at compile time (see MESSAGE_QUEUE_SIZE and
+//			  MESSAGE_SLOT_SIZE in Constants.h), so queueing and sending a message never touches
+//			  the heap.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation - replaces the '|' delimited Return_String
+//    2026-10-18  agent          Added latest-value-wins coalescing of replaceable messages
+//    2026-10-18  agent          Remembers when each message was queued, if ENABLE_MESSAGE_SPOOL is defined (see MessageSpool.h)
+//    2026-10-18  agent          slotIndex() adds in unsigned int, so queues of more than 128 slots do not wrap at 256
+//    2026-10-18  agent          Added insert()
+//    2026-10-18  agent          16 bit positions and counts - slotIndex() never adds past the queue size, so it cannot overflow either
+//
+//
+//******************************************************************************************
+
+#include "MessageQueue.h"
+
+namespace st
+{
+//private
+	uint16_t MessageQueue::slotIndex(uint16_t pos) const
+	{
+		//head + pos may not fit in 16 bits (unsigned int on AVR), so compare against the room left after the head instead of adding first
+		uint16_t toEnd = Constants::MESSAGE_QUEUE_SIZE - m_nHead;
+		return pos >= toEnd ? pos - toEnd : m_nHead + pos;
+	}
+
+	unsigned int MessageQueue::keyLength(const char *str, unsigned int len)
+	{
+		unsigned int i = 0;
+		while (i < len && str[i] != ' ')
+		{
+			i++;
+		}
+		return i;
+	}
+
+//public
+	//constructor
+	MessageQueue::MessageQueue() :
+		m_nHead(0),
+		m_nCount(0),
+		m_nHighWater(0),
+		m_nDropped(0),
+		m_nCoalesced(0)
+	{
+
+	}
+
+	bool MessageQueue::push(const char *str, unsigned int len, bool replaceable)
+	{
+		//leave room for the null terminator in every slot
+		if (len >= Constants::MESSAGE_SLOT_SIZE)
+		{
+			m_nDropped++;
+			return false;
+		}
+
+		//latest value wins - overwrite an older unsent reading with the same key
+		if (replaceable)
+		{
+			unsigned int keyLen = keyLength(str, len);
+			for (uint16_t pos = 0; pos < m_nCount; pos++)
+			{
+				char *slot = m_Slots[slotIndex(pos)];
+				if (m_bReplaceable[slotIndex(pos)] && strncmp(slot, str, keyLen) == 0 && (slot[keyLen] == ' ' || slot[keyLen] == '\0'))
+				{
+					memcpy(slot, str, len);
+					slot[len] = '\0';
+					#if defined(ENABLE_MESSAGE_SPOOL)
+						m_nQueuedMillis[slotIndex(pos)] = millis();
+					#endif
+					m_nCoalesced++;
+					return true;
+				}
+			}
+		}
+
+		if (isFull())
+		{
+			m_nDropped++;
+			return false;
+		}
+
+		uint16_t tail = slotIndex(m_nCount);
+		memcpy(m_Slots[tail], str, len);
+		m_Slots[tail][len] = '\0';
+		m_bReplaceable[tail] = replaceable;
+		#if defined(ENABLE_MESSAGE_SPOOL)
+			m_nQueuedMillis[tail] = millis();
+		#endif
+
+		m_nCount++;
+		if (m_nCount > m_nHighWater)
+		{
+			m_nHighWater = m_nCount;
+		}
+		return true;
+	}
+
+	bool MessageQueue::insert(uint16_t pos, const char *str, unsigned int len)
+	{
+		if (len >= Constants::MESSAGE_SLOT_SIZE || isFull() || pos > m_nCount)
+		{
+			m_nDropped++;
+			return false;
+		}
+
+		//make room at the head, then move the pos oldest messages into it
+		m_nHead = (m_nHead == 0 ? Constants::MESSAGE_QUEUE_SIZE : m_nHead) - 1;
+		m_nCount++;
+		for (uint16_t i = 0; i < pos; i++)
+		{
+			uint16_t to = slotIndex(i);
+			uint16_t from = slotIndex(i + 1);
+			memcpy(m_Slots[to], m_Slots[from], Constants::MESSAGE_SLOT_SIZE);
+			m_bReplaceable[to] = m_bReplaceable[from];
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				m_nQueuedMillis[to] = m_nQueuedMillis[from];
+			#endif
+		}
+
+		uint16_t slot = slotIndex(pos);
+		memcpy(m_Slots[slot], str, len);
+		m_Slots[slot][len] = '\0';
+		m_bReplaceable[slot] = false;
+		#if defined(ENABLE_MESSAGE_SPOOL)
+			m_nQueuedMillis[slot] = millis();
+		#endif
+
+		if (m_nCount > m_nHighWater)
+		{
+			m_nHighWater = m_nCount;
+		}
+		return true;
+	}
+
+	const char* MessageQueue::peek() const
+	{
+		return isEmpty() ? 0 : m_Slots[m_nHead];
+	}
+
+	const char* MessageQueue::peek(uint16_t pos) const
+	{
+		return pos >= m_nCount ? 0 : m_Slots[slotIndex(pos)];
+	}
+
+#if defined(ENABLE_MESSAGE_SPOOL)
+	unsigned long MessageQueue::getQueuedMillis(uint16_t pos) const
+	{
+		return pos >= m_nCount ? 0 : m_nQueuedMillis[slotIndex(pos)];
+	}
+#endif
+
+	void MessageQueue::pop()
+	{
+		if (isEmpty())
+		{
+			return;
+		}
+
+		m_nHead++;
+		if (m_nHead >= Constants::MESSAGE_QUEUE_SIZE)
+		{
+			m_nHead = 0;
+		}
+		m_nCount--;
+	}
+
+	void MessageQueue::clear()
+	{
+		m_nHead = 0;
+		m_nCount = 0;
+	}
+}
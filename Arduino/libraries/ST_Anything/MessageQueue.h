@@ -0,0 +1,102 @@
+//******************************************************************************************
+//  File: MessageQueue.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MessageQueue is a fixed size ring buffer of fixed length message slots used by
+//			  st::Everything to hold the strings queued for transfer to the SmartThings/Hubitat hub.
+//			  All storage is allocated once at compile time (see MESSAGE_QUEUE_SIZE and
+//			  MESSAGE_SLOT_SIZE in Constants.h), so queueing and sending a message never touches
+//			  the heap.  push() and pop() are both O(1).
+//
+//			  The queue also keeps track of how many messages had to be dropped (queue full or
+//			  message too long for a slot) and the highest number of messages ever waiting at once,
+//			  which is helpful when deciding how large MESSAGE_QUEUE_SIZE needs to be for a sketch.
+//
+//			  Messages pushed as "replaceable" (periodic sensor readings) are coalesced:  if a
+//			  replaceable message with the same key (the text before the first space, e.g.
+//			  "temperature1") is still waiting to be sent, it is overwritten in place with the newer
+//			  value instead of taking another slot.  Non-replaceable messages (events such as
+//			  "button1 pushed" or "contact1 open") are never merged or overwritten.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation - replaces the '|' delimited Return_String
+//    2026-10-18  agent          Added latest-value-wins coalescing of replaceable messages
+//    2026-10-18  agent          Remembers when each message was queued, if ENABLE_MESSAGE_SPOOL is defined (see MessageSpool.h)
+//    2026-10-18  agent          Added insert() - puts a message the communication method handed back ahead of the newer ones
+//    2026-10-18  agent          16 bit positions and counts, so a queue may have more than 255 slots
+//
+//
+//******************************************************************************************
+
+#ifndef ST_MESSAGEQUEUE_H
+#define ST_MESSAGEQUEUE_H
+
+#include <Arduino.h>
+#include "Constants.h"
+
+namespace st
+{
+	class MessageQueue
+	{
+		private:
+			char m_Slots[Constants::MESSAGE_QUEUE_SIZE][Constants::MESSAGE_SLOT_SIZE];	//message storage (each slot is null terminated)
+			bool m_bReplaceable[Constants::MESSAGE_QUEUE_SIZE];	//true if the message in the slot may be overwritten by a newer value with the same key
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				unsigned long m_nQueuedMillis[Constants::MESSAGE_QUEUE_SIZE];	//millis() when the message in the slot was queued (the capture time kept by the spool)
+			#endif
+			uint16_t m_nHead;		//index of the oldest queued message
+			uint16_t m_nCount;		//number of messages currently queued
+			uint16_t m_nHighWater;	//highest value m_nCount has ever reached
+			unsigned long m_nDropped;	//number of messages rejected because the queue was full or the message was too long
+			unsigned long m_nCoalesced;	//number of messages that overwrote an older, unsent value instead of taking a new slot
+
+			uint16_t slotIndex(uint16_t pos) const;	//converts a position relative to the head into a slot index
+			static unsigned int keyLength(const char *str, unsigned int len);	//length of the key (text before the first space)
+
+		public:
+			//constructor
+			MessageQueue();
+
+			//adds a message to the tail of the queue - returns false (and counts a drop) if it does not fit
+			//if replaceable is true, an unsent replaceable message with the same key is overwritten in place instead
+			bool push(const char *str, unsigned int len, bool replaceable=false);
+			bool push(const String &str, bool replaceable=false) { return push(str.c_str(), str.length(), replaceable); }
+
+			//adds a (non-replaceable) message at position pos (0 = ahead of every queued message) - returns false
+			//(and counts a drop) if it does not fit.  Moves the pos messages ahead of it, so pos should be small.
+			bool insert(uint16_t pos, const char *str, unsigned int len);
+
+			//returns the oldest message in the queue (null terminated), or 0 if the queue is empty
+			const char* peek() const;
+
+			//returns the message at position pos (0 = oldest), or 0 if there are not that many messages queued
+			const char* peek(uint16_t pos) const;
+
+			#if defined(ENABLE_MESSAGE_SPOOL)
+				//returns the millis() value at which the message at position pos was queued (or last overwritten by a newer value)
+				unsigned long getQueuedMillis(uint16_t pos) const;
+			#endif
+
+			//removes the oldest message from the queue
+			void pop();
+
+			//removes all messages from the queue
+			void clear();
+
+			//gets
+			inline uint16_t count() const { return m_nCount; }
+			inline bool isEmpty() const { return m_nCount == 0; }
+			inline bool isFull() const { return m_nCount >= Constants::MESSAGE_QUEUE_SIZE; }
+			inline uint16_t capacity() const { return Constants::MESSAGE_QUEUE_SIZE; }
+			inline uint16_t getHighWaterMark() const { return m_nHighWater; }
+			inline unsigned long getDropCount() const { return m_nDropped; }
+			inline unsigned long getCoalescedCount() const { return m_nCoalesced; }
+	};
+}
+
+#endif
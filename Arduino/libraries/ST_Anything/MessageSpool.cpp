@@ -0,0 +1,625 @@
+//******************************************************************************************
+//  File: MessageSpool.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MessageSpool keeps the messages st::Everything could not send while the
+//			  communication method's link to the network was down in non-volatile storage (a log
+//			  file on LittleFS on the ESP8266/ESP32, a ring of slots in EEPROM on AVR), to be sent
+//			  once the link is back.  See MessageSpool.h.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include "MessageSpool.h"
+
+#if defined(ENABLE_MESSAGE_SPOOL)
+
+namespace st
+{
+#if defined(ST_SPOOL_LITTLEFS)
+
+	//Log file entries:
+	//	'D' <boot> <millis, 4 bytes> <length> <message, length bytes>	- a message
+	//	'S'																- the oldest message not marked yet has been sent
+	static const char SPOOL_FILE[] = "/st_spool.log";
+	static const char SPOOL_TEMP_FILE[] = "/st_spool.tmp";
+	static const unsigned int ENTRY_HEADER = 7;
+
+	static unsigned long entrySize(const MessageSpool::Record &record)
+	{
+		return ENTRY_HEADER + strlen(record.message);
+	}
+
+	static bool writeEntry(File &file, const MessageSpool::Record &record, byte boot)
+	{
+		byte length = strlen(record.message);
+		uint32_t captured = record.capturedMillis;
+		byte header[ENTRY_HEADER];
+		header[0] = 'D';
+		header[1] = boot;
+		memcpy(header + 2, &captured, 4);
+		header[6] = length;
+		return file.write(header, ENTRY_HEADER) == ENTRY_HEADER && file.write((const uint8_t*)record.message, length) == length;
+	}
+
+//private
+	char MessageSpool::readEntry(File &file, Record &record, byte &boot)
+	{
+		byte header[ENTRY_HEADER];
+		if (file.read(header, 1) != 1)
+		{
+			return 0;
+		}
+		if (header[0] == 'S')
+		{
+			return 'S';
+		}
+		if (header[0] != 'D' || file.read(header + 1, ENTRY_HEADER - 1) != ENTRY_HEADER - 1 || header[6] >= Constants::MESSAGE_SLOT_SIZE)
+		{
+			return 0;
+		}
+		byte length = header[6];
+		if (file.read((uint8_t*)record.message, length) != length)
+		{
+			return 0;
+		}
+		record.message[length] = '\0';
+		uint32_t captured;
+		memcpy(&captured, header + 2, 4);
+		record.capturedMillis = captured;
+		boot = header[1];
+		return 'D';
+	}
+
+	//Rewrites the log with only the unsent messages.  If they (plus their 'sent' markers and room more bytes)
+	//do not fit in SPOOL_SIZE, the oldest are left out until a quarter of the spool is free, so a full spool
+	//is not copied again for every new message.
+	bool MessageSpool::compact(unsigned long room)
+	{
+		File log = LittleFS.open(SPOOL_FILE, "r");
+		if (!log)
+		{
+			return false;
+		}
+
+		//total size of the unsent messages, and how many of the oldest to leave out
+		Record record;
+		byte boot;
+		unsigned long bytes = 0;
+		log.seek(m_nReadPos);
+		for (unsigned int i = 0; i < m_nCount; )
+		{
+			char entry = readEntry(log, record, boot);
+			if (entry == 0)
+			{
+				break;
+			}
+			if (entry == 'D')
+			{
+				bytes += entrySize(record);
+				i++;
+			}
+		}
+		unsigned int drop = 0;
+		if (bytes + m_nCount + room > Constants::SPOOL_SIZE)
+		{
+			log.seek(m_nReadPos);
+			while (drop < m_nCount && bytes + (m_nCount - drop) + room > Constants::SPOOL_SIZE - Constants::SPOOL_SIZE / 4)
+			{
+				char entry = readEntry(log, record, boot);
+				if (entry == 0)
+				{
+					break;
+				}
+				if (entry == 'D')
+				{
+					bytes -= entrySize(record);
+					drop++;
+				}
+			}
+		}
+		else
+		{
+			log.seek(m_nReadPos);
+		}
+
+		//copy the rest
+		File temp = LittleFS.open(SPOOL_TEMP_FILE, "w");
+		if (!temp)
+		{
+			log.close();
+			return false;
+		}
+		unsigned int kept = 0;
+		unsigned long size = 0;
+		char entry;
+		while (drop + kept < m_nCount && (entry = readEntry(log, record, boot)) != 0)
+		{
+			if (entry == 'D')
+			{
+				if (!writeEntry(temp, record, boot))
+				{
+					break;
+				}
+				size += entrySize(record);
+				kept++;
+			}
+		}
+		log.close();
+		temp.close();
+
+		LittleFS.remove(SPOOL_FILE);
+		if (kept == 0)
+		{
+			LittleFS.remove(SPOOL_TEMP_FILE);
+			size = 0;
+		}
+		else if (!LittleFS.rename(SPOOL_TEMP_FILE, SPOOL_FILE))
+		{
+			kept = 0;
+			size = 0;
+		}
+
+		m_nDropped += m_nCount - kept;
+		m_nCount = kept;
+		m_nReadPos = 0;
+		m_nFileSize = size;
+		m_bPeeked = false;
+		return true;
+	}
+
+//public
+	//constructor
+	MessageSpool::MessageSpool() :
+		m_nCount(0),
+		m_nBoot(0),
+		m_bReady(false),
+		m_bPeeked(false),
+		m_nSpooled(0),
+		m_nReplayed(0),
+		m_nDropped(0),
+		m_nReadPos(0),
+		m_nNextPos(0),
+		m_nFileSize(0)
+	{
+
+	}
+
+	bool MessageSpool::begin()
+	{
+		#if defined(BOARD_ESP32)
+			m_bReady = LittleFS.begin(true);	//formats the partition the first time
+		#else
+			m_bReady = LittleFS.begin();
+		#endif
+		if (!m_bReady || !LittleFS.exists(SPOOL_FILE))
+		{
+			return m_bReady;
+		}
+
+		File log = LittleFS.open(SPOOL_FILE, "r");
+		if (!log)
+		{
+			return true;
+		}
+
+		//count the messages and the 'sent' markers - the file ends at the first damaged entry (power lost while appending)
+		Record record;
+		byte boot;
+		unsigned int messages = 0;
+		unsigned int sent = 0;
+		unsigned long end = 0;
+		char entry;
+		while ((entry = readEntry(log, record, boot)) != 0)
+		{
+			if (entry == 'D')
+			{
+				messages++;
+				m_nBoot = boot + 1;
+			}
+			else if (sent < messages)
+			{
+				sent++;
+			}
+			end = log.position();
+		}
+		bool damaged = (end != log.size());
+
+		//the oldest unsent message is the one after the first "sent" messages
+		log.seek(0);
+		for (unsigned int i = 0; i < sent; )
+		{
+			entry = readEntry(log, record, boot);
+			if (entry == 0)
+			{
+				break;
+			}
+			if (entry == 'D')
+			{
+				i++;
+			}
+		}
+		m_nReadPos = log.position();
+		m_nFileSize = end;
+		m_nCount = messages - sent;
+		log.close();
+
+		if (m_nCount == 0)
+		{
+			LittleFS.remove(SPOOL_FILE);
+			m_nReadPos = 0;
+			m_nFileSize = 0;
+		}
+		else if (damaged)
+		{
+			compact(0);		//appending after the damaged entry would hide everything that follows it
+		}
+		return true;
+	}
+
+	bool MessageSpool::push(const char *str, unsigned int len, unsigned long capturedMillis)
+	{
+		if (!m_bReady || len >= Constants::MESSAGE_SLOT_SIZE)
+		{
+			m_nDropped++;
+			return false;
+		}
+
+		Record record;
+		memcpy(record.message, str, len);
+		record.message[len] = '\0';
+		record.capturedMillis = capturedMillis;
+
+		//room for the message and for the 'sent' markers of every message in the file
+		unsigned long size = entrySize(record);
+		if (m_nFileSize + size + m_nCount + 1 > Constants::SPOOL_SIZE && !compact(size + 1))
+		{
+			m_nDropped++;
+			return false;
+		}
+
+		File log = LittleFS.open(SPOOL_FILE, "a");
+		if (!log)
+		{
+			m_nDropped++;
+			return false;
+		}
+		bool written = writeEntry(log, record, m_nBoot);
+		m_nFileSize = log.size();
+		log.close();
+		if (!written)
+		{
+			m_nDropped++;
+			if (m_nCount > 0)
+			{
+				compact(0);		//removes the partly written entry
+			}
+			else
+			{
+				LittleFS.remove(SPOOL_FILE);
+				m_nFileSize = 0;
+			}
+			return false;
+		}
+
+		m_nCount++;
+		m_nSpooled++;
+		return true;
+	}
+
+	bool MessageSpool::peek(Record &record)
+	{
+		if (m_nCount == 0)
+		{
+			return false;
+		}
+
+		if (!m_bPeeked)
+		{
+			File log = LittleFS.open(SPOOL_FILE, "r");
+			if (!log)
+			{
+				return false;
+			}
+			log.seek(m_nReadPos);
+			byte boot;
+			char entry;
+			do
+			{
+				m_nReadPos = log.position();
+				entry = readEntry(log, m_Peeked, boot);
+			} while (entry == 'S');
+			m_nNextPos = log.position();
+			log.close();
+
+			if (entry != 'D')
+			{
+				m_nDropped += m_nCount;		//the file has been damaged since begin() - nothing more can be read from it
+				m_nCount = 0;
+				LittleFS.remove(SPOOL_FILE);
+				m_nReadPos = 0;
+				m_nFileSize = 0;
+				return false;
+			}
+			m_Peeked.thisBoot = (boot == m_nBoot);
+			m_bPeeked = true;
+		}
+
+		record = m_Peeked;
+		return true;
+	}
+
+	void MessageSpool::pop()
+	{
+		Record record;
+		if (!peek(record))
+		{
+			return;
+		}
+
+		m_bPeeked = false;
+		m_nCount--;
+		m_nReplayed++;
+
+		if (m_nCount == 0)
+		{
+			LittleFS.remove(SPOOL_FILE);	//everything has been sent - start again with an empty file
+			m_nReadPos = 0;
+			m_nFileSize = 0;
+			return;
+		}
+
+		File log = LittleFS.open(SPOOL_FILE, "a");
+		if (log)
+		{
+			log.write((uint8_t)'S');
+			m_nFileSize = log.size();
+			log.close();
+		}
+		m_nReadPos = m_nNextPos;
+	}
+
+	unsigned int MessageSpool::capacity() const
+	{
+		return Constants::SPOOL_SIZE / (ENTRY_HEADER + Constants::MESSAGE_SLOT_SIZE);	//longest messages, plus their 'sent' markers
+	}
+
+#elif defined(ST_SPOOL_EEPROM)
+
+	//EEPROM slot layout:
+	//	<state> <sequence number, 2 bytes> <boot> <millis, 4 bytes> <length> <checksum> <message, up to MESSAGE_SLOT_SIZE-1 bytes>
+	static const byte SLOT_EMPTY = 0xFF;	//erased EEPROM, or a slot being written
+	static const byte SLOT_VALID = 0xA5;	//an unsent message
+	static const byte SLOT_SENT = 0x00;		//a message that has been sent
+	static const unsigned int SLOT_SEQ = 1;
+	static const unsigned int SLOT_BOOT = 3;
+	static const unsigned int SLOT_MILLIS = 4;
+	static const unsigned int SLOT_LENGTH = 8;
+	static const unsigned int SLOT_CHECKSUM = 9;
+	static const unsigned int SLOT_MESSAGE = 10;
+	static const unsigned int SLOT_SIZE = SLOT_MESSAGE + Constants::MESSAGE_SLOT_SIZE - 1;
+	static const unsigned int SLOT_COUNT = Constants::SPOOL_SIZE / SLOT_SIZE;
+	static_assert(SLOT_COUNT >= 2, "ST_SPOOL_SIZE is too small - the EEPROM spool needs room for at least two messages");
+
+	//covers everything but the state byte, which changes when the message is sent
+	static byte checksum(uint16_t seq, byte boot, uint32_t captured, const char *message, byte length)
+	{
+		byte sum = 0x5A;
+		const byte *data[] = { (const byte*)&seq, &boot, (const byte*)&captured, &length, (const byte*)message };
+		const byte sizes[] = { 2, 1, 4, 1, length };
+		for (byte i = 0; i < 5; i++)
+		{
+			for (byte j = 0; j < sizes[i]; j++)
+			{
+				sum = (sum << 1 | sum >> 7) ^ data[i][j];
+			}
+		}
+		return sum;
+	}
+
+//private
+	unsigned int MessageSpool::slotAddress(unsigned int slot)
+	{
+		return Constants::SPOOL_EEPROM_ADDRESS + slot * SLOT_SIZE;
+	}
+
+	void MessageSpool::writeBytes(unsigned int address, const void *data, unsigned int length)
+	{
+		for (unsigned int i = 0; i < length; i++)
+		{
+			EEPROM.update(address + i, ((const byte*)data)[i]);		//only writes the bytes that change
+		}
+	}
+
+	void MessageSpool::readBytes(unsigned int address, void *data, unsigned int length)
+	{
+		for (unsigned int i = 0; i < length; i++)
+		{
+			((byte*)data)[i] = EEPROM.read(address + i);
+		}
+	}
+
+	byte MessageSpool::readSlot(unsigned int slot, Record &record, uint16_t &seq, byte &boot)
+	{
+		unsigned int address = slotAddress(slot);
+		byte state = EEPROM.read(address);
+		if (state != SLOT_VALID && state != SLOT_SENT)
+		{
+			return SLOT_EMPTY;
+		}
+
+		uint32_t captured;
+		byte length;
+		readBytes(address + SLOT_SEQ, &seq, 2);
+		boot = EEPROM.read(address + SLOT_BOOT);
+		readBytes(address + SLOT_MILLIS, &captured, 4);
+		length = EEPROM.read(address + SLOT_LENGTH);
+		if (length >= Constants::MESSAGE_SLOT_SIZE)
+		{
+			return SLOT_EMPTY;
+		}
+		readBytes(address + SLOT_MESSAGE, record.message, length);
+		record.message[length] = '\0';
+		record.capturedMillis = captured;
+		if (EEPROM.read(address + SLOT_CHECKSUM) != checksum(seq, boot, captured, record.message, length))
+		{
+			return SLOT_EMPTY;		//never written by the spool, or the power failed while writing it
+		}
+		return state;
+	}
+
+//public
+	//constructor
+	MessageSpool::MessageSpool() :
+		m_nCount(0),
+		m_nBoot(0),
+		m_bReady(false),
+		m_bPeeked(false),
+		m_nSpooled(0),
+		m_nReplayed(0),
+		m_nDropped(0),
+		m_nHead(0),
+		m_nTail(0),
+		m_nSeq(0)
+	{
+
+	}
+
+	bool MessageSpool::begin()
+	{
+		m_bReady = (Constants::SPOOL_EEPROM_ADDRESS + SLOT_COUNT * SLOT_SIZE <= EEPROM.length());
+		if (!m_bReady)
+		{
+			return false;
+		}
+
+		//the newest slot is the one whose successor is empty or does not continue its sequence numbers
+		Record record;
+		uint16_t seq;
+		uint16_t nextSeq;
+		byte boot;
+		byte nextBoot;
+		for (unsigned int slot = 0; slot < SLOT_COUNT; slot++)
+		{
+			if (readSlot(slot, record, seq, boot) == SLOT_EMPTY)
+			{
+				continue;
+			}
+			unsigned int next = (slot + 1 == SLOT_COUNT) ? 0 : slot + 1;
+			if (readSlot(next, record, nextSeq, nextBoot) == SLOT_EMPTY || nextSeq != (uint16_t)(seq + 1))
+			{
+				m_nTail = next;
+				m_nSeq = seq + 1;
+				m_nBoot = boot + 1;
+				break;
+			}
+		}
+
+		//the unsent messages are the run of valid slots before the tail
+		m_nCount = 0;
+		m_nHead = m_nTail;
+		for (unsigned int i = 0; i < SLOT_COUNT; i++)
+		{
+			unsigned int slot = (m_nTail + SLOT_COUNT - 1 - i) % SLOT_COUNT;
+			if (readSlot(slot, record, seq, boot) != SLOT_VALID)
+			{
+				break;
+			}
+			m_nHead = slot;
+			m_nCount++;
+		}
+		return true;
+	}
+
+	bool MessageSpool::push(const char *str, unsigned int len, unsigned long capturedMillis)
+	{
+		if (!m_bReady || len >= Constants::MESSAGE_SLOT_SIZE)
+		{
+			m_nDropped++;
+			return false;
+		}
+
+		if (m_nCount == SLOT_COUNT)
+		{
+			//full - the tail has caught up with the oldest message, which is overwritten
+			m_nHead = (m_nHead + 1 == SLOT_COUNT) ? 0 : m_nHead + 1;
+			m_nCount--;
+			m_nDropped++;
+			m_bPeeked = false;
+		}
+
+		unsigned int address = slotAddress(m_nTail);
+		uint32_t captured = capturedMillis;
+		byte length = len;
+		EEPROM.update(address, SLOT_EMPTY);		//a slot half written when the power fails must not look like a message
+		writeBytes(address + SLOT_SEQ, &m_nSeq, 2);
+		EEPROM.update(address + SLOT_BOOT, m_nBoot);
+		writeBytes(address + SLOT_MILLIS, &captured, 4);
+		EEPROM.update(address + SLOT_LENGTH, length);
+		writeBytes(address + SLOT_MESSAGE, str, length);
+		EEPROM.update(address + SLOT_CHECKSUM, checksum(m_nSeq, m_nBoot, captured, str, length));
+		EEPROM.update(address, SLOT_VALID);
+
+		m_nTail = (m_nTail + 1 == SLOT_COUNT) ? 0 : m_nTail + 1;
+		m_nSeq++;
+		m_nCount++;
+		m_nSpooled++;
+		return true;
+	}
+
+	bool MessageSpool::peek(Record &record)
+	{
+		if (m_nCount == 0)
+		{
+			return false;
+		}
+
+		if (!m_bPeeked)
+		{
+			uint16_t seq;
+			byte boot;
+			if (readSlot(m_nHead, m_Peeked, seq, boot) != SLOT_VALID)
+			{
+				m_nDropped += m_nCount;		//the EEPROM has been changed behind the spool's back
+				m_nCount = 0;
+				return false;
+			}
+			m_Peeked.thisBoot = (boot == m_nBoot);
+			m_bPeeked = true;
+		}
+
+		record = m_Peeked;
+		return true;
+	}
+
+	void MessageSpool::pop()
+	{
+		if (m_nCount == 0)
+		{
+			return;
+		}
+
+		EEPROM.update(slotAddress(m_nHead), SLOT_SENT);
+		m_nHead = (m_nHead + 1 == SLOT_COUNT) ? 0 : m_nHead + 1;
+		m_nCount--;
+		m_nReplayed++;
+		m_bPeeked = false;
+	}
+
+	unsigned int MessageSpool::capacity() const
+	{
+		return SLOT_COUNT;
+	}
+
+#endif
+}
+
+#endif
@@ -0,0 +1,131 @@
+//******************************************************************************************
+//  File: MessageSpool.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MessageSpool keeps the messages st::Everything could not send while the
+//			  communication method's link to the network was down (SmartThings::isLinkUp()) in
+//			  non-volatile storage, together with the millis() value at which each was queued, so
+//			  the readings taken during a WiFi/Ethernet outage - or before a restart during one -
+//			  reach the hub once the link is back.  Enabled by ENABLE_MESSAGE_SPOOL in Constants.h.
+//
+//			  The spool is bounded (SPOOL_SIZE bytes, see Constants.h); when it is full, the oldest
+//			  messages are dropped to make room for new ones.  Writes are arranged to spread the
+//			  wear across the whole area and never rewrite anything that has not changed:
+//
+//			  ESP8266 / ESP32 - an append-only log file on LittleFS.  Each message is appended as
+//				one record, and each message sent is recorded by appending a one byte 'sent'
+//				marker - nothing already written is ever modified.  Once every message has been
+//				sent the file is deleted; if it reaches SPOOL_SIZE first, the unsent messages are
+//				copied into a new file (dropping the oldest quarter of the spool if needed).
+//
+//			  AVR (and the host simulation) - a ring of fixed size slots in EEPROM, starting at
+//				SPOOL_EEPROM_ADDRESS.  Slots are written in turn, so every slot is written once
+//				per trip around the ring, and only with EEPROM.update() (bytes that already hold
+//				the right value are not written).  Each slot starts with a state byte which is
+//				written last, and holds a checksum, so a slot half written when the power failed
+//				(or EEPROM the spool has never written) is ignored.  The
+//				position of the ring is not stored anywhere - begin() finds it from the sequence
+//				numbers in the slots - so no single byte is written on every message.
+//
+//			  The capture time of a message is only meaningful until the next restart (millis()
+//			  starts again at 0), so every record also holds a boot number, and peek() reports
+//			  whether a message was captured since the last restart.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef ST_MESSAGESPOOL_H
+#define ST_MESSAGESPOOL_H
+
+#include <Arduino.h>
+#include "Constants.h"
+
+#if defined(ENABLE_MESSAGE_SPOOL)
+
+#if defined(BOARD_ESP8266) || defined(BOARD_ESP32)
+	#define ST_SPOOL_LITTLEFS
+	#include <LittleFS.h>
+#elif defined(ARDUINO_ARCH_AVR) || defined(ST_HOSTSIM)
+	#define ST_SPOOL_EEPROM
+	#include <EEPROM.h>
+#else
+	#error "ENABLE_MESSAGE_SPOOL is only supported on the ESP8266, ESP32 and AVR boards"
+#endif
+
+namespace st
+{
+	class MessageSpool
+	{
+		public:
+			struct Record
+			{
+				char message[Constants::MESSAGE_SLOT_SIZE];	//null terminated
+				unsigned long capturedMillis;	//millis() when the message was queued
+				bool thisBoot;					//false if the message was captured before the last restart (capturedMillis is meaningless then)
+			};
+
+		private:
+			unsigned int m_nCount;			//messages waiting in the spool
+			byte m_nBoot;					//boot number stored with each message
+			bool m_bReady;					//true once begin() has found the storage
+			bool m_bPeeked;					//true while m_Peeked holds the oldest message
+			Record m_Peeked;
+			unsigned long m_nSpooled;		//messages written to the spool
+			unsigned long m_nReplayed;		//messages taken out of the spool with pop()
+			unsigned long m_nDropped;		//messages lost because the spool was full or could not be written
+
+			#if defined(ST_SPOOL_LITTLEFS)
+				unsigned long m_nReadPos;	//file offset of the oldest unsent message (or of the 'sent' markers in front of it)
+				unsigned long m_nNextPos;	//file offset just past the message in m_Peeked
+				unsigned long m_nFileSize;	//size of the log file
+
+				static char readEntry(File &file, Record &record, byte &boot);	//reads the entry at the file's position - returns 'D' (a message), 'S' (a 'sent' marker) or 0 (end of file, or a damaged entry)
+				bool compact(unsigned long room);	//copies the unsent messages into a new file, dropping the oldest if needed to leave room bytes free
+			#elif defined(ST_SPOOL_EEPROM)
+				unsigned int m_nHead;		//slot of the oldest unsent message
+				unsigned int m_nTail;		//slot the next message is written to
+				uint16_t m_nSeq;			//sequence number of the next message
+
+				static unsigned int slotAddress(unsigned int slot);
+				static void writeBytes(unsigned int address, const void *data, unsigned int length);
+				static void readBytes(unsigned int address, void *data, unsigned int length);
+				static byte readSlot(unsigned int slot, Record &record, uint16_t &seq, byte &boot);	//returns the slot's state - empty if its checksum does not match
+			#endif
+
+		public:
+			//constructor
+			MessageSpool();
+
+			//finds the messages left in the spool by the last run - call once, before the other functions
+			bool begin();
+
+			//adds a message to the spool - drops the oldest messages if the spool is full
+			bool push(const char *str, unsigned int len, unsigned long capturedMillis);
+
+			//reads the oldest message in the spool - returns false if the spool is empty
+			bool peek(Record &record);
+
+			//removes the oldest message from the spool (once it has been sent)
+			void pop();
+
+			//gets
+			inline unsigned int count() const { return m_nCount; }
+			inline bool isEmpty() const { return m_nCount == 0; }
+			inline unsigned long getSpooledCount() const { return m_nSpooled; }
+			inline unsigned long getReplayedCount() const { return m_nReplayed; }
+			inline unsigned long getDropCount() const { return m_nDropped; }
+			unsigned int capacity() const;	//messages the spool can always hold (the log file holds more if they are short)
+	};
+}
+
+#endif
+
+#endif
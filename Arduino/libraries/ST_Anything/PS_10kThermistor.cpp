@@ -127,7 +127,7 @@ namespace st
 			m_nSensorValue = Temp1C;
 		}
 		
-		Everything::sendSmartString(getName() + " " + String(m_nSensorValue));
+		Message(getNameF()).value(m_nSensorValue).sendReading();
 	}
 	void PS_10kThermistor::setPin(byte pin)
 	{
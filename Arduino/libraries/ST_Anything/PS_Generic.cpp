@@ -112,7 +112,7 @@ namespace st
 
 
     // Send the value to our parent which will then update the device handler
-		Everything::sendSmartString(getName() + " " + String(m_nSensorValue));
+		Message(getNameF()).value(m_nSensorValue).sendReading();
 	}
 	
 }
@@ -95,7 +95,7 @@ namespace st
 	{
 		int m_nSensorValue=map(analogRead(m_nAnalogInputPin), SENSOR_LOW, SENSOR_HIGH, MAPPED_LOW, MAPPED_HIGH);
 		
-		Everything::sendSmartString(getName() + " " + String(m_nSensorValue));
+		Message(getNameF()).value(m_nSensorValue).sendReading();
 	}
 	
 	void PS_Illuminance::setPin(byte pin)
@@ -85,7 +85,7 @@ namespace st
 	{
 		int m_nSensorValue=analogRead(m_nAnalogInputPin);
 		
-		Everything::sendSmartString(getName() + (m_nSensorValue < m_nSensorLimit ? F(" clear") : F(" detected")));
+		Message(getNameF()).value(m_nSensorValue < m_nSensorLimit ? F("clear") : F("detected")).send();
 
 		if (st::PollingSensor::debug)
 		{
@@ -128,7 +128,7 @@ namespace st
 
 		m_fApparentPower = (m_fFilterConstant * tempValue) + (1 - m_fFilterConstant) * m_fApparentPower;
 
-		Everything::sendSmartString(getName() + " " + String(m_fApparentPower));
+		Message(getNameF()).value(m_fApparentPower).sendReading();
 	}
 	
 	void PS_Power::setPin(byte pin)
@@ -39,6 +39,7 @@
 //    2021-06-14  Dan Ogorchock  Fixed for SAMD Architectures...again
 //    2023-01-25  Dan Ogorchock  Fixed for MKR 1010 (use PinStatus instead of int for inttype)
 //    2023-01-26  Dan Ogorchock  Fixed for SAMD Architecture boards versus all other boards
+//    2026-10-18  agent          Sends the per-interval count with send(), never sendReading() - a coalesced count would lose pulses
 //
 //
 //******************************************************************************************
@@ -140,7 +141,7 @@ void isrPulse() {
 			}
 		}
 
-		Everything::sendSmartString(getName() + " " + m_nSensorValue);
+		Message(getNameF()).value(m_nSensorValue).send();		//not sendReading() - the count is reset every poll, so a coalesced count would lose its pulses
 	}
 
 	void PS_PulseCounter::setPin(byte pin)
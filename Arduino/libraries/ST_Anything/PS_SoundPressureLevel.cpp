@@ -34,6 +34,8 @@
 //    Date        Who            What
 //    ----        ---            ----
 //    2019-07-08  Dan Ogorchock  Original Creation
+//    2026-10-18  agent          Ask st::Everything to keep calling update() every loop (needed by the high speed sampling)
+//    2026-10-18  agent          Sends the per-interval peak with send(), never sendReading() - a coalesced peak could hide a louder one
 //
 //
 //******************************************************************************************
@@ -63,6 +65,7 @@ namespace st
 		m_nHighSpeedPollingInterval(HighSpeedPollingInterval)
 	{
 		setPin(analogInputPin);
+		setUpdateEveryLoop(true);	//update() samples the input between polls
 	}
 	
 	//destructor
@@ -124,7 +127,7 @@ namespace st
 		update();
 
 		//transfer the data to the hub
-		Everything::sendSmartString(getName() + " " + String(m_fSensorValue));
+		Message(getNameF()).value(m_fSensorValue).send();		//not sendReading() - the peak is reset every poll, so a coalesced peak could hide a louder one
 		
 		//reset the max value
 		m_fSensorValue = -1.0;
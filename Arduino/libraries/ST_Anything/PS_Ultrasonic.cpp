@@ -94,7 +94,7 @@ namespace st
 		m_nSensorValue = duration*0.034/2;
 
 		// queue the distance to send to smartthings 
-		Everything::sendSmartString(getName() + " " + String(m_nSensorValue));
+		Message(getNameF()).value(m_nSensorValue).sendReading();
 	}
 	
 	void PS_Ultrasonic::setPin(byte &trigPin,byte &echoPin)
@@ -229,7 +229,7 @@ namespace st
 			m_fSensorValue = (m_fFilterConstant * tempValue) + (1 - m_fFilterConstant) * m_fSensorValue;
 		}
 		
-		Everything::sendSmartString(getName() + " " + String(m_fSensorValue));
+		Message(getNameF()).value(m_fSensorValue).sendReading();
 	}
 	
 	void PS_Voltage::setPin(byte pin)
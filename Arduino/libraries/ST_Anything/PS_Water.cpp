@@ -100,11 +100,11 @@ namespace st
 		//compare the sensor's value is against the limit to determine whether to send "dry" versus "wet".  
 		if (m_binvertLogic)
 		{
-			Everything::sendSmartString(getName() + (m_nSensorValue > m_nSensorLimit ? F(" dry") : F(" wet")));
+			Message(getNameF()).value(m_nSensorValue > m_nSensorLimit ? F("dry") : F("wet")).send();
 		}
 		else
 		{
-			Everything::sendSmartString(getName() + (m_nSensorValue < m_nSensorLimit ? F(" dry") : F(" wet")));
+			Message(getNameF()).value(m_nSensorValue < m_nSensorLimit ? F("dry") : F("wet")).send();
 		}
 	}
 	
@@ -17,6 +17,12 @@
 //    Date        Who            What
 //    ----        ---            ----
 //    2015-01-03  Dan & Daniel   Original Creation
+//    2026-10-18  agent          getData() is called through takeReading() so queued readings can be coalesced
+//    2026-10-18  agent          Replaced the accumulated m_nDeltaTime with an absolute deadline used by st::Everything's poll scheduler
+//    2026-10-18  agent          takeReading() measures how long getData() takes (used by Everything::autoPhase)
+//    2026-10-18  agent          getData() times are also recorded by st::Profiler if ENABLE_PROFILER is defined
+//    2026-10-18  agent          Readings are marked by the device (Message::sendReading()) instead of by takeReading()
+//    2026-10-18  agent          Offset OFFSET_AUTO (not 0) lets Everything::autoPhase choose the offset, so a sensor can be pinned to offset 0
 //
 //
 //******************************************************************************************
@@ -29,49 +35,47 @@
 namespace st
 {
 //private
-	bool PollingSensor::checkInterval()
+	void PollingSensor::schedule(unsigned long now)
 	{
-		//check for time overflow
-		if(millis()<m_nPreviousTime)
-		{
-			if (debug)
-			{
-				Serial.println(F("PollingSensor: millis() Overflow handled"));
-			}
-			
-			m_nPreviousTime = 0;
-		}
-		
-		if(m_nPreviousTime==0) //eliminates problem of there being a delay before first update() call
-		{
-			m_nPreviousTime=millis();
-		}
-		
-		//calculate new delta time
-		m_nDeltaTime+=(millis()-m_nPreviousTime)-m_nOffset;
-		m_nOffset=0;
-		m_nPreviousTime=millis();
-		
-		//determine interval has passed
-		if(m_nDeltaTime>=m_nInterval)
-		{
-			m_nDeltaTime=0;
-			return true;
-		}
-		else
+		m_nNextPoll = now + m_nInterval + m_nOffset;
+		m_nOffset = 0;
+	}
+
+	void PollingSensor::poll(unsigned long now)
+	{
+		//the deadline moves by exactly one interval, so the time spent in getData() and late run() passes do not accumulate as drift
+		m_nNextPoll += m_nInterval;
+		if (isDue(now))
 		{
-			return false;
+			//more than a whole interval late (e.g. a long blocking call) - skip the missed polls rather than running them back to back
+			m_nNextPoll = now + m_nInterval;
 		}
+
+		//the deadline is moved before getData() is called, so a getData() that calls update() does not poll again
+		takeReading();
+	}
+
+	void PollingSensor::takeReading()
+	{
+		unsigned long start = micros();
+		getData();
+		m_nReadingMicros = micros() - start;
+		#if defined(ENABLE_PROFILER)
+			Profiler::record(this, Profiler::GETDATA, m_nReadingMicros);
+		#endif
 	}
 
 //public
 	//constructor
 	PollingSensor::PollingSensor(const __FlashStringHelper *name, long interval, long offset):
 		Sensor(name),
-		m_nPreviousTime(0),
-		m_nDeltaTime(0),
+		m_nNextPoll(0),
 		m_nInterval(interval*1000),
-		m_nOffset(offset*1000)
+		m_nOffset(offset == OFFSET_AUTO ? 0 : offset*1000),
+		m_bAutoOffset(offset == OFFSET_AUTO),
+		m_bScheduled(false),
+		m_bUpdateEveryLoop(false),
+		m_nReadingMicros(0)
 	{
 	
 	}
@@ -84,30 +88,63 @@ namespace st
 
 	void PollingSensor::init()
 	{
-		getData();
+		takeReading();
 	}
 
 	void PollingSensor::refresh()
 	{
-		getData();
+		takeReading();
 	}
 
 	void PollingSensor::update()
 	{
-		if(checkInterval())
+		//a sensor added through Everything::addSensor(PollingSensor*) is polled by st::Everything's scheduler instead
+		if (m_bScheduled)
+		{
+			return;
+		}
+
+		unsigned long now = millis();
+		if (m_nNextPoll == 0)	//first update() call - start timing from now
+		{
+			schedule(now);
+		}
+		else if (isDue(now))
+		{
+			poll(now);
+		}
+	}
+
+	void PollingSensor::offset(long os)
+	{
+		if (!m_bScheduled && m_nNextPoll == 0)	//not timing yet - applied when the first deadline is set
+		{
+			m_nOffset = os;
+			m_bAutoOffset = false;	//the sketch has chosen
+			return;
+		}
+		m_nNextPoll += os;
+		Everything::reschedule(this);
+	}
+
+	void PollingSensor::setInterval(long interval)
+	{
+		if (m_bScheduled || m_nNextPoll != 0)
 		{
-			getData();
+			m_nNextPoll += interval - m_nInterval;	//keep the last poll as the reference point, as the old accumulated delta time did
 		}
+		m_nInterval = interval;
+		Everything::reschedule(this);
 	}
 	
 	void PollingSensor::getData()
 	{
 		if(debug)
 		{
-			Everything::sendSmartString(getName() + F(" triggered"));
+			Message(getNameF()).value(F("triggered")).send();
 		}
 	}
 	
 	//debug flag to determine if debug print statements are executed (set value in your sketch)
 	bool PollingSensor::debug=false;
-}
\ No newline at end of file
+}
\ No newline at end of file
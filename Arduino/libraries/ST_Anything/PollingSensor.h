@@ -11,12 +11,18 @@
 //				- String &name - REQUIRED - the name of the object - must match the Groovy ST_Anything DeviceType tile name
 //				- long interval - REQUIRED - the polling interval in seconds
 //				- long offset - REQUIRED - the polling interval offset in seconds - used to prevent all polling sensors from executing at the same time
+//				  (st::PollingSensor::OFFSET_AUTO lets st::Everything::autoPhase choose it)
 //
 //  Change History:
 //
 //    Date        Who            What
 //    ----        ---            ----
 //    2015-01-03  Dan & Daniel   Original Creation
+//    2026-10-18  agent          getData() is called through takeReading() so queued readings can be coalesced
+//    2026-10-18  agent          Replaced the accumulated m_nDeltaTime with an absolute deadline used by st::Everything's poll scheduler
+//    2026-10-18  agent          takeReading() measures how long getData() takes (used by Everything::autoPhase)
+//    2026-10-18  agent          Readings are marked by the device (Message::sendReading()) instead of by takeReading()
+//    2026-10-18  agent          Offset OFFSET_AUTO (not 0) lets Everything::autoPhase choose the offset, so a sensor can be pinned to offset 0
 //
 //
 //******************************************************************************************
@@ -31,14 +37,25 @@ namespace st
 	class PollingSensor: public Sensor
 	{
 		private:
-			unsigned long m_nPreviousTime; //in milliseconds - time of last poll
-			long m_nDeltaTime;			   //in milliseconds - elapsed time since last poll
+			unsigned long m_nNextPoll;	   //in milliseconds - millis() value at which the next poll is due
 			long m_nInterval;			   //in milliseconds - polling interval for the sensor
 			long m_nOffset;				   //in milliseconds - offset to prevent all Polling sensors from running at the same time
-			
-			virtual bool checkInterval(); //returns true and resets m_nDeltaTime if m_nInterval has been reached
+			bool m_bAutoOffset;			   //true if created with OFFSET_AUTO and st::Everything::planPhases() has not chosen the offset yet
+			bool m_bScheduled;			   //true once st::Everything's poll scheduler owns this sensor (update() then no longer polls)
+			bool m_bUpdateEveryLoop;	   //true if st::Everything must still call update() on every pass of run() (see setUpdateEveryLoop())
+			unsigned long m_nReadingMicros; //in microseconds - how long the last getData() call took
+
+			bool isDue(unsigned long now) const {return (int32_t)(uint32_t)(now - m_nNextPoll) >= 0;}	//wrap-safe (32 bit millis() arithmetic) - true once the deadline has been reached
+			void schedule(unsigned long now);	//sets the first deadline - now + interval + offset
+			void poll(unsigned long now);		//advances the deadline by one interval (no drift) and takes a reading
+
+		protected:
+			void takeReading();			  //calls getData() and measures how long it takes
+			void setUpdateEveryLoop(bool b) {m_bUpdateEveryLoop=b;}	//call from the constructor of a subclass that overrides update() to do work between polls
 			
 		public:
+			static const long OFFSET_AUTO = -1;	//pass as the offset to let st::Everything::autoPhase choose it (treated as 0 if autoPhase is off)
+
 			//constructor
 			PollingSensor(const __FlashStringHelper *name, long interval, long offset=0);
 			
@@ -58,17 +75,23 @@ namespace st
 			virtual void getData();
 			
 			//gets
-			virtual void offset(long os) {m_nOffset=os;} //offset the delta time from its current value
+			unsigned long getNextPoll() const {return m_nNextPoll;}	//millis() value at which the next poll is due
+			long getInterval() const {return m_nInterval;}			//in milliseconds
+			long getOffset() const {return m_nOffset;}				//in milliseconds - offset still to be applied to the first poll
+			unsigned long getReadingMicros() const {return m_nReadingMicros;}	//how long the last getData() call took
+			bool getUpdateEveryLoop() const {return m_bUpdateEveryLoop;}
 
 			//sets
-			virtual void setInterval(long interval) {m_nInterval=interval;}
+			virtual void offset(long os); //offset the next poll from its current deadline (in milliseconds)
+			virtual void setInterval(long interval); //in milliseconds - takes effect from the last poll, not from now
 	
 			//debug flag to determine if debug print statements are executed (set value in your sketch)
 			static bool debug;
 	
+			friend class Everything;	//st::Everything's poll scheduler calls schedule() and poll()
 	};
 }
 
 
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,235 @@
+//******************************************************************************************
+//  File: Profiler.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Profiler is a static class which records how long each Device spends in
+//			  update(), getData() and beSmart(), as log2 histograms with max watermarks.  It is
+//			  only compiled in if ENABLE_PROFILER is defined in Constants.h.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          16 bit device count
+//
+//
+//******************************************************************************************
+
+#include "Profiler.h"
+
+#if defined(ENABLE_PROFILER)
+
+#include "Everything.h"
+
+namespace st
+{
+//Histogram
+	void Profiler::Histogram::add(unsigned long us)
+	{
+		if (us > maxMicros)
+		{
+			maxMicros = us;
+		}
+
+		byte bucket = 0;
+		while (us > 1 && bucket < BUCKET_COUNT - 1)
+		{
+			us >>= 1;
+			bucket++;
+		}
+
+		if (buckets[bucket] == 0xFFFF)
+		{
+			for (byte i = 0; i < BUCKET_COUNT; i++)
+			{
+				buckets[i] >>= 1;
+			}
+		}
+		buckets[bucket]++;
+	}
+
+	void Profiler::Histogram::clear()
+	{
+		memset(buckets, 0, sizeof(buckets));
+		maxMicros = 0;
+	}
+
+	unsigned long Profiler::Histogram::count() const
+	{
+		unsigned long total = 0;
+		for (byte i = 0; i < BUCKET_COUNT; i++)
+		{
+			total += buckets[i];
+		}
+		return total;
+	}
+
+	unsigned long Profiler::Histogram::percentile(byte pct) const
+	{
+		unsigned long target = (count() * pct + 99) / 100;
+		unsigned long total = 0;
+		for (byte i = 0; i < BUCKET_COUNT; i++)
+		{
+			total += buckets[i];
+			if (total >= target && total > 0)
+			{
+				return i < BUCKET_COUNT - 1 ? (2UL << i) - 1 : maxMicros;
+			}
+		}
+		return 0;
+	}
+
+//private
+	void Profiler::printHistogram(const __FlashStringHelper *name, const __FlashStringHelper *function, const Histogram &h)
+	{
+		unsigned long n = h.count();
+		if (n == 0)
+		{
+			return;
+		}
+		Serial.print(F("Profiler: "));
+		Serial.print(name);
+		Serial.print(F("."));
+		Serial.print(function);
+		Serial.print(F(" n="));
+		Serial.print(n);
+		Serial.print(F(" p50<="));
+		Serial.print(h.percentile(50));
+		Serial.print(F("us p99<="));
+		Serial.print(h.percentile(99));
+		Serial.print(F("us max="));
+		Serial.print(h.maxMicros);
+		Serial.print(F("us  |"));
+		for (byte i = 0; i < BUCKET_COUNT; i++)
+		{
+			Serial.print(F(" "));
+			Serial.print(h.buckets[i]);
+		}
+		Serial.println();
+	}
+
+//public
+	bool Profiler::attach(Device *device)
+	{
+		if (m_nDeviceCount >= Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT)
+		{
+			return false;
+		}
+		device->m_nProfileSlot = m_nDeviceCount;
+		m_Devices[m_nDeviceCount] = device;
+		for (byte c = 0; c < CATEGORY_COUNT; c++)
+		{
+			m_Histograms[m_nDeviceCount][c].clear();
+		}
+		m_nDeviceCount++;
+		return true;
+	}
+
+	void Profiler::record(const Device *device, Category category, unsigned long us)
+	{
+		uint16_t slot = device->m_nProfileSlot;
+		if (slot >= m_nDeviceCount)
+		{
+			return;
+		}
+		m_Histograms[slot][category].add(us);
+	}
+
+	void Profiler::reset()
+	{
+		for (uint16_t i = 0; i < m_nDeviceCount; i++)
+		{
+			for (byte c = 0; c < CATEGORY_COUNT; c++)
+			{
+				m_Histograms[i][c].clear();
+			}
+		}
+		m_Send.clear();
+		m_Loop.clear();
+	}
+
+	void Profiler::printReport()
+	{
+		Serial.println(F("Profiler: name.function n p50 p99 max | log2 buckets (1us, 2us, 4us, ...)"));
+		printHistogram(F("Everything"), F("run"), m_Loop);
+		printHistogram(F("SmartThings"), F("send"), m_Send);
+		for (uint16_t i = 0; i < m_nDeviceCount; i++)
+		{
+			printHistogram(m_Devices[i]->getNameF(), F("update"), m_Histograms[i][UPDATE]);
+			printHistogram(m_Devices[i]->getNameF(), F("getData"), m_Histograms[i][GETDATA]);
+			printHistogram(m_Devices[i]->getNameF(), F("beSmart"), m_Histograms[i][BESMART]);
+		}
+	}
+
+	void Profiler::sendSummary()
+	{
+		//find the slowest single call of any Device
+		uint16_t worstDevice = 0;
+		byte worstCategory = UPDATE;
+		unsigned long worst = 0;
+		for (uint16_t i = 0; i < m_nDeviceCount; i++)
+		{
+			for (byte c = 0; c < CATEGORY_COUNT; c++)
+			{
+				if (m_Histograms[i][c].maxMicros > worst)
+				{
+					worst = m_Histograms[i][c].maxMicros;
+					worstDevice = i;
+					worstCategory = c;
+				}
+			}
+		}
+
+		Serial.print(F("Profiler: slowest call = "));
+		if (worst > 0)
+		{
+			Serial.print(m_Devices[worstDevice]->getNameF());
+			Serial.print(F("."));
+			Serial.print(worstCategory == UPDATE ? F("update") : worstCategory == GETDATA ? F("getData") : F("beSmart"));
+			Serial.print(F(" "));
+			Serial.print(worst);
+			Serial.print(F("us"));
+		}
+		Serial.print(F(", longest run() = "));
+		Serial.print(m_Loop.maxMicros);
+		Serial.println(F("us"));
+
+		//one token after the name, so the hub keeps it as a single attribute value - short enough for the UNO's message slots
+		Message msg(F("profile"));
+		msg.print(' ');
+		if (worst > 0)
+		{
+			msg.print(m_Devices[worstDevice]->getNameF());
+			msg.print(':');
+			msg.print(worst);
+		}
+		else
+		{
+			msg.print(F("loop:"));
+			msg.print(m_Loop.maxMicros);
+		}
+		msg.send();
+	}
+
+	void Profiler::run()
+	{
+		if (millis() - m_nLastReport >= long(Constants::PROFILER_REPORT_INTERVAL) * 1000)
+		{
+			m_nLastReport = millis();
+			sendSummary();
+		}
+	}
+
+	//initialize static members
+	Device* Profiler::m_Devices[Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT];
+	Profiler::Histogram Profiler::m_Histograms[Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT][Profiler::CATEGORY_COUNT];
+	Profiler::Histogram Profiler::m_Send;
+	Profiler::Histogram Profiler::m_Loop;
+	uint16_t Profiler::m_nDeviceCount=0;
+	unsigned long Profiler::m_nLastReport=0;
+}
+
+#endif
@@ -0,0 +1,107 @@
+//******************************************************************************************
+//  File: Profiler.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Profiler is a static class which records how long (in micros()) each Device
+//			  spends in update(), getData() and beSmart(), how long the SmartThings object takes to
+//			  send() to the hub, and how long each pass through Everything::run() takes.  It is
+//			  only compiled in if ENABLE_PROFILER is defined in Constants.h.
+//
+//			  Every measurement is counted in a log2 histogram (bucket n holds times from 2^n to
+//			  2^(n+1)-1 microseconds, the last bucket holds everything longer) and the longest
+//			  time ever seen is kept as a watermark.  This makes it easy to find the Device that is
+//			  stalling loop() - e.g. a PS_Ultrasonic waiting in pulseIn(), or a DS18B20 conversion.
+//
+//			  The results can be seen by:
+//				- typing "profile" in the Serial Monitor (requires ENABLE_SERIAL) or sending it from
+//				  the hub - prints the full table to Serial and sends a summary to the hub
+//				- "profile reset" - clears all of the statistics
+//				- every PROFILER_REPORT_INTERVAL seconds a one line summary is printed to Serial and
+//				  the slowest Device is sent to the hub as "profile <device name>:<max microseconds>"
+//
+//			  RAM cost is about 36 bytes per histogram, 3 histograms per Device - keep this in mind
+//			  on the UNO and MEGA.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          16 bit device count
+//
+//
+//******************************************************************************************
+
+#ifndef ST_PROFILER_H
+#define ST_PROFILER_H
+
+#include "Constants.h"
+
+#if defined(ENABLE_PROFILER)
+
+#include "Device.h"
+
+namespace st
+{
+	class Profiler
+	{
+		public:
+			enum Category
+			{
+				UPDATE,
+				GETDATA,
+				BESMART,
+				CATEGORY_COUNT
+			};
+
+			static const byte BUCKET_COUNT = 16;	//last bucket is >= 2^15 us (~33ms)
+
+			class Histogram
+			{
+				public:
+					uint16_t buckets[BUCKET_COUNT];	//counts - all are halved if one would overflow, so the shape is kept
+					unsigned long maxMicros;		//longest time ever seen (watermark)
+
+					void add(unsigned long us);
+					void clear();
+					unsigned long count() const;
+					unsigned long percentile(byte pct) const;	//upper bound of the bucket holding the pct'th percentile
+			};
+
+			//called by st::Everything as Devices are added - returns false if the Device could not be given a slot
+			static bool attach(Device *device);
+
+			//records one measurement
+			static void record(const Device *device, Category category, unsigned long us);
+			static void recordSend(unsigned long us) {m_Send.add(us);}
+			static void recordLoop(unsigned long us) {m_Loop.add(us);}
+
+			//clears every histogram
+			static void reset();
+
+			//prints one line per Device and function to Serial
+			static void printReport();
+
+			//queues the one line summary for the hub (and prints it to Serial)
+			static void sendSummary();
+
+			//called from Everything::run() - sends the summary every PROFILER_REPORT_INTERVAL seconds
+			static void run();
+
+		private:
+			static Device* m_Devices[Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT];
+			static Histogram m_Histograms[Constants::MAX_SENSOR_COUNT + Constants::MAX_EXECUTOR_COUNT][CATEGORY_COUNT];
+			static Histogram m_Send;	//SmartThings object send()/sendBatch()
+			static Histogram m_Loop;	//whole pass through Everything::run()
+			static uint16_t m_nDeviceCount;
+			static unsigned long m_nLastReport;
+
+			static void printHistogram(const __FlashStringHelper *name, const __FlashStringHelper *function, const Histogram &h);
+	};
+}
+
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+//******************************************************************************************
+//  File: Registry.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::RegistryBase is the part of st::Registry<...> that does not depend on the device
+//			  types - the sorted name index and lookups used by st::Everything.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include "Registry.h"
+#include "Everything.h"
+
+namespace st
+{
+//protected
+	RegistryBase::RegistryBase(Device **index, unsigned int count):
+		m_pIndex(index),
+		m_nCount(count)
+	{
+	}
+
+	void RegistryBase::sortIndex()
+	{
+		//insertion sort - runs once, when the registry is constructed
+		for (unsigned int i = 1; i < m_nCount; i++)
+		{
+			Device *device = m_pIndex[i];
+			unsigned int index = i;
+			while (index > 0 && Device::compareNames(m_pIndex[index - 1], device) > 0)
+			{
+				m_pIndex[index] = m_pIndex[index - 1];
+				--index;
+			}
+			m_pIndex[index] = device;
+		}
+	}
+
+//public
+	Device* RegistryBase::getDeviceByName(const char *name, unsigned int len) const
+	{
+		unsigned int low = 0;
+		unsigned int high = m_nCount;
+		while (low < high)
+		{
+			unsigned int mid = (low + high) / 2;
+			if (m_pIndex[mid]->compareName(name, len) > 0)
+			{
+				low = mid + 1;
+			}
+			else
+			{
+				high = mid;
+			}
+		}
+
+		if (low < m_nCount && m_pIndex[low]->compareName(name, len) == 0)
+		{
+			return m_pIndex[low];
+		}
+		return 0;
+	}
+
+	void RegistryBase::flushStrings()
+	{
+		Everything::flushStrings();
+	}
+}
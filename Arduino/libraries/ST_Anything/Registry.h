@@ -0,0 +1,258 @@
+//******************************************************************************************
+//  File: Registry.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Registry<...> is an alternative to st::Everything::addSensor()/addExecutor() for
+//			  sketches whose set of devices is fixed at compile time.  The device objects are held by
+//			  value inside the registry, and init() and update() are expanded by the compiler into one
+//			  direct (non-virtual, inlinable) call per device - st::Everything makes a single virtual
+//			  call into the registry per pass of run(), instead of one per device.  No pointer slot
+//			  is used in st::Everything's MAX_SENSOR_COUNT / MAX_EXECUTOR_COUNT arrays; the registry's
+//			  own name index is exactly as long as the device list.
+//
+//			  Example (replaces the addSensor()/addExecutor() calls in setup()):
+//
+//				static st::Registry<st::PS_Illuminance, st::IS_Motion, st::EX_Switch> devices(
+//					st::deviceArgs(F("illuminance1"), 60, 20, PIN_ILLUMINANCE_1, 0, 1023, 0, 1000),
+//					st::deviceArgs(F("motion1"), PIN_MOTION_1, HIGH, false, 500),
+//					st::deviceArgs(F("switch1"), PIN_SWITCH_1, LOW, true));
+//
+//				devices.get<1>().enableHardwareInterrupt();	//configure devices through get<>()
+//				st::Everything::addRegistry(&devices);
+//
+//			  Notes:
+//				- each device is constructed in place, inside the registry, from the arguments given to
+//				  st::deviceArgs() - they are the arguments of the device's own constructor.  Devices are
+//				  never copied, so devices that point into themselves (e.g. PS_DS18B20_Temperature's
+//				  DallasTemperature object, which holds the address of its OneWire bus) work as usual
+//				- PollingSensors in a registry keep their own deadlines in update() - they are not part of
+//				  st::Everything's poll scheduler, so autoPhase does not move them
+//				- refresh() and beSmart() are rare and still go through the Device's vtable (via the name
+//				  index), so st::Everything can pace refreshes and route hub commands as before
+//				- names are given at run time (F() strings), so the sorted name index is built once when
+//				  the registry is constructed rather than at compile time
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Devices are constructed in place from st::deviceArgs() instead of copied from temporaries
+//
+//
+//******************************************************************************************
+
+#ifndef ST_REGISTRY_H
+#define ST_REGISTRY_H
+
+#include "Device.h"
+
+#if defined(ENABLE_PROFILER)
+	#include "Profiler.h"
+#endif
+
+namespace st
+{
+	//the part of a registry st::Everything works with - the device types are not known here
+	class RegistryBase
+	{
+		private:
+			Device **m_pIndex;			//every device in the registry, sorted by name
+			unsigned int m_nCount;
+
+		protected:
+			RegistryBase(Device **index, unsigned int count);
+
+			void sortIndex();			//called once the index has been filled in
+
+		public:
+			//calls init() / update() on every device in the registry
+			virtual void init() = 0;
+			virtual void update() = 0;
+
+			unsigned int count() const {return m_nCount;}
+			Device* getDevice(unsigned int index) const {return m_pIndex[index];}	//in name order
+
+			//binary search of the name index - returns 0 if there is no such device in the registry
+			Device* getDeviceByName(const char *name, unsigned int len) const;
+
+			//sends the messages queued by one device's init() before the next one runs (st::Everything::flushStrings())
+			static void flushStrings();
+	};
+
+	//the constructor arguments of one device, held by value until the registry constructs the device - see st::deviceArgs()
+	template<class... As>
+	struct RegistryArgs;
+
+	template<>
+	struct RegistryArgs<>
+	{
+	};
+
+	template<class A, class... Rest>
+	struct RegistryArgs<A, Rest...>
+	{
+		A m_Arg;
+		RegistryArgs<Rest...> m_Rest;
+
+		RegistryArgs(const A &arg, const Rest&... rest) : m_Arg(arg), m_Rest(rest...) {}
+	};
+
+	//compile time lookup of the I'th argument
+	template<unsigned int I>
+	struct RegistryArg
+	{
+		template<class A, class... Rest>
+		static auto get(const RegistryArgs<A, Rest...> &args) -> decltype(RegistryArg<I - 1>::get(args.m_Rest))
+		{
+			return RegistryArg<I - 1>::get(args.m_Rest);
+		}
+	};
+
+	template<>
+	struct RegistryArg<0>
+	{
+		template<class A, class... Rest>
+		static const A& get(const RegistryArgs<A, Rest...> &args) {return args.m_Arg;}
+	};
+
+	//0, 1, ... N-1 as a template parameter pack (std::index_sequence is C++14, and not in every Arduino core)
+	template<unsigned int... Is>
+	struct RegistryIndices
+	{
+	};
+
+	template<unsigned int N, unsigned int... Is>
+	struct MakeRegistryIndices : public MakeRegistryIndices<N - 1, N - 1, Is...>
+	{
+	};
+
+	template<unsigned int... Is>
+	struct MakeRegistryIndices<0, Is...>
+	{
+		typedef RegistryIndices<Is...> Type;
+	};
+
+	//the arguments of one device's constructor, e.g. st::deviceArgs(F("switch1"), PIN_SWITCH_1, LOW, true)
+	template<class... As>
+	inline RegistryArgs<As...> deviceArgs(As... args)
+	{
+		return RegistryArgs<As...>(args...);
+	}
+
+	//one node per device type - each node holds its device and inherits the nodes of the devices after it
+	template<class... Ds>
+	class RegistryNode;
+
+	template<>
+	class RegistryNode<>
+	{
+		public:
+			inline void initAll() {}
+			inline void updateAll() {}
+			inline void indexAll(Device **) {}
+	};
+
+	template<class D, class... Rest>
+	class RegistryNode<D, Rest...> : public RegistryNode<Rest...>
+	{
+		public:
+			D m_Device;
+
+			//constructs m_Device from the first argument list, and the devices after it from the rest
+			template<class... As, class... RestArgs>
+			RegistryNode(const RegistryArgs<As...> &args, const RestArgs&... rest) :
+				RegistryNode(typename MakeRegistryIndices<sizeof...(As)>::Type(), args, rest...)
+			{
+			}
+
+			template<unsigned int... Is, class... As, class... RestArgs>
+			RegistryNode(RegistryIndices<Is...>, const RegistryArgs<As...> &args, const RestArgs&... rest) :
+				RegistryNode<Rest...>(rest...),
+				m_Device(RegistryArg<Is>::get(args)...)
+			{
+			}
+
+			//D:: qualified calls are resolved at compile time - the object is exactly a D, so this is the same function the vtable would pick
+			inline void initAll()
+			{
+				m_Device.D::init();
+				RegistryBase::flushStrings();
+				RegistryNode<Rest...>::initAll();
+			}
+
+			inline void updateAll()
+			{
+				#if defined(ENABLE_PROFILER)
+					unsigned long start = micros();
+					m_Device.D::update();
+					Profiler::record(&m_Device, Profiler::UPDATE, micros() - start);
+				#else
+					m_Device.D::update();
+				#endif
+				RegistryNode<Rest...>::updateAll();
+			}
+
+			inline void indexAll(Device **index)
+			{
+				*index = &m_Device;
+				RegistryNode<Rest...>::indexAll(index + 1);
+			}
+	};
+
+	//compile time lookup of the I'th device type (and the node holding it)
+	template<unsigned int I, class... Ds>
+	struct RegistryElement;
+
+	template<class D, class... Rest>
+	struct RegistryElement<0, D, Rest...>
+	{
+		typedef D Type;
+		typedef RegistryNode<D, Rest...> Node;
+	};
+
+	template<unsigned int I, class D, class... Rest>
+	struct RegistryElement<I, D, Rest...> : public RegistryElement<I - 1, Rest...>
+	{
+	};
+
+	template<class... Ds>
+	class Registry : public RegistryBase, private RegistryNode<Ds...>
+	{
+		private:
+			Device *m_Index[sizeof...(Ds)];
+
+		public:
+			static const unsigned int COUNT = sizeof...(Ds);
+
+			//constructor - one st::deviceArgs(...) per device, in the order of Ds
+			template<class... Args>
+			Registry(const Args&... args) :
+				RegistryBase(m_Index, COUNT),
+				RegistryNode<Ds...>(args...)
+			{
+				static_assert(sizeof...(Ds) > 0, "st::Registry needs at least one device");
+				static_assert(sizeof...(Args) == sizeof...(Ds), "st::Registry needs one st::deviceArgs(...) per device");
+				RegistryNode<Ds...>::indexAll(m_Index);
+				sortIndex();
+			}
+
+			//m_Index points into the registry itself
+			Registry(const Registry&) = delete;
+			Registry& operator=(const Registry&) = delete;
+
+			virtual void init() {RegistryNode<Ds...>::initAll();}
+			virtual void update() {RegistryNode<Ds...>::updateAll();}
+
+			//the I'th device, in the order given to the constructor
+			template<unsigned int I>
+			typename RegistryElement<I, Ds...>::Type& get()
+			{
+				return static_cast<typename RegistryElement<I, Ds...>::Node&>(*this).m_Device;
+			}
+	};
+}
+
+#endif
@@ -77,7 +77,7 @@ namespace st
 	
 	void S_TimedRelay::init()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	//update function 
@@ -130,7 +130,7 @@ namespace st
 				m_bTimerPending = false;
 
 				//Queue the relay status update the ST Cloud
-				Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+				Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 			}
 		}
 	}
@@ -156,7 +156,7 @@ namespace st
 				m_bTimerPending = true;
 			}
 			//Queue the relay status update the ST Cloud 
-			Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+			Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 			
 			//Set the initial count to zero
 			m_iCurrentCount = 0;
@@ -173,7 +173,7 @@ namespace st
 			m_bTimerPending = false;
 			
 			//Queue the relay status update the ST Cloud 
-			Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+			Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 			
 			//Reset the count to the number of required cycles to prevent Update() routine from running if someone sends an OFF command
 			m_iCurrentCount = m_iNumCycles;
@@ -184,7 +184,7 @@ namespace st
 		else
 		{
 			//Queue the relay status update the ST Cloud 
-			Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+			Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 		}	
 		
 	}
@@ -193,7 +193,7 @@ namespace st
 	void S_TimedRelay::refresh()
 	{
 		//Queue the relay status update the ST Cloud
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	void S_TimedRelay::setOutputPin(byte pin)
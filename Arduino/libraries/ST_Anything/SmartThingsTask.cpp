@@ -0,0 +1,194 @@
+//******************************************************************************************
+//  File: SmartThingsTask.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::SmartThingsTask runs a SmartThings communication method in its own FreeRTOS
+//			  task on the ESP32 (see SmartThingsTask.h).
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          The network task waits for the transport's isReadyToSend()
+//    2026-10-18  agent          The network task keeps its queued messages while the transport's link is down
+//    2026-10-18  agent          The network task sends the messages the transport handed back (popUndelivered()) again, before its queue
+//
+//
+//******************************************************************************************
+
+#include "SmartThingsTask.h"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ST_HOSTSIM)
+
+#if defined(ST_HOSTSIM)
+	#include <chrono>
+#endif
+
+namespace st
+{
+//private
+	SmartThingsTask *SmartThingsTask::s_pInstance = 0;
+
+	void SmartThingsTask::transportCallout(String message)
+	{
+		SmartThingsTask *self = s_pInstance;
+		if (self != 0 && !self->m_Inbound.push(message))
+		{
+			__atomic_add_fetch(&self->m_nInboundDropped, 1, __ATOMIC_RELAXED);
+		}
+	}
+
+	void SmartThingsTask::taskMain(void *param)
+	{
+		SmartThingsTask *self = static_cast<SmartThingsTask*>(param);
+		while (__atomic_load_n(&self->m_bRunning, __ATOMIC_ACQUIRE))
+		{
+			self->service();
+		}
+	#if !defined(ST_HOSTSIM)
+		__atomic_store_n(&self->m_bStopped, true, __ATOMIC_RELEASE);
+		vTaskDelete(NULL);
+	#endif
+	}
+
+	//one pass of the network task - sends at most one message before letting the transport
+	//receive, so a burst of messages cannot hold up the hub's commands.  While the link is
+	//down the messages stay queued (the transport would lose them) - st::Everything spools
+	//the ones that come after them meanwhile, so the order is kept.  Messages the transport
+	//has given up on (see SmartThings::popUndelivered()) are older than the queued ones, so
+	//they are sent again first.
+	void SmartThingsTask::service()
+	{
+		String message;
+		bool sent = m_pTransport->isLinkUp() && m_pTransport->isReadyToSend() && (m_pTransport->popUndelivered(message) || m_Outbound.pop(message));
+		if (sent)
+		{
+			m_pTransport->send(message);
+		}
+
+		m_pTransport->run();
+
+		if (!sent)
+		{
+			//idle - sleep for a tick (on the ESP32 this also lets the idle task feed the watchdog)
+		#if defined(ST_HOSTSIM)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		#else
+			vTaskDelay(1);
+		#endif
+		}
+	}
+
+//public
+	//constructor
+	SmartThingsTask::SmartThingsTask(SmartThings *transport, int core, bool enableDebug):
+		SmartThings(transport->getCallout(), "Task", enableDebug, transport->getTransmitInterval()),
+		m_pTransport(transport),
+		m_bRunning(false),
+		m_nOutboundDropped(0),
+		m_nInboundDropped(0),
+		m_nInboundDroppedReported(0),
+		m_nCore(core)
+	#if !defined(ST_HOSTSIM)
+		, m_bStopped(true)
+	#endif
+	{
+		s_pInstance = this;
+		m_pTransport->setCallout(transportCallout);
+	}
+
+	//destructor
+	SmartThingsTask::~SmartThingsTask()
+	{
+		stop();
+		if (s_pInstance == this)
+		{
+			s_pInstance = 0;
+		}
+	}
+
+	void SmartThingsTask::init(void)
+	{
+		m_pTransport->init();		//connects - st::Everything::init() waits for this with or without the task
+
+		__atomic_store_n(&m_bRunning, true, __ATOMIC_RELEASE);
+	#if defined(ST_HOSTSIM)
+		m_Thread = std::thread(taskMain, this);
+	#else
+		#if CONFIG_FREERTOS_UNICORE
+			m_nCore = tskNO_AFFINITY;
+		#else
+			if (m_nCore < 0)
+			{
+				m_nCore = ARDUINO_RUNNING_CORE == 0 ? 1 : 0;	//the core loop() does not run on (where the WiFi stack runs by default)
+			}
+		#endif
+		m_bStopped = false;
+		if (xTaskCreatePinnedToCore(taskMain, "stNetwork", Constants::NETWORK_TASK_STACK_SIZE, this, Constants::NETWORK_TASK_PRIORITY, NULL, m_nCore) != pdPASS)
+		{
+			m_bRunning = false;
+			m_bStopped = true;
+			Serial.println(F("SmartThingsTask: network task could not be created"));
+			return;
+		}
+	#endif
+
+		if (_isDebugEnabled)
+		{
+			Serial.print(F("SmartThingsTask: network task started on core "));
+			Serial.println(m_nCore);
+		}
+	}
+
+	void SmartThingsTask::run(void)
+	{
+		String message;
+		while (m_Inbound.pop(message))
+		{
+			_calloutFunction(message);
+		}
+
+		if (_isDebugEnabled)
+		{
+			unsigned long dropped = getInboundDropped();
+			if (dropped != m_nInboundDroppedReported)
+			{
+				m_nInboundDroppedReported = dropped;
+				Serial.print(F("SmartThingsTask: inbound queue full - hub commands dropped: "));
+				Serial.println(dropped);
+			}
+		}
+	}
+
+	void SmartThingsTask::send(String message)
+	{
+		if (!m_Outbound.push(message))
+		{
+			m_nOutboundDropped++;
+			if (_isDebugEnabled)
+			{
+				Serial.print(F("SmartThingsTask: outbound queue full - message dropped: "));
+				Serial.println(message);
+			}
+		}
+	}
+
+	void SmartThingsTask::stop()
+	{
+		__atomic_store_n(&m_bRunning, false, __ATOMIC_RELEASE);
+	#if defined(ST_HOSTSIM)
+		if (m_Thread.joinable())
+		{
+			m_Thread.join();
+		}
+	#else
+		while (!__atomic_load_n(&m_bStopped, __ATOMIC_ACQUIRE))
+		{
+			delay(1);
+		}
+	#endif
+	}
+}
+
+#endif
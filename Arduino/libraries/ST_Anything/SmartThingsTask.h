@@ -0,0 +1,120 @@
+//******************************************************************************************
+//  File: SmartThingsTask.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::SmartThingsTask runs a SmartThings communication method in its own FreeRTOS
+//			  task on the ESP32, pinned to the core the sketch's loop() does not run on.  Without
+//			  it, SmartThingsESP32WiFi::send() can hold up st::Everything::run() for a TCP connect
+//			  plus up to a second waiting for the hub's reply, and no device is updated meanwhile.
+//
+//			  To st::Everything it is just another communication method:
+//				- send() copies the message into a lock-free queue (st::SpscQueue) and returns at
+//				  once; the network task passes it on to the wrapped transport's send().
+//				- the network task also calls the wrapped transport's run(), whose callout is
+//				  redirected into a second queue; SmartThingsTask::run() (called by
+//				  st::Everything::run() as usual) drains that queue, so hub commands are still
+//				  executed on the device core.
+//				- while the wrapped transport's isLinkUp() is false, the queued messages are kept
+//				  rather than sent (and lost); st::Everything spools the ones after them (see
+//				  ENABLE_MESSAGE_SPOOL), and both go out in order once the link is back.  Messages
+//				  the transport gives up on (popUndelivered()) are sent again by the network task.
+//			  Neither side ever waits for the other: if a queue is full the message is dropped and
+//			  counted (getOutboundDropped(), getInboundDropped()).  The queue sizes, stack size and
+//			  priority of the task are in Constants.h (NETWORK_TASK_*).
+//
+//			  For Example:  st::Everything::SmartThing = new st::SmartThingsTask(
+//								new st::SmartThingsESP32WiFi(str_ssid, str_password, ip, gateway, subnet, dnsserver, serverPort, hubIp, hubPort, st::receiveSmartString));
+//
+//			  Only one SmartThingsTask may exist.  It is only available on the ESP32, and in the
+//			  Linux host simulation (extras/hostsim), where the network task is a std::thread.
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          The network task waits for the transport's isReadyToSend()
+//    2026-10-18  agent          Forwards isLinkUp() to the transport
+//    2026-10-18  agent          Forwards getHubHealth() to the transport
+//    2026-10-18  agent          Keeps the queued messages while the transport's link is down
+//    2026-10-18  agent          Sends the messages the transport hands back (popUndelivered()) again
+//
+//
+//******************************************************************************************
+
+#ifndef ST_SMARTTHINGSTASK_H
+#define ST_SMARTTHINGSTASK_H
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ST_HOSTSIM)
+
+#include <SmartThings.h>
+#include "Constants.h"
+#include "SpscQueue.h"
+
+#if defined(ST_HOSTSIM)
+	#include <thread>
+#endif
+
+namespace st
+{
+	class SmartThingsTask: public SmartThings
+	{
+		private:
+			SmartThings *m_pTransport;		//the wrapped communication method - once init() has run, only the network task uses it
+			SpscQueue<String, Constants::NETWORK_TASK_OUTBOUND_QUEUE_SIZE> m_Outbound;	//device core -> network task
+			SpscQueue<String, Constants::NETWORK_TASK_INBOUND_QUEUE_SIZE> m_Inbound;	//network task -> device core
+			bool m_bRunning;				//cleared by stop() - accessed with __atomic builtins
+			unsigned long m_nOutboundDropped;	//written by the device core only
+			unsigned long m_nInboundDropped;	//written by the network task only - accessed with __atomic builtins
+			unsigned long m_nInboundDroppedReported;
+			int m_nCore;
+		#if defined(ST_HOSTSIM)
+			std::thread m_Thread;
+		#else
+			bool m_bStopped;				//set by the network task as it exits - accessed with __atomic builtins
+		#endif
+
+			static SmartThingsTask *s_pInstance;
+
+			static void transportCallout(String message);	//the wrapped transport's callout - runs on the network task
+			static void taskMain(void *param);
+			void service();
+
+		public:
+			//constructor - transport is the communication method to run in the network task (its callout receives the hub commands);
+			//core is the core to pin the network task to (-1 = the core loop() does not run on)
+			SmartThingsTask(SmartThings *transport, int core = -1, bool enableDebug = false);
+
+			//destructor - stops the network task
+			virtual ~SmartThingsTask();
+
+			//initializes the wrapped transport on the calling core (as without the task) and starts the network task
+			virtual void init(void);
+
+			//delivers the hub commands received by the network task
+			virtual void run(void);
+
+			//queues a message for the network task to send to the hub
+			virtual void send(String message);
+
+			virtual int getTransmitInterval() const {return m_pTransport->getTransmitInterval();}
+			virtual bool supportsBatching() const {return m_pTransport->supportsBatching();}
+			virtual bool isReadyToSend() {return m_Outbound.count() < m_Outbound.capacity();}
+			virtual bool isLinkUp() {return m_pTransport->isLinkUp();}	//only reads the link state (e.g. WiFi.isConnected()), safe from the loop task
+			virtual const HubHealth* getHubHealth() {return m_pTransport->getHubHealth();}	//counters for monitoring - read without locking
+
+			//stops the network task (waits for the message it is sending, if any)
+			void stop();
+
+			//gets
+			SmartThings* getTransport() const {return m_pTransport;}
+			byte getOutboundCount() const {return m_Outbound.count();}
+			unsigned long getOutboundDropped() const {return m_nOutboundDropped;}
+			unsigned long getInboundDropped() const {return __atomic_load_n(&m_nInboundDropped, __ATOMIC_RELAXED);}
+	};
+}
+
+#endif
+#endif
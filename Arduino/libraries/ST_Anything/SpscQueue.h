@@ -0,0 +1,100 @@
+//******************************************************************************************
+//  File: SpscQueue.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::SpscQueue is a small lock-free single-producer/single-consumer ring buffer.
+//			  One side (e.g. an interrupt service routine) may call push() while the other side
+//			  (e.g. loop()) calls pop(), with no need to disable interrupts.  Each index is only
+//			  ever written by one side, and is published with release/acquire ordering so the
+//			  consumer never sees an index move before the element it guards has been written.
+//
+//			  SIZE must be a power of 2 and no larger than 128.  One slot is never used so that
+//			  a full queue can be told apart from an empty one, so the queue holds SIZE-1 elements.
+//
+//			  For Example:  static st::SpscQueue<unsigned long, 8> edges;
+//							edges.push(micros());			//in the ISR
+//							unsigned long t;
+//							while (edges.pop(t)) { ... }	//in loop()
+//
+//			  In general, this file should not need to be modified.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          pop() clears the slot it empties (for SmartThingsTask's String queues)
+//
+//
+//******************************************************************************************
+
+#ifndef ST_SPSCQUEUE_H
+#define ST_SPSCQUEUE_H
+
+#include <Arduino.h>
+
+namespace st
+{
+	template<typename T, byte SIZE>
+	class SpscQueue
+	{
+		private:
+			static_assert(SIZE >= 2 && SIZE <= 128 && (SIZE & (SIZE - 1)) == 0, "SpscQueue SIZE must be a power of 2 between 2 and 128");
+			static const byte MASK = SIZE - 1;
+
+			T m_Items[SIZE];
+			byte m_nHead;		//next element to pop - only written by the consumer
+			byte m_nTail;		//next free slot - only written by the producer
+
+		public:
+			//constructor
+			SpscQueue() :
+				m_nHead(0),
+				m_nTail(0)
+			{
+
+			}
+
+			//producer side - returns false (and drops item) if the queue is full
+			//always inlined, so an ISR that must live in IRAM (ESP8266/ESP32) never calls out to flash
+			inline __attribute__((always_inline)) bool push(const T &item)
+			{
+				byte tail = __atomic_load_n(&m_nTail, __ATOMIC_RELAXED);
+				byte next = (tail + 1) & MASK;
+				if (next == __atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE))
+				{
+					return false;
+				}
+				m_Items[tail] = item;
+				__atomic_store_n(&m_nTail, next, __ATOMIC_RELEASE);
+				return true;
+			}
+
+			//consumer side - returns false if the queue is empty, otherwise copies the oldest element into item and removes it
+			bool pop(T &item)
+			{
+				byte head = __atomic_load_n(&m_nHead, __ATOMIC_RELAXED);
+				if (head == __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE))
+				{
+					return false;
+				}
+				item = m_Items[head];
+				m_Items[head] = T();		//free what the slot holds (e.g. a String's buffer) now rather than when it is next reused
+				__atomic_store_n(&m_nHead, (byte)((head + 1) & MASK), __ATOMIC_RELEASE);
+				return true;
+			}
+
+			//consumer side - discards everything queued so far
+			void clear()
+			{
+				__atomic_store_n(&m_nHead, __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+			}
+
+			//gets (a snapshot - the other side may change it right after)
+			bool isEmpty() const {return __atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE) == __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE);}
+			byte count() const {return (__atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE) - __atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE)) & MASK;}
+			byte capacity() const {return SIZE - 1;}
+	};
+}
+
+#endif
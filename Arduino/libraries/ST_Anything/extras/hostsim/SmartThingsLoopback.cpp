@@ -0,0 +1,85 @@
+//*******************************************************************************
+//	SmartThings Arduino Loopback Library (Linux host simulation only)
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//	2026-10-18  agent          Made thread safe for use behind SmartThingsTask
+//	2026-10-18  agent          Added setLinkUp() to simulate network outages
+//*******************************************************************************
+
+#include "SmartThingsLoopback.h"
+#include "HostSim.h"
+
+namespace st
+{
+	//*******************************************************************************
+	// SmartThingsLoopback Constructor
+	//*******************************************************************************
+	SmartThingsLoopback::SmartThingsLoopback(SmartThingsCallout_t *callout, int transmitInterval, bool keep, bool print) :
+		SmartThings(callout, "Loopback", false, transmitInterval),
+		m_bKeep(keep),
+		m_bPrint(print),
+		m_pOnSend(0),
+		m_bLinkUp(true),
+		m_nLost(0)
+	{
+	}
+
+	void SmartThingsLoopback::init(void)
+	{
+	}
+
+	void SmartThingsLoopback::run(void)
+	{
+		//swap first - a callout may queue another message
+		std::vector<std::string> inbound;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			inbound.swap(m_Inbound);
+		}
+		for (size_t i = 0; i < inbound.size(); i++)
+		{
+			_calloutFunction(String(inbound[i]));
+		}
+	}
+
+	void SmartThingsLoopback::send(String message)
+	{
+		if (!m_bLinkUp)
+		{
+			m_nLost++;
+			if (m_bPrint)
+			{
+				unsigned long long us = hostsim::now();
+				printf("[%llu.%03llu] LOST %s\n", us / 1000000, (us / 1000) % 1000, message.c_str());
+			}
+			return;
+		}
+		if (m_bPrint)
+		{
+			unsigned long long us = hostsim::now();
+			printf("[%llu.%03llu] SEND %s\n", us / 1000000, (us / 1000) % 1000, message.c_str());
+		}
+		if (m_bKeep)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			Transmission t;
+			t.micros = hostsim::now();
+			t.body = message.c_str();
+			m_Sent.push_back(t);
+		}
+		if (m_pOnSend != 0)
+		{
+			m_pOnSend(message.c_str());
+		}
+	}
+
+	void SmartThingsLoopback::receive(const String &message)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Inbound.push_back(message.c_str());
+	}
+}
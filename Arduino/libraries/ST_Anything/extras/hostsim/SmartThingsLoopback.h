@@ -0,0 +1,82 @@
+//*******************************************************************************
+//	SmartThings Arduino Loopback Library (Linux host simulation only)
+//
+//	Instead of talking to a hub, the loopback transport records every transmission
+//	together with the virtual time it was made, and delivers messages "from the hub"
+//	(receive()) to st::Everything the next time run() is called, just as a network
+//	library would.  It supports batching, so batched transmissions can be inspected.
+//	setLinkUp(false) simulates a network outage:  isLinkUp() returns false, and
+//	anything sent meanwhile is lost (printed as LOST instead of SEND).
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//	2026-10-18  agent          Made thread safe for use behind SmartThingsTask
+//	2026-10-18  agent          Added setLinkUp() to simulate network outages
+//*******************************************************************************
+
+#ifndef __SMARTTHINGSLOOPBACK_H__
+#define __SMARTTHINGSLOOPBACK_H__
+
+#include "SmartThings.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace st
+{
+	class SmartThingsLoopback : public SmartThings
+	{
+	public:
+		struct Transmission
+		{
+			unsigned long long micros;	//virtual time of the transmission (hostsim::now())
+			std::string body;			//one message, or several separated by '\n' if batched
+		};
+
+	private:
+		std::vector<Transmission> m_Sent;
+		std::vector<std::string> m_Inbound;
+		bool m_bKeep;
+		bool m_bPrint;
+		void (*m_pOnSend)(const char *body);
+		std::atomic<bool> m_bLinkUp;
+		unsigned long m_nLost;	//transmissions made while the link was down
+		std::mutex m_Mutex;		//receive() and run()/send() may be called from different threads (SmartThingsTask)
+
+	public:
+		//*******************************************************************************
+		// SmartThingsLoopback Constructor
+		//   keep     - keep every transmission in getSent() (turn off for long runs)
+		//   print    - print every transmission to stdout with its virtual time
+		//*******************************************************************************
+		SmartThingsLoopback(SmartThingsCallout_t *callout, int transmitInterval = 100, bool keep = true, bool print = false);
+
+		virtual void init(void);
+		virtual void run(void);		//delivers the messages passed to receive()
+		virtual void send(String message);
+		virtual bool supportsBatching() const { return true; }
+		virtual bool isLinkUp() { return m_bLinkUp; }
+
+		//queues a message from the "hub" - delivered by the next run()
+		void receive(const String &message);
+
+		//changes the throttling interval st::Everything waits between transmissions
+		void setTransmitInterval(int transmitInterval) { m_nTransmitInterval = transmitInterval; }
+
+		//takes the link down (transmissions are lost until it is back up) or up again
+		void setLinkUp(bool up) { m_bLinkUp = up; }
+		unsigned long getLostCount() const { return m_nLost; }
+
+		//called on every transmission (after it has been recorded)
+		void setOnSend(void (*onSend)(const char *body)) { m_pOnSend = onSend; }
+
+		const std::vector<Transmission>& getSent() const { return m_Sent; }
+		void clearSent() { m_Sent.clear(); }
+	};
+}
+
+#endif
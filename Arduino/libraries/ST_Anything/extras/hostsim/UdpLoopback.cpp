@@ -0,0 +1,221 @@
+//*******************************************************************************
+//	SmartThings Arduino UDP Loopback (Linux host simulation only)
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//*******************************************************************************
+
+#include "UdpLoopback.h"
+#include "HostSim.h"
+
+#define UDP_HUB_HISTORY 64		//sequence numbers the Hub remembers to recognize retransmitted messages
+
+UdpLoopback::UdpLoopback() :
+	m_nReadPos(0),
+	m_HubIP(192, 168, 1, 100),
+	m_nHubPort(39501),
+	m_nNextSeq(0),
+	m_bKeep(true),
+	m_bPrint(false),
+	m_nLossPercent(0),
+	m_nRandom(12345),
+	m_nLost(0),
+	m_nDuplicates(0),
+	m_nCommandRetransmits(0)
+{
+}
+
+//private
+bool UdpLoopback::isLost()
+{
+	if (m_nLossPercent == 0)
+	{
+		return false;
+	}
+	m_nRandom = m_nRandom * 1103515245 + 12345;		//own generator, so the losses do not depend on anything else calling rand()
+	if ((m_nRandom >> 16) % 100 < m_nLossPercent)
+	{
+		m_nLost++;
+		return true;
+	}
+	return false;
+}
+
+void UdpLoopback::toDevice(const std::string &datagram)
+{
+	if (!isLost())
+	{
+		m_ToDevice.push_back(datagram);
+	}
+}
+
+void UdpLoopback::hubReceive(const std::string &datagram)
+{
+	if (isLost() || datagram.size() < 2)
+	{
+		return;
+	}
+	uint16_t seq = (uint16_t)strtoul(datagram.c_str() + 1, 0, 10);
+
+	if (datagram[0] == 'A')
+	{
+		for (size_t i = 0; i < m_Unacknowledged.size(); i++)
+		{
+			if (m_Unacknowledged[i].seq == seq)
+			{
+				m_Unacknowledged.erase(m_Unacknowledged.begin() + i);
+				break;
+			}
+		}
+		return;
+	}
+
+	size_t space = datagram.find(' ');
+	if (datagram[0] != 'D' || space == std::string::npos)
+	{
+		return;
+	}
+	toDevice("A" + std::to_string(seq));
+
+	for (size_t i = 0; i < m_History.size(); i++)
+	{
+		if (m_History[i] == seq)
+		{
+			m_nDuplicates++;
+			return;
+		}
+	}
+	m_History.push_back(seq);
+	if (m_History.size() > UDP_HUB_HISTORY)
+	{
+		m_History.pop_front();
+	}
+
+	std::string body = datagram.substr(space + 1);
+	if (m_bPrint)
+	{
+		unsigned long long us = hostsim::now();
+		::printf("[%llu.%03llu] SEND %s\n", us / 1000000, (us / 1000) % 1000, body.c_str());		//::printf - UdpLoopback is a Print, whose printf() would write into the datagram
+	}
+	if (m_bKeep)
+	{
+		Reception r;
+		r.micros = hostsim::now();
+		r.body = body;
+		m_Received.push_back(r);
+	}
+}
+
+void UdpLoopback::hubRetransmit()
+{
+	unsigned long long now = hostsim::now();
+	for (size_t i = 0; i < m_Unacknowledged.size(); i++)
+	{
+		Command &c = m_Unacknowledged[i];
+		if (now - c.sentMicros >= UDP_RETRANSMIT_INTERVAL * 1000ULL)
+		{
+			c.sentMicros = now;
+			m_nCommandRetransmits++;
+			toDevice("D" + std::to_string(c.seq) + " " + c.message);
+		}
+	}
+}
+
+//public - the UDP API
+int UdpLoopback::beginPacket(IPAddress ip, uint16_t port)
+{
+	(void)ip;
+	(void)port;
+	m_Outgoing.clear();
+	return 1;
+}
+
+int UdpLoopback::beginPacket(const char *host, uint16_t port)
+{
+	(void)host;
+	(void)port;
+	m_Outgoing.clear();
+	return 1;
+}
+
+int UdpLoopback::endPacket()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	hubReceive(m_Outgoing);
+	m_Outgoing.clear();
+	return 1;
+}
+
+size_t UdpLoopback::write(uint8_t c)
+{
+	m_Outgoing += (char)c;
+	return 1;
+}
+
+size_t UdpLoopback::write(const uint8_t *buffer, size_t size)
+{
+	m_Outgoing.append((const char*)buffer, size);
+	return size;
+}
+
+int UdpLoopback::parsePacket()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	hubRetransmit();
+	m_Incoming.clear();
+	m_nReadPos = 0;
+	if (m_ToDevice.empty())
+	{
+		return 0;
+	}
+	m_Incoming = m_ToDevice.front();
+	m_ToDevice.pop_front();
+	return m_Incoming.size();
+}
+
+int UdpLoopback::available()
+{
+	return m_Incoming.size() - m_nReadPos;
+}
+
+int UdpLoopback::read()
+{
+	return m_nReadPos < m_Incoming.size() ? (unsigned char)m_Incoming[m_nReadPos++] : -1;
+}
+
+int UdpLoopback::read(unsigned char *buffer, size_t len)
+{
+	size_t n = m_Incoming.size() - m_nReadPos;
+	if (n > len)
+	{
+		n = len;
+	}
+	memcpy(buffer, m_Incoming.data() + m_nReadPos, n);
+	m_nReadPos += n;
+	return n;
+}
+
+int UdpLoopback::peek()
+{
+	return m_nReadPos < m_Incoming.size() ? (unsigned char)m_Incoming[m_nReadPos] : -1;
+}
+
+void UdpLoopback::flush()
+{
+	m_nReadPos = m_Incoming.size();
+}
+
+//public - the Hub
+void UdpLoopback::sendCommand(const String &message)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	Command c;
+	c.message = message.c_str();
+	c.seq = m_nNextSeq++;
+	c.sentMicros = hostsim::now();
+	m_Unacknowledged.push_back(c);
+	toDevice("D" + std::to_string(c.seq) + " " + c.message);
+}
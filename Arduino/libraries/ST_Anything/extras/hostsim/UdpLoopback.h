@@ -0,0 +1,113 @@
+//*******************************************************************************
+//	SmartThings Arduino UDP Loopback (Linux host simulation only)
+//
+//	A UDP socket (the Arduino UDP API) for st::SmartThingsUdp whose other end is
+//	a stand-in for the Hub, speaking the protocol described in SmartThingsUdp.h:
+//	  - it acknowledges every message datagram, and records (and optionally prints,
+//		with the virtual time) each message the first time it arrives
+//	  - sendCommand() sends a command to the device, and sends it again every
+//		UDP_RETRANSMIT_INTERVAL milliseconds of virtual time until acknowledged
+//	  - setLoss() makes datagrams in both directions get lost, at random but the
+//		same way on every run, to exercise the retransmissions
+//	Datagrams arrive as soon as they are sent.
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//*******************************************************************************
+
+#ifndef __UDPLOOPBACK_H__
+#define __UDPLOOPBACK_H__
+
+#include <Udp.h>
+#include "SmartThingsUdp.h"
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class UdpLoopback : public UDP
+{
+	public:
+		struct Reception
+		{
+			unsigned long long micros;	//virtual time the Hub received the message (hostsim::now())
+			std::string body;
+		};
+
+	private:
+		struct Command
+		{
+			std::string message;
+			uint16_t seq;
+			unsigned long long sentMicros;
+		};
+
+		//device side
+		std::string m_Outgoing;			//datagram being written (beginPacket() ... endPacket())
+		std::string m_Incoming;			//datagram being read (parsePacket() ... read())
+		size_t m_nReadPos;
+
+		//hub side
+		IPAddress m_HubIP;
+		uint16_t m_nHubPort;
+		std::deque<std::string> m_ToDevice;			//datagrams in flight to the device
+		std::vector<Command> m_Unacknowledged;		//commands not acknowledged yet
+		std::deque<uint16_t> m_History;				//sequence numbers of the messages received
+		std::vector<Reception> m_Received;
+		uint16_t m_nNextSeq;
+		bool m_bKeep;
+		bool m_bPrint;
+
+		unsigned int m_nLossPercent;
+		uint32_t m_nRandom;
+		unsigned long m_nLost;
+		unsigned long m_nDuplicates;
+		unsigned long m_nCommandRetransmits;
+
+		std::mutex m_Mutex;		//sendCommand() may be called from another thread than the device side (SmartThingsTask)
+
+		bool isLost();
+		void toDevice(const std::string &datagram);
+		void hubReceive(const std::string &datagram);
+		void hubRetransmit();
+
+	public:
+		UdpLoopback();
+
+		//the UDP API, as used by the device
+		virtual uint8_t begin(uint16_t port) { (void)port; return 1; }
+		virtual void stop() {}
+		virtual int beginPacket(IPAddress ip, uint16_t port);
+		virtual int beginPacket(const char *host, uint16_t port);
+		virtual int endPacket();
+		virtual size_t write(uint8_t c);
+		virtual size_t write(const uint8_t *buffer, size_t size);
+		virtual int parsePacket();
+		virtual int available();
+		virtual int read();
+		virtual int read(unsigned char *buffer, size_t len);
+		virtual int read(char *buffer, size_t len) { return read((unsigned char*)buffer, len); }
+		virtual int peek();
+		virtual void flush();
+		virtual IPAddress remoteIP() { return m_HubIP; }
+		virtual uint16_t remotePort() { return m_nHubPort; }
+		using Print::write;
+
+		//the Hub
+		void setHub(IPAddress ip, uint16_t port) { m_HubIP = ip; m_nHubPort = port; }
+		void setLoss(unsigned int percent) { m_nLossPercent = percent; }
+		void setKeep(bool keep) { m_bKeep = keep; }		//keep every message received in getReceived()
+		void setPrint(bool print) { m_bPrint = print; }	//print every message received to stdout
+		void sendCommand(const String &message);
+
+		const std::vector<Reception>& getReceived() const { return m_Received; }
+		unsigned long getLost() const { return m_nLost; }						//datagrams lost, both directions
+		unsigned long getDuplicates() const { return m_nDuplicates; }			//retransmitted messages the Hub ignored
+		unsigned long getCommandRetransmits() const { return m_nCommandRetransmits; }
+		unsigned int getUnacknowledgedCommands() const { return m_Unacknowledged.size(); }
+};
+
+#endif
@@ -0,0 +1,560 @@
+//******************************************************************************************
+//  File: Arduino.cpp (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Mock Arduino core used to build ST_Anything on a Linux host - virtual clock,
+//			  scripted pins, trace replay, String, Print and Serial.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Numbers are formatted on the stack; String counts the AVR core's heap use
+//    2026-10-18  agent          Added AVR style port input registers and digitalRead()/port read counters
+//    2026-10-18  agent          yield() advances virtual time by 100 microseconds
+//
+//
+//******************************************************************************************
+
+#include "Arduino.h"
+#include "HostSim.h"
+#include <stdarg.h>
+#include <ctype.h>
+#include <vector>
+#include <atomic>
+
+HardwareSerial Serial;
+
+namespace
+{
+	const int PIN_COUNT = 256;
+
+	struct Event
+	{
+		unsigned long long at;	//virtual microseconds
+		char kind;				//'D', 'A', 'I' or 'H' (HUB)
+		int pin;
+		int value;
+		std::string message;
+	};
+
+	std::atomic<unsigned long long> g_nNow(0);	//atomic - SmartThingsTask's network thread reads the clock too
+	int g_Digital[PIN_COUNT];
+	int g_Analog[PIN_COUNT];
+	int g_Output[PIN_COUNT];
+	void (*g_Isr[PIN_COUNT])(void);
+	volatile uint8_t g_PortInput[NUM_DIGITAL_PINS / 8 + 1];	//PINx registers - index 0 is NOT_A_PIN
+	unsigned long g_nDigitalReads = 0;
+	unsigned long g_nPortReads = 0;
+	void (*g_pOutputCallback)(uint8_t, int) = 0;
+	void (*g_pHubHandler)(const String &) = 0;
+	std::vector<Event> g_Events;		//sorted by time - events with equal times keep the order they were added in
+	size_t g_nNextEvent = 0;
+
+	void insertEvent(const Event &e)
+	{
+		std::vector<Event>::iterator it = g_Events.begin() + g_nNextEvent;
+		while (it != g_Events.end() && it->at <= e.at)
+		{
+			++it;
+		}
+		g_Events.insert(it, e);
+	}
+
+	void output(uint8_t pin, int value)
+	{
+		g_Output[pin] = value;
+		if (g_pOutputCallback != 0)
+		{
+			g_pOutputCallback(pin, value);
+		}
+	}
+}
+
+//Arduino API
+unsigned long millis() { return (uint32_t)(g_nNow / 1000); }
+unsigned long micros() { return (uint32_t)g_nNow; }
+void delay(unsigned long ms) { g_nNow += (unsigned long long)ms * 1000; }
+void delayMicroseconds(unsigned int us) { g_nNow += us; }
+void yield() { g_nNow += 100; }		//a loop waiting on yield() lets virtual time pass, as real time passes on a board
+void pinMode(uint8_t, uint8_t) {}
+int digitalRead(uint8_t pin) { g_nDigitalReads++; return g_Digital[pin]; }
+
+volatile uint8_t *portInputRegister(uint8_t port)
+{
+	if (port == NOT_A_PIN || port > NUM_DIGITAL_PINS / 8)
+	{
+		return &g_PortInput[NOT_A_PIN];
+	}
+	uint8_t value = 0;
+	for (int bit = 0; bit < 8; bit++)
+	{
+		if (g_Digital[(port - 1) * 8 + bit])
+		{
+			value |= 1 << bit;
+		}
+	}
+	g_PortInput[port] = value;
+	g_nPortReads++;
+	return &g_PortInput[port];
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) { output(pin, value); }
+int analogRead(uint8_t pin) { return g_Analog[pin]; }
+void analogWrite(uint8_t pin, int value) { output(pin, value); }
+unsigned long pulseIn(uint8_t, uint8_t, unsigned long) { return 0; }
+long map(long x, long inMin, long inMax, long outMin, long outMax) { return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin; }
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int) { g_Isr[interrupt] = isr; }
+void detachInterrupt(uint8_t interrupt) { g_Isr[interrupt] = 0; }
+long random(long howBig) { return howBig ? rand() % howBig : 0; }
+long random(long howSmall, long howBig) { return howSmall + random(howBig - howSmall); }
+void randomSeed(unsigned long seed) { srand(seed); }
+
+//simulation controls
+namespace hostsim
+{
+	void setMillis(unsigned long long ms) { g_nNow = ms * 1000; }
+	void advanceMillis(unsigned long ms) { g_nNow += (unsigned long long)ms * 1000; }
+	void advanceMicros(unsigned long us) { g_nNow += us; }
+	unsigned long long now() { return g_nNow; }
+
+	void setDigital(uint8_t pin, int level) { g_Digital[pin] = level; }
+	void setAnalog(uint8_t pin, int value) { g_Analog[pin] = value; }
+	int getOutput(uint8_t pin) { return g_Output[pin]; }
+	void setOutputCallback(void (*callback)(uint8_t pin, int value)) { g_pOutputCallback = callback; }
+	void triggerInterrupt(uint8_t pin) { if (g_Isr[pin]) g_Isr[pin](); }
+	unsigned long digitalReadCount() { return g_nDigitalReads; }
+	unsigned long portReadCount() { return g_nPortReads; }
+
+	void setHubHandler(void (*handler)(const String &message)) { g_pHubHandler = handler; }
+
+	void addEvent(unsigned long ms, char kind, int pin, int value)
+	{
+		Event e;
+		e.at = g_nNow + (unsigned long long)ms * 1000;
+		e.kind = kind;
+		e.pin = pin;
+		e.value = value;
+		insertEvent(e);
+	}
+
+	void addHubEvent(unsigned long ms, const char *message)
+	{
+		Event e;
+		e.at = g_nNow + (unsigned long long)ms * 1000;
+		e.kind = 'H';
+		e.pin = 0;
+		e.value = 0;
+		e.message = message;
+		insertEvent(e);
+	}
+
+	bool loadTrace(const char *path)
+	{
+		FILE *f = fopen(path, "r");
+		if (f == 0)
+		{
+			return false;
+		}
+
+		char line[256];
+		while (fgets(line, sizeof(line), f) != 0)
+		{
+			char *hash = strchr(line, '#');
+			if (hash != 0)
+			{
+				*hash = '\0';
+			}
+			line[strcspn(line, "\r\n")] = '\0';
+
+			unsigned long ms;
+			char kind[8];
+			int consumed = 0;
+			if (sscanf(line, " %lu %7s %n", &ms, kind, &consumed) < 2)
+			{
+				continue;	//blank line or comment
+			}
+
+			if (strcmp(kind, "HUB") == 0)
+			{
+				addHubEvent(ms, line + consumed);
+			}
+			else
+			{
+				int pin, value;
+				if (sscanf(line + consumed, "%d %d", &pin, &value) == 2 && pin >= 0 && pin < PIN_COUNT)
+				{
+					addEvent(ms, kind[0], pin, value);
+				}
+			}
+		}
+		fclose(f);
+		return true;
+	}
+
+	unsigned int pendingEvents() { return g_Events.size() - g_nNextEvent; }
+
+	void applyDueEvents()
+	{
+		while (g_nNextEvent < g_Events.size() && g_Events[g_nNextEvent].at <= g_nNow)
+		{
+			Event e = g_Events[g_nNextEvent++];	//copy - a handler may add events
+			switch (e.kind)
+			{
+				case 'D':
+					g_Digital[e.pin] = e.value;
+					break;
+				case 'A':
+					g_Analog[e.pin] = e.value;
+					break;
+				case 'I':
+					g_Digital[e.pin] = e.value;
+					triggerInterrupt(e.pin);
+					break;
+				case 'H':
+					if (g_pHubHandler != 0)
+					{
+						g_pHubHandler(String(e.message));
+					}
+					break;
+			}
+		}
+	}
+
+	void runFor(unsigned long ms, void (*loop)(), unsigned long stepMicros)
+	{
+		unsigned long long end = g_nNow.load() + (unsigned long long)ms * 1000;
+		while (g_nNow < end)
+		{
+			applyDueEvents();
+			loop();
+			g_nNow += stepMicros;
+		}
+	}
+}
+
+//Serial
+size_t HardwareSerial::write(uint8_t c)
+{
+	if (echo)
+	{
+		fputc(c, stdout);
+	}
+	if (capture)
+	{
+		output += (char)c;
+	}
+	return 1;
+}
+
+int HardwareSerial::read()
+{
+	if (input.empty())
+	{
+		return -1;
+	}
+	int c = (unsigned char)input[0];
+	input.erase(0, 1);
+	return c;
+}
+
+size_t IPAddress::printTo(Print &p) const
+{
+	size_t n = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		n += p.print((int)b[i]);
+		if (i < 3)
+		{
+			n += p.print('.');
+		}
+	}
+	return n;
+}
+
+//number formatting into a buffer on the stack - used by String and Print, neither touches the heap for it
+namespace
+{
+	const char *formatULong(char (&b)[70], unsigned long v, unsigned char base)
+	{
+		int i = 68;
+		b[69] = '\0';
+		if (base < 2)
+		{
+			base = 10;
+		}
+		if (v == 0)
+		{
+			b[i--] = '0';
+		}
+		while (v != 0)
+		{
+			int d = v % base;
+			b[i--] = d < 10 ? '0' + d : 'A' + d - 10;
+			v /= base;
+		}
+		return b + i + 1;
+	}
+
+	const char *formatLong(char (&b)[70], long v, unsigned char base)
+	{
+		if (base != 10)
+		{
+			return formatULong(b, (unsigned long)v, base);
+		}
+		snprintf(b, sizeof(b), "%ld", v);
+		return b;
+	}
+
+	const char *formatDouble(char (&b)[70], double v, unsigned char decimals)
+	{
+		snprintf(b, sizeof(b), "%.*f", decimals, v);
+		return b;
+	}
+}
+
+//String
+unsigned long String::heapAllocations = 0;
+unsigned long String::heapBytes = 0;
+unsigned long String::heapLive = 0;
+unsigned long String::heapPeak = 0;
+
+void String::arduinoReserve(unsigned int length)
+{
+	if (m_bBuffer && m_nCapacity >= length)
+	{
+		return;
+	}
+	heapAllocations++;
+	heapBytes += length + 1;
+	heapLive += length + 1 - (m_bBuffer ? m_nCapacity + 1 : 0);
+	if (heapLive > heapPeak)
+	{
+		heapPeak = heapLive;
+	}
+	m_bBuffer = true;
+	m_nCapacity = length;
+}
+
+void String::arduinoFree()
+{
+	if (m_bBuffer)
+	{
+		heapLive -= m_nCapacity + 1;
+		m_bBuffer = false;
+		m_nCapacity = 0;
+	}
+}
+
+String &String::operator=(const String &o)
+{
+	if (this != &o)
+	{
+		s = o.s;
+		if (o.m_bBuffer)
+		{
+			arduinoReserve(s.size());
+		}
+		else
+		{
+			arduinoFree();
+		}
+	}
+	return *this;
+}
+
+String &String::operator=(String &&o)
+{
+	if (this != &o)
+	{
+		arduinoFree();
+		s = std::move(o.s);
+		m_bBuffer = o.m_bBuffer;
+		m_nCapacity = o.m_nCapacity;
+		o.s.clear();
+		o.m_bBuffer = false;
+		o.m_nCapacity = 0;
+	}
+	return *this;
+}
+
+String &String::append(const char *c, size_t n)
+{
+	if (n > 0)	//appending nothing does not allocate, even to a String without a buffer
+	{
+		s.append(c, n);
+		arduinoReserve(s.size());
+	}
+	return *this;
+}
+
+String &String::operator+=(long v)
+{
+	char b[70];
+	return *this += formatLong(b, v, 10);
+}
+
+String &String::operator+=(unsigned long v)
+{
+	char b[70];
+	return *this += formatULong(b, v, 10);
+}
+
+String &String::operator+=(double v)
+{
+	char b[70];
+	return *this += formatDouble(b, v, 2);
+}
+
+void String::fromLong(long v, unsigned char base)
+{
+	char b[70];
+	s = formatLong(b, v, base);
+	arduinoReserve(s.size());
+}
+
+void String::fromULong(unsigned long v, unsigned char base)
+{
+	char b[70];
+	s = formatULong(b, v, base);
+	arduinoReserve(s.size());
+}
+
+void String::fromDouble(double v, unsigned char decimals)
+{
+	char b[70];
+	s = formatDouble(b, v, decimals);
+	arduinoReserve(s.size());
+}
+
+String String::substring(unsigned int b, unsigned int e) const
+{
+	if (b > e)
+	{
+		std::swap(b, e);
+	}
+	if (b >= s.size())
+	{
+		return String();
+	}
+	if (e > s.size())
+	{
+		e = s.size();
+	}
+	return String(s.substr(b, e - b));
+}
+
+bool String::equalsIgnoreCase(const String &o) const
+{
+	if (s.size() != o.s.size())
+	{
+		return false;
+	}
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		if (tolower((unsigned char)s[i]) != tolower((unsigned char)o.s[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void String::replace(const String &a, const String &b)
+{
+	if (a.s.empty())
+	{
+		return;
+	}
+	size_t p = 0;
+	while ((p = s.find(a.s, p)) != std::string::npos)
+	{
+		s.replace(p, a.s.size(), b.s);
+		p += b.s.size();
+	}
+	if (m_bBuffer)
+	{
+		arduinoReserve(s.size());
+	}
+}
+
+void String::trim()
+{
+	size_t b = 0;
+	while (b < s.size() && isspace((unsigned char)s[b]))
+	{
+		b++;
+	}
+	size_t e = s.size();
+	while (e > b && isspace((unsigned char)s[e - 1]))
+	{
+		e--;
+	}
+	s = s.substr(b, e - b);
+}
+
+void String::toLowerCase()
+{
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		s[i] = tolower((unsigned char)s[i]);
+	}
+}
+
+void String::toUpperCase()
+{
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		s[i] = toupper((unsigned char)s[i]);
+	}
+}
+
+void String::toCharArray(char *buf, unsigned int n, unsigned int idx) const
+{
+	if (n == 0)
+	{
+		return;
+	}
+	strncpy(buf, s.c_str() + std::min<size_t>(idx, s.size()), n - 1);
+	buf[n - 1] = '\0';
+}
+
+//like the AVR core's StringSumHelper - a copy of the left hand side, which the right hand side is appended to
+String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+String operator+(const String &a, const char *b) { String r(a); r += b; return r; }
+String operator+(const char *a, const String &b) { String r(a); r += b; return r; }
+String operator+(const String &a, char b) { String r(a); r += b; return r; }
+String operator+(const String &a, int b) { String r(a); r += b; return r; }
+String operator+(const String &a, unsigned int b) { String r(a); r += b; return r; }
+String operator+(const String &a, long b) { String r(a); r += b; return r; }
+String operator+(const String &a, unsigned long b) { String r(a); r += b; return r; }
+String operator+(const String &a, float b) { String r(a); r += b; return r; }
+String operator+(const String &a, double b) { String r(a); r += b; return r; }
+String operator+(const String &a, const __FlashStringHelper *b) { String r(a); r += b; return r; }
+
+//Print
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+	size_t n = 0;
+	while (size--)
+	{
+		n += write(*buffer++);
+	}
+	return n;
+}
+
+size_t Print::print(long v, int base) { char b[70]; return write(formatLong(b, v, (unsigned char)base)); }
+size_t Print::print(unsigned long v, int base) { char b[70]; return write(formatULong(b, v, (unsigned char)base)); }
+size_t Print::print(double v, int digits) { char b[70]; return write(formatDouble(b, v, (unsigned char)digits)); }
+size_t Print::print(const Printable &p) { return p.printTo(*this); }
+
+size_t Print::printf(const char *format, ...)
+{
+	char b[256];
+	va_list ap;
+	va_start(ap, format);
+	vsnprintf(b, sizeof(b), format, ap);
+	va_end(ap);
+	return write(b);
+}
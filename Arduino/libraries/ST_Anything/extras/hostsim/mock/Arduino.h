@@ -0,0 +1,298 @@
+//******************************************************************************************
+//  File: Arduino.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Mock Arduino core used to build ST_Anything on a Linux host.  It provides just
+//			  enough of the Arduino API for st::Everything, the Sensor/Executor base classes and
+//			  the bundled devices to compile and run:
+//				- millis()/micros() read a virtual clock that only moves when the simulation says
+//				  so (see HostSim.h) - both wrap at 32 bits, exactly like a real board
+//				- digitalRead()/analogRead() return scripted values, digitalWrite()/analogWrite()
+//				  are recorded (and can be observed with a callback)
+//				- pins 0-63 also form AVR style 8 bit ports (port 1 is pins 0-7, port 2 pins 8-15, ...)
+//				  whose input registers (portInputRegister()) hold the same scripted levels
+//				- String, Print and Serial behave like the Arduino versions for the calls used by
+//				  this library.  String also counts the heap the AVR core's String would use for the
+//				  same calls (String::heapAllocations, ...) - the std::string it is built on hides
+//				  most allocations behind its short string optimisation
+//				- flash strings (F(), PROGMEM, pgm_read_byte()) are ordinary RAM strings
+//
+//			  It is only used by the CMake build in extras/hostsim - the Arduino IDE never sees it.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          String counts the heap the AVR core's String would use; Print formats numbers without a String, as on a board
+//    2026-10-18  agent          Added AVR style port input registers, so st::GpioSnapshot can be tested
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_ARDUINO_H
+#define HOSTSIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef unsigned int word;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define NUM_DIGITAL_PINS 64
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) ((p) < NUM_DIGITAL_PINS ? (p) : NOT_AN_INTERRUPT)
+#define NOT_A_PIN 0
+#define digitalPinToPort(p) ((p) < NUM_DIGITAL_PINS ? (p) / 8 + 1 : NOT_A_PIN)
+#define digitalPinToBitMask(p) ((uint8_t)(1 << ((p) % 8)))
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(a) (*(const uint8_t*)(a))
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define memcpy_P memcpy
+#define noInterrupts()
+#define interrupts()
+#define constrain(a,l,h) ((a)<(l)?(l):((a)>(h)?(h):(a)))
+using std::min;
+using std::max;
+#define abs(x) ((x)>0?(x):-(x))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+volatile uint8_t *portInputRegister(uint8_t port);	//PINx - refreshed from the scripted levels on every call
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout = 1000000L);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+class String
+{
+	public:
+		std::string s;
+
+		String() : m_bBuffer(false), m_nCapacity(0) {}
+		String(const char *c) : s(c ? c : ""), m_bBuffer(false), m_nCapacity(0) { if (c) arduinoReserve(s.size()); }
+		String(const std::string &c) : s(c), m_bBuffer(false), m_nCapacity(0) { arduinoReserve(s.size()); }
+		String(const __FlashStringHelper *f) : s(reinterpret_cast<const char*>(f)), m_bBuffer(false), m_nCapacity(0) { arduinoReserve(s.size()); }
+		explicit String(char c) : s(1, c), m_bBuffer(false), m_nCapacity(0) { arduinoReserve(1); }
+		explicit String(unsigned char v, unsigned char base = 10) : m_bBuffer(false), m_nCapacity(0) { fromULong(v, base); }
+		explicit String(int v, unsigned char base = 10) : m_bBuffer(false), m_nCapacity(0) { fromLong(v, base); }
+		explicit String(unsigned int v, unsigned char base = 10) : m_bBuffer(false), m_nCapacity(0) { fromULong(v, base); }
+		explicit String(long v, unsigned char base = 10) : m_bBuffer(false), m_nCapacity(0) { fromLong(v, base); }
+		explicit String(unsigned long v, unsigned char base = 10) : m_bBuffer(false), m_nCapacity(0) { fromULong(v, base); }
+		explicit String(float v, unsigned char decimals = 2) : m_bBuffer(false), m_nCapacity(0) { fromDouble(v, decimals); }
+		explicit String(double v, unsigned char decimals = 2) : m_bBuffer(false), m_nCapacity(0) { fromDouble(v, decimals); }
+		String(const String &o) : s(o.s), m_bBuffer(false), m_nCapacity(0) { if (o.m_bBuffer) arduinoReserve(s.size()); }
+		String(String &&o) : s(std::move(o.s)), m_bBuffer(o.m_bBuffer), m_nCapacity(o.m_nCapacity) { o.s.clear(); o.m_bBuffer = false; o.m_nCapacity = 0; }
+		~String() { arduinoFree(); }
+		String &operator=(const String &o);
+		String &operator=(String &&o);
+
+		unsigned int length() const { return s.size(); }
+		const char *c_str() const { return s.c_str(); }
+		bool reserve(unsigned int n) { s.reserve(n); arduinoReserve(n); return true; }
+		char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+		char &operator[](unsigned int i) { return s[i]; }
+		char charAt(unsigned int i) const { return (*this)[i]; }
+		void setCharAt(unsigned int i, char c) { if (i < s.size()) s[i] = c; }
+
+		String &operator+=(const String &o) { return append(o.s.c_str(), o.s.size()); }
+		String &operator+=(const char *o) { return o ? append(o, strlen(o)) : *this; }
+		String &operator+=(char c) { return append(&c, 1); }
+		String &operator+=(int v) { return *this += (long)v; }
+		String &operator+=(unsigned int v) { return *this += (unsigned long)v; }
+		String &operator+=(long v);
+		String &operator+=(unsigned long v);
+		String &operator+=(float v) { return *this += (double)v; }
+		String &operator+=(double v);
+		String &operator+=(const __FlashStringHelper *f) { return *this += reinterpret_cast<const char*>(f); }
+		bool concat(const String &o) { *this += o; return true; }
+		bool concat(const char *o) { *this += o; return true; }
+		bool concat(char c) { *this += c; return true; }
+
+		bool operator==(const String &o) const { return s == o.s; }
+		bool operator==(const char *o) const { return s == o; }
+		bool operator!=(const String &o) const { return s != o.s; }
+		bool operator!=(const char *o) const { return s != o; }
+		bool operator<(const String &o) const { return s < o.s; }
+		bool equals(const String &o) const { return s == o.s; }
+		bool equalsIgnoreCase(const String &o) const;
+		bool startsWith(const String &o) const { return s.compare(0, o.s.size(), o.s) == 0; }
+		bool endsWith(const String &o) const { return s.size() >= o.s.size() && s.compare(s.size() - o.s.size(), o.s.size(), o.s) == 0; }
+
+		int indexOf(char c, unsigned int from = 0) const { size_t p = s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+		int indexOf(const String &o, unsigned int from = 0) const { size_t p = s.find(o.s, from); return p == std::string::npos ? -1 : (int)p; }
+		int lastIndexOf(char c) const { size_t p = s.rfind(c); return p == std::string::npos ? -1 : (int)p; }
+		String substring(unsigned int b) const { return b >= s.size() ? String() : String(s.substr(b)); }
+		String substring(unsigned int b, unsigned int e) const;
+		void remove(unsigned int i) { if (i < s.size()) s.erase(i); }
+		void remove(unsigned int i, unsigned int n) { if (i < s.size()) s.erase(i, n); }
+		void replace(const String &a, const String &b);
+		void replace(char a, char b) { std::replace(s.begin(), s.end(), a, b); }
+		void trim();
+		void toLowerCase();
+		void toUpperCase();
+
+		long toInt() const { return atol(s.c_str()); }
+		float toFloat() const { return atof(s.c_str()); }
+		double toDouble() const { return atof(s.c_str()); }
+		void toCharArray(char *buf, unsigned int n, unsigned int idx = 0) const;
+		void getBytes(unsigned char *buf, unsigned int n) const { toCharArray((char*)buf, n); }
+
+		//host simulation only - heap the AVR core's String would use for the same calls: every String with contents
+		//owns a malloc()ed buffer of exactly length + 1 bytes, which is realloc()ed whenever the String grows
+		static unsigned long heapAllocations;	//malloc()/realloc() calls
+		static unsigned long heapBytes;			//bytes requested by them
+		static unsigned long heapLive;			//bytes held by the Strings that exist now
+		static unsigned long heapPeak;			//highest heapLive (reset it to heapLive to start a new measurement)
+
+	private:
+		bool m_bBuffer;				//the AVR String would have a heap buffer
+		unsigned int m_nCapacity;	//of this many characters (plus the null terminator)
+
+		void arduinoReserve(unsigned int length);	//String::reserve() of the AVR core - allocates or grows the buffer if it is too small
+		void arduinoFree();
+		String &append(const char *c, size_t n);
+		void fromLong(long v, unsigned char base);
+		void fromULong(unsigned long v, unsigned char base);
+		void fromDouble(double v, unsigned char decimals);
+};
+String operator+(const String &a, const String &b);
+String operator+(const String &a, const char *b);
+String operator+(const char *a, const String &b);
+String operator+(const String &a, char b);
+String operator+(const String &a, int b);
+String operator+(const String &a, unsigned int b);
+String operator+(const String &a, long b);
+String operator+(const String &a, unsigned long b);
+String operator+(const String &a, float b);
+String operator+(const String &a, double b);
+String operator+(const String &a, const __FlashStringHelper *b);
+template <typename T> String operator+(String &&a, const T &b) { a += b; return std::move(a); }	//a + b + c - like the AVR core's StringSumHelper, the String made by the first + grows in place
+
+class Printable;
+
+class Print
+{
+	public:
+		virtual ~Print() {}
+		virtual size_t write(uint8_t c) = 0;
+		virtual size_t write(const uint8_t *buffer, size_t size);
+		size_t write(const char *str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+		size_t write(const char *buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+		size_t print(const __FlashStringHelper *f) { return write(reinterpret_cast<const char*>(f)); }
+		size_t print(const String &v) { return write((const uint8_t*)v.c_str(), v.length()); }
+		size_t print(const char *v) { return write(v); }
+		size_t print(char c) { return write((uint8_t)c); }
+		size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+		size_t print(int v, int base = DEC) { return print((long)v, base); }
+		size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+		size_t print(long v, int base = DEC);
+		size_t print(unsigned long v, int base = DEC);
+		size_t print(double v, int digits = 2);
+		size_t print(const Printable &p);
+
+		size_t println() { return write("\r\n"); }
+		template <typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+		template <typename T> size_t println(const T &v, int format) { size_t n = print(v, format); return n + println(); }
+		size_t printf(const char *format, ...);
+
+		virtual void flush() {}
+};
+
+class Printable
+{
+	public:
+		virtual ~Printable() {}
+		virtual size_t printTo(Print &p) const = 0;
+};
+
+class Stream : public Print
+{
+	public:
+		virtual int available() = 0;
+		virtual int read() = 0;
+		virtual int peek() = 0;
+};
+
+//Serial - output goes to stdout if echo is set, and is kept in output if capture is set
+//(neither by default, so long simulations do not fill memory); input is what the simulation puts in input
+class HardwareSerial : public Stream
+{
+	public:
+		std::string output;
+		std::string input;
+		bool echo;
+		bool capture;
+
+		HardwareSerial() : echo(false), capture(false) {}
+		void begin(unsigned long) {}
+		void end() {}
+		size_t write(uint8_t c);
+		using Print::write;
+		int available() { return input.size(); }
+		int read();
+		int peek() { return input.empty() ? -1 : (unsigned char)input[0]; }
+		operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+class IPAddress : public Printable
+{
+	public:
+		uint8_t b[4];
+
+		IPAddress() : b{0, 0, 0, 0} {}
+		IPAddress(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) : b{b0, b1, b2, b3} {}
+		uint8_t operator[](int i) const { return b[i]; }
+		uint8_t &operator[](int i) { return b[i]; }
+		bool operator==(const IPAddress &o) const { return memcmp(b, o.b, 4) == 0; }
+		size_t printTo(Print &p) const;
+};
+
+#endif
@@ -0,0 +1,40 @@
+//******************************************************************************************
+//  File: Client.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  The Arduino Client interface (a TCP connection), for network code built in the
+//			  Linux host simulation against a scripted client.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_CLIENT_H
+#define HOSTSIM_CLIENT_H
+
+#include "Arduino.h"
+
+class Client : public Stream
+{
+	public:
+		virtual int connect(IPAddress ip, uint16_t port) = 0;
+		virtual int connect(const char *host, uint16_t port) = 0;
+		virtual size_t write(uint8_t c) = 0;
+		virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+		virtual int available() = 0;
+		virtual int read() = 0;
+		virtual int read(uint8_t *buffer, size_t size) = 0;
+		virtual int peek() = 0;
+		virtual void flush() = 0;
+		virtual void stop() = 0;
+		virtual uint8_t connected() = 0;
+		virtual operator bool() = 0;
+		using Print::write;
+};
+
+#endif
@@ -0,0 +1,18 @@
+//******************************************************************************************
+//  File: EEPROM.cpp (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  The one EEPROM object of the mock EEPROM library (see EEPROM.h).
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
@@ -0,0 +1,103 @@
+//******************************************************************************************
+//  File: EEPROM.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  The AVR EEPROM library (read/write/update/length), for st::MessageSpool in the Linux
+//			  host simulation.  The EEPROM starts erased (every byte 0xFF) and counts how often each
+//			  byte is written, so the wear caused by the code under test can be checked.  load() and
+//			  save() keep the contents in a file, so a "restart" can be simulated by a second run.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          EEPROM is declared extern and defined once in EEPROM.cpp (no unused static copy in every file)
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_EEPROM_H
+#define HOSTSIM_EEPROM_H
+
+#include "Arduino.h"
+#include <stdio.h>
+
+#ifndef HOSTSIM_EEPROM_SIZE
+	#define HOSTSIM_EEPROM_SIZE 4096	//as on the MEGA
+#endif
+
+class EEPROMClass
+{
+	private:
+		struct Storage
+		{
+			uint8_t bytes[HOSTSIM_EEPROM_SIZE];
+			unsigned long writes[HOSTSIM_EEPROM_SIZE];
+			Storage() { memset(bytes, 0xFF, sizeof(bytes)); memset(writes, 0, sizeof(writes)); }
+		};
+		static Storage& storage() { static Storage s; return s; }	//one EEPROM, however many files include this header
+
+	public:
+		uint8_t read(int address) { return (address >= 0 && address < HOSTSIM_EEPROM_SIZE) ? storage().bytes[address] : 0xFF; }
+		void write(int address, uint8_t value)
+		{
+			if (address >= 0 && address < HOSTSIM_EEPROM_SIZE)
+			{
+				storage().bytes[address] = value;
+				storage().writes[address]++;
+			}
+		}
+		void update(int address, uint8_t value) { if (read(address) != value) write(address, value); }
+		uint16_t length() { return HOSTSIM_EEPROM_SIZE; }
+
+		//host simulation only
+		unsigned long getWriteCount(int address) { return (address >= 0 && address < HOSTSIM_EEPROM_SIZE) ? storage().writes[address] : 0; }
+		unsigned long getMaxWriteCount()
+		{
+			unsigned long most = 0;
+			for (int i = 0; i < HOSTSIM_EEPROM_SIZE; i++)
+			{
+				most = max(most, storage().writes[i]);
+			}
+			return most;
+		}
+		unsigned long getTotalWriteCount()
+		{
+			unsigned long total = 0;
+			for (int i = 0; i < HOSTSIM_EEPROM_SIZE; i++)
+			{
+				total += storage().writes[i];
+			}
+			return total;
+		}
+		bool load(const char *path)		//returns false (and leaves the EEPROM erased) if path cannot be read
+		{
+			FILE *f = fopen(path, "rb");
+			if (f == 0)
+			{
+				return false;
+			}
+			bool ok = fread(storage().bytes, 1, HOSTSIM_EEPROM_SIZE, f) == HOSTSIM_EEPROM_SIZE;
+			fclose(f);
+			if (!ok)
+			{
+				memset(storage().bytes, 0xFF, HOSTSIM_EEPROM_SIZE);
+			}
+			return ok;
+		}
+		bool save(const char *path)
+		{
+			FILE *f = fopen(path, "wb");
+			if (f == 0)
+			{
+				return false;
+			}
+			bool ok = fwrite(storage().bytes, 1, HOSTSIM_EEPROM_SIZE, f) == HOSTSIM_EEPROM_SIZE;
+			return fclose(f) == 0 && ok;
+		}
+};
+
+extern EEPROMClass EEPROM;		//defined in EEPROM.cpp
+
+#endif
@@ -0,0 +1,152 @@
+//******************************************************************************************
+//  File: Ethernet.cpp (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Mock Ethernet library and the fake TCP network behind it (see HostNet.h).
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include "Ethernet.h"
+
+EthernetClass Ethernet;
+
+namespace
+{
+	bool g_bReachable = true;
+	bool g_bLinkUp = true;
+	std::vector<hostsim::SocketPtr> g_Outbound;
+	std::vector<hostsim::SocketPtr> g_Inbound;
+}
+
+//the fake network
+namespace hostsim
+{
+	void setReachable(bool reachable) { g_bReachable = reachable; }
+	const std::vector<SocketPtr> &outbound() { return g_Outbound; }
+	void setLinkUp(bool up) { g_bLinkUp = up; }
+
+	SocketPtr connect(uint16_t port)
+	{
+		SocketPtr socket = std::make_shared<Socket>();
+		socket->port = port;
+		g_Inbound.push_back(socket);
+		return socket;
+	}
+
+	void resetNetwork()
+	{
+		g_bReachable = true;
+		g_bLinkUp = true;
+		g_Outbound.clear();
+		g_Inbound.clear();
+	}
+}
+
+//EthernetClient
+int EthernetClient::connect(IPAddress ip, uint16_t port)
+{
+	stop();
+	if (!g_bReachable || !g_bLinkUp)
+	{
+		return 0;
+	}
+	m_pSocket = std::make_shared<hostsim::Socket>();
+	m_pSocket->ip = ip;
+	m_pSocket->port = port;
+	g_Outbound.push_back(m_pSocket);
+	return 1;
+}
+
+int EthernetClient::connect(const char *, uint16_t)
+{
+	return 0;	//no DNS on the fake network
+}
+
+size_t EthernetClient::write(uint8_t c)
+{
+	return write(&c, 1);
+}
+
+size_t EthernetClient::write(const uint8_t *buffer, size_t size)
+{
+	if (!m_pSocket || !m_pSocket->boardOpen || !m_pSocket->peerOpen)
+	{
+		return 0;
+	}
+	m_pSocket->fromBoard.append((const char*)buffer, size);
+	return size;
+}
+
+int EthernetClient::available()
+{
+	return m_pSocket && m_pSocket->boardOpen ? (int)m_pSocket->toBoard.size() : 0;
+}
+
+int EthernetClient::read()
+{
+	if (available() == 0)
+	{
+		return -1;
+	}
+	int c = (unsigned char)m_pSocket->toBoard[0];
+	m_pSocket->toBoard.erase(0, 1);
+	return c;
+}
+
+int EthernetClient::read(uint8_t *buffer, size_t size)
+{
+	size_t n = min(size, (size_t)available());
+	if (n == 0)
+	{
+		return -1;
+	}
+	memcpy(buffer, m_pSocket->toBoard.data(), n);
+	m_pSocket->toBoard.erase(0, n);
+	return (int)n;
+}
+
+int EthernetClient::peek()
+{
+	return available() ? (unsigned char)m_pSocket->toBoard[0] : -1;
+}
+
+void EthernetClient::stop()
+{
+	if (m_pSocket)
+	{
+		m_pSocket->boardOpen = false;
+		m_pSocket.reset();
+	}
+}
+
+uint8_t EthernetClient::connected()
+{
+	return m_pSocket && m_pSocket->boardOpen && (m_pSocket->peerOpen || !m_pSocket->toBoard.empty());
+}
+
+//EthernetServer
+EthernetClient EthernetServer::available()
+{
+	for (size_t i = 0; i < g_Inbound.size(); i++)
+	{
+		const hostsim::SocketPtr &socket = g_Inbound[i];
+		if (socket->port == m_nPort && socket->boardOpen && !socket->toBoard.empty())
+		{
+			return EthernetClient(socket);
+		}
+	}
+	return EthernetClient();
+}
+
+//EthernetClass
+EthernetLinkStatus EthernetClass::linkStatus()
+{
+	return g_bLinkUp ? LinkON : LinkOFF;
+}
@@ -0,0 +1,98 @@
+//******************************************************************************************
+//  File: Ethernet.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Mock of the Arduino Ethernet library (W5100/W5200/W5500 shields), for network code
+//			  built in the Linux host simulation.  EthernetClient and EthernetServer are ends of
+//			  the fake TCP connections a test controls through HostNet.h.  Like the real library:
+//				- connected() stays true while unread data is left, after the other end closed
+//				- EthernetServer::available() returns any open connection to its port that has
+//				  unread data - including one the sketch is already reading
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_ETHERNET_H
+#define HOSTSIM_ETHERNET_H
+
+#include "Arduino.h"
+#include "Client.h"
+#include "HostNet.h"
+
+enum EthernetLinkStatus
+{
+	Unknown,
+	LinkON,
+	LinkOFF
+};
+
+enum EthernetHardwareStatus
+{
+	EthernetNoHardware,
+	EthernetW5100,
+	EthernetW5200,
+	EthernetW5500
+};
+
+class EthernetClient : public Client
+{
+	private:
+		hostsim::SocketPtr m_pSocket;
+
+	public:
+		EthernetClient() {}
+		explicit EthernetClient(const hostsim::SocketPtr &socket) : m_pSocket(socket) {}
+
+		virtual int connect(IPAddress ip, uint16_t port);
+		virtual int connect(const char *host, uint16_t port);
+		virtual size_t write(uint8_t c);
+		virtual size_t write(const uint8_t *buffer, size_t size);
+		virtual int available();
+		virtual int read();
+		virtual int read(uint8_t *buffer, size_t size);
+		virtual int peek();
+		virtual void flush() {}
+		virtual void stop();
+		virtual uint8_t connected();
+		virtual operator bool() { return m_pSocket && m_pSocket->boardOpen; }
+		using Print::write;
+};
+
+class EthernetServer : public Print
+{
+	private:
+		uint16_t m_nPort;
+
+	public:
+		EthernetServer(uint16_t port) : m_nPort(port) {}
+		void begin() {}
+		EthernetClient available();
+		virtual size_t write(uint8_t c) { return write(&c, 1); }
+		virtual size_t write(const uint8_t *, size_t size) { return size; }	//to every client - not used by the library
+		using Print::write;
+};
+
+class EthernetClass
+{
+	public:
+		int begin(uint8_t *) { return 1; }
+		void begin(uint8_t *, IPAddress) {}
+		void begin(uint8_t *, IPAddress, IPAddress) {}
+		void begin(uint8_t *, IPAddress, IPAddress, IPAddress) {}
+		void begin(uint8_t *, IPAddress, IPAddress, IPAddress, IPAddress) {}
+		void init(uint8_t) {}
+		int maintain() { return 0; }
+		IPAddress localIP() { return IPAddress(192, 168, 1, 50); }
+		EthernetLinkStatus linkStatus();
+		EthernetHardwareStatus hardwareStatus() { return EthernetW5500; }
+};
+
+extern EthernetClass Ethernet;
+
+#endif
@@ -0,0 +1,57 @@
+//******************************************************************************************
+//  File: HostNet.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Controls for the fake TCP network behind the mock Ethernet library (Ethernet.h).
+//			  A test plays the other end of every connection - the hub the board POSTs to, and
+//			  the hub sending requests to the board's server - one Socket at a time:
+//				- the board's EthernetClient::connect() succeeds while setReachable(true) (the
+//				  default) and adds a Socket to outbound(); the test reads what the board wrote
+//				  from fromBoard and puts its reply in toBoard
+//				- connect() opens a Socket to the board's EthernetServer on a port; the test
+//				  writes the request into toBoard and reads the reply from fromBoard
+//				- closing the test's end (peerOpen = false) is a close by the hub - the board can
+//				  still read what is left in toBoard, but connected() turns false after that and
+//				  write() fails
+//			  Nothing here is thread safe - only use it from the thread that runs the board's code.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_HOSTNET_H
+#define HOSTSIM_HOSTNET_H
+
+#include "Arduino.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hostsim
+{
+	struct Socket
+	{
+		IPAddress ip;			//outbound: the address the board connected to
+		uint16_t port;			//outbound: the port the board connected to, inbound: the board's server port
+		std::string fromBoard;	//bytes written by the board
+		std::string toBoard;	//bytes the board has not read yet
+		bool boardOpen;			//false once the board has stop()ped its client
+		bool peerOpen;			//false once the test's end has closed
+
+		Socket() : port(0), boardOpen(true), peerOpen(true) {}
+	};
+	typedef std::shared_ptr<Socket> SocketPtr;
+
+	void setReachable(bool reachable);			//false - every outbound connect() fails (the hub is down)
+	const std::vector<SocketPtr> &outbound();	//every connection the board has opened, oldest first
+	SocketPtr connect(uint16_t port);			//opens a connection to the board's server on port
+	void setLinkUp(bool up);					//Ethernet.linkStatus() - LinkON (the default) or LinkOFF
+	void resetNetwork();						//forgets every connection, reachable and link up again
+}
+
+#endif
@@ -0,0 +1,72 @@
+//******************************************************************************************
+//  File: HostSim.h
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Controls for the mock Arduino core used by the Linux host simulation.
+//
+//			  Virtual clock - time starts at 0 and only moves when the simulation moves it.  The
+//			  clock itself is 64 bits wide; millis() and micros() return its low 32 bits, so
+//			  setMillis(0xFFFFFFFF - 10000) followed by advanceMillis(20000) runs through the
+//			  49 day millis() rollover in a fraction of a second.  delay() simply advances the clock.
+//
+//			  Pins - setDigital()/setAnalog() set what digitalRead()/analogRead() return;
+//			  getOutput() returns the last digitalWrite()/analogWrite() value, and an output
+//			  callback can watch every write as it happens.  triggerInterrupt() calls the ISR
+//			  given to attachInterrupt() for a pin.  digitalReadCount()/portReadCount() count the
+//			  digitalRead() and portInputRegister() calls, so a test can see how inputs are read.
+//
+//			  Traces - a trace is a text file of timed input changes, one per line:
+//					<ms> D <pin> <level>		digitalRead(pin) returns level from then on
+//					<ms> A <pin> <value>		analogRead(pin) returns value from then on
+//					<ms> I <pin> <level>		as D, and the pin's ISR (if any) is called
+//					<ms> HUB <message>			message is passed to the hub handler (e.g. "switch1 on")
+//				Times are milliseconds after the moment the trace is loaded; '#' starts a comment.
+//				runFor() applies the events as virtual time passes, so a replay gives exactly the
+//				same result every time.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Added digitalReadCount()/portReadCount()
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_HOSTSIM_H
+#define HOSTSIM_HOSTSIM_H
+
+#include "Arduino.h"
+
+namespace hostsim
+{
+	//virtual clock
+	void setMillis(unsigned long long ms);
+	void advanceMillis(unsigned long ms);
+	void advanceMicros(unsigned long us);
+	unsigned long long now();				//full width virtual time in microseconds (never wraps)
+
+	//pins
+	void setDigital(uint8_t pin, int level);
+	void setAnalog(uint8_t pin, int value);
+	int getOutput(uint8_t pin);
+	void setOutputCallback(void (*callback)(uint8_t pin, int value));	//called on every digitalWrite()/analogWrite()
+	void triggerInterrupt(uint8_t pin);
+	unsigned long digitalReadCount();
+	unsigned long portReadCount();
+
+	//traces
+	void setHubHandler(void (*handler)(const String &message));	//receives the HUB lines of a trace
+	bool loadTrace(const char *path);		//appends the events in path (returns false if it cannot be read)
+	void addEvent(unsigned long ms, char kind, int pin, int value);		//appends one D/A/I event, ms after now
+	void addHubEvent(unsigned long ms, const char *message);			//appends one HUB event, ms after now
+	unsigned int pendingEvents();
+	void applyDueEvents();					//applies every event whose time has come
+
+	//calls loop() repeatedly for ms milliseconds of virtual time, applying trace events and
+	//advancing the clock by stepMicros after each call
+	void runFor(unsigned long ms, void (*loop)(), unsigned long stepMicros = 1000);
+}
+
+#endif
@@ -0,0 +1,22 @@
+//******************************************************************************************
+//  File: IPAddress.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  The mock IPAddress lives in Arduino.h, as in the ESP cores - this header only
+//			  lets "#include <IPAddress.h>" compile.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_IPADDRESS_H
+#define HOSTSIM_IPADDRESS_H
+
+#include "Arduino.h"
+
+#endif
@@ -0,0 +1,22 @@
+//******************************************************************************************
+//  File: SPI.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Empty stand-in, so network libraries that include <SPI.h> for their shield build
+//			  in the Linux host simulation.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_SPI_H
+#define HOSTSIM_SPI_H
+
+#include "Arduino.h"
+
+#endif
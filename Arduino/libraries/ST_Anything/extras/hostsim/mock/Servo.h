@@ -0,0 +1,39 @@
+//******************************************************************************************
+//  File: Servo.h (hostsim)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Mock Servo library for the Linux host simulation - write() is recorded as an
+//			  analogWrite() of the angle on the attached pin, so it can be observed like any
+//			  other output.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_SERVO_H
+#define HOSTSIM_SERVO_H
+
+#include "Arduino.h"
+
+class Servo
+{
+	private:
+		int m_nPin;
+		int m_nAngle;
+
+	public:
+		Servo() : m_nPin(-1), m_nAngle(0) {}
+		uint8_t attach(int pin) { m_nPin = pin; return 1; }
+		uint8_t attach(int pin, int, int) { m_nPin = pin; return 1; }
+		void detach() { m_nPin = -1; }
+		bool attached() { return m_nPin >= 0; }
+		void write(int angle) { m_nAngle = angle; if (m_nPin >= 0) analogWrite(m_nPin, angle); }
+		int read() { return m_nAngle; }
+};
+
+#endif
@@ -0,0 +1,514 @@
+//******************************************************************************************
+//  File: st_benchmark.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Latency and throughput benchmark of the st::Everything::run() loop on the Linux
+//			  host simulation.  For each device count (10, 50 and 200 by default - half
+//			  IS_Contacts, a quarter PS_Voltages, a quarter EX_Switches) it measures:
+//				- loop_iterations_per_sec	host speed of run() with all devices idle
+//				- edge_to_send_us			virtual time from a contact's pin changing to its message
+//											reaching the transport's send()
+//				- command_to_output_ns		host time from a hub command arriving to the switch's
+//											digitalWrite(), across the run() pass that delivers it
+//											(in virtual time this is always 0 - no clock passes inside
+//											run(), and the first pass after a command always handles it)
+//				- queue_depth				message queue depth, sampled on every run() pass
+//				- allocs_per_message		heap allocations (operator new) per message sent
+//				- message_build				heap cost of building and queueing one message the way the
+//											devices did before st::Message (String concatenation, e.g.
+//											getName() + " " + String(value)) and with st::Message:
+//											allocations, bytes allocated and peak heap in use above
+//											the level before the call, for the host (allocs, bytes,
+//											peak_bytes) and for the AVR core's String (avr_*)
+//				- ns_per_*					host time of getDeviceByName(), of a hub command through
+//											receiveSmartString() and of a message through
+//											sendSmartString()/sendStrings() (both including one
+//											run() pass, see ns_per_idle_run)
+//
+//			  Each device count runs in its own process (st::Everything cannot remove devices) and
+//			  prints one JSON object per line, so the output can be compared between builds.
+//			  Latencies are in virtual time, so they only change if the library's behaviour does;
+//			  the ns_per_* and loop_iterations_per_sec figures depend on the host.
+//
+//			  Usage:  st_benchmark [--devices <n>[,<n>...]] [--transmit-ms <ms>] [--batch]
+//
+//			  Note:  the mock String is built on std::string, whose short string optimisation
+//			  avoids allocating for strings of up to 15 characters - allocs_per_message is a lower
+//			  bound of what an AVR or ESP build does.  The avr_* figures come from the mock String's
+//			  count of the heap the AVR core's String would use, which has no such optimisation
+//			  (the ESP8266/ESP32 cores' String does, for up to 11 characters).
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Added message_build (String concatenation versus st::Message) and heap byte counters
+//    2026-10-18  agent          command_to_output is measured in host time across the delivering run() pass (it was always 0 in virtual time)
+//    2026-10-18  agent          The device name buffer fits any device number (no -Wformat-truncation)
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <PS_Voltage.h>
+#include <IS_Contact.h>
+#include <EX_Switch.h>
+#include "SmartThingsLoopback.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//heap allocation counters - replace the global operator new for the whole program
+//(each block starts with a header that remembers its size, so operator delete can count the bytes freed)
+static unsigned long g_nAllocations = 0;
+static unsigned long g_nAllocatedBytes = 0;
+static unsigned long g_nLiveBytes = 0;
+static unsigned long g_nPeakLiveBytes = 0;
+static const size_t BLOCK_HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+	g_nAllocations++;
+	g_nAllocatedBytes += size;
+	g_nLiveBytes += size;
+	if (g_nLiveBytes > g_nPeakLiveBytes)
+	{
+		g_nPeakLiveBytes = g_nLiveBytes;
+	}
+	char *p = (char*)malloc(size + BLOCK_HEADER);
+	if (p == 0)
+	{
+		throw std::bad_alloc();
+	}
+	*(size_t*)p = size;
+	return p + BLOCK_HEADER;
+}
+
+void operator delete(void *p) noexcept
+{
+	if (p == 0)
+	{
+		return;
+	}
+	char *block = (char*)p - BLOCK_HEADER;
+	g_nLiveBytes -= *(size_t*)block;
+	free(block);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	operator delete(p);
+}
+
+namespace
+{
+	const unsigned long LOOP_STEP_US = 100;		//virtual time per run() pass
+	const byte FIRST_CONTACT_PIN = 2;
+	const byte FIRST_SWITCH_PIN = 150;
+	const byte VOLTAGE_PIN = 250;
+
+	struct Stats
+	{
+		std::vector<unsigned long long> samples;
+
+		void add(unsigned long long v) { samples.push_back(v); }
+
+		unsigned long long percentile(unsigned int pct)
+		{
+			if (samples.empty())
+			{
+				return 0;
+			}
+			std::sort(samples.begin(), samples.end());
+			size_t index = (samples.size() * pct + 99) / 100;
+			return samples[index == 0 ? 0 : index - 1];
+		}
+
+		void print(const char *name)
+		{
+			printf("\"%s\":{\"n\":%zu,\"p50\":%llu,\"p99\":%llu,\"max\":%llu}", name, samples.size(), percentile(50), percentile(99), percentile(100));
+		}
+	};
+
+	st::SmartThingsLoopback *loopback = 0;
+	std::vector<std::string> names;					//device names (the library keeps pointers to them)
+	std::vector<unsigned long long> pendingSince;	//per device - virtual time of the stimulus not yet answered (0 = none)
+	std::vector<std::chrono::steady_clock::time_point> commandStart;	//per switch device - host time its pending command arrived
+	unsigned int contactCount, voltageCount, switchCount;
+	Stats edgeToSend, commandToOutput;
+	unsigned long messagesSent = 0;
+
+	//heap cost of one way of building and queueing a message, averaged over BUILDS messages
+	struct BuildCost
+	{
+		double allocs;				//host operator new
+		double bytes;
+		unsigned long peakBytes;
+		double avrAllocs;			//the AVR core's String (the mock String's model of it)
+		double avrBytes;
+		unsigned long avrPeakBytes;
+
+		void print(const char *name)
+		{
+			printf("\"%s\":{\"allocs\":%.2f,\"bytes\":%.1f,\"peak_bytes\":%lu,\"avr_allocs\":%.2f,\"avr_bytes\":%.1f,\"avr_peak_bytes\":%lu}",
+				name, allocs, bytes, peakBytes, avrAllocs, avrBytes, avrPeakBytes);
+		}
+	};
+
+	template <typename Build> BuildCost measureBuild(Build build)
+	{
+		const unsigned long BUILDS = 1000;
+		unsigned long allocs = 0, bytes = 0, peak = 0;
+		unsigned long avrAllocs = 0, avrBytes = 0, avrPeak = 0;
+		for (unsigned long i = 0; i < BUILDS; i++)
+		{
+			unsigned long allocsBefore = g_nAllocations;
+			unsigned long bytesBefore = g_nAllocatedBytes;
+			unsigned long liveBefore = g_nLiveBytes;
+			g_nPeakLiveBytes = g_nLiveBytes;
+			unsigned long avrAllocsBefore = String::heapAllocations;
+			unsigned long avrBytesBefore = String::heapBytes;
+			unsigned long avrLiveBefore = String::heapLive;
+			String::heapPeak = String::heapLive;
+			build(i);
+			allocs += g_nAllocations - allocsBefore;
+			bytes += g_nAllocatedBytes - bytesBefore;
+			peak = max(peak, g_nPeakLiveBytes - liveBefore);
+			avrAllocs += String::heapAllocations - avrAllocsBefore;
+			avrBytes += String::heapBytes - avrBytesBefore;
+			avrPeak = max(avrPeak, String::heapPeak - avrLiveBefore);
+
+			st::Everything::run();		//sends it (not measured), so the queue never fills up
+			hostsim::advanceMicros(LOOP_STEP_US);
+		}
+		BuildCost cost = { (double)allocs / BUILDS, (double)bytes / BUILDS, peak, (double)avrAllocs / BUILDS, (double)avrBytes / BUILDS, avrPeak };
+		return cost;
+	}
+
+	unsigned long long sinceUs(unsigned long long start)
+	{
+		return hostsim::now() - start;
+	}
+
+	double hostNs(std::chrono::steady_clock::time_point start, unsigned long count)
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+	}
+
+	void onSend(const char *body)
+	{
+		//one transmission may hold several newline separated messages (batching)
+		const char *line = body;
+		while (*line != '\0')
+		{
+			const char *end = strchr(line, '\n');
+			size_t length = end ? (size_t)(end - line) : strlen(line);
+			size_t nameLength = 0;
+			while (nameLength < length && line[nameLength] != ' ')
+			{
+				nameLength++;
+			}
+			messagesSent++;
+
+			for (unsigned int i = 0; i < contactCount; i++)
+			{
+				if (pendingSince[i] != 0 && names[i].size() == nameLength && memcmp(names[i].c_str(), line, nameLength) == 0)
+				{
+					edgeToSend.add(sinceUs(pendingSince[i]));
+					pendingSince[i] = 0;
+					break;
+				}
+			}
+
+			if (end == 0)
+			{
+				break;
+			}
+			line = end + 1;
+		}
+	}
+
+	void onOutput(uint8_t pin, int)
+	{
+		if (pin < FIRST_SWITCH_PIN || pin >= FIRST_SWITCH_PIN + switchCount)
+		{
+			return;
+		}
+		unsigned int device = contactCount + voltageCount + (pin - FIRST_SWITCH_PIN);
+		if (pendingSince[device] != 0)
+		{
+			commandToOutput.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - commandStart[device]).count());
+			pendingSince[device] = 0;
+		}
+	}
+
+	int benchmark(unsigned int deviceCount, int transmitMs, bool batch)
+	{
+		switchCount = deviceCount / 4;
+		voltageCount = deviceCount / 4;
+		contactCount = deviceCount - switchCount - voltageCount;
+
+		loopback = new st::SmartThingsLoopback(st::receiveSmartString, transmitMs, false, false);
+		loopback->enableBatching(batch);
+		loopback->setOnSend(onSend);
+		st::Everything::SmartThing = loopback;
+		st::Everything::init();
+
+		names.reserve(deviceCount);
+		char name[sizeof("contact") + 10];		//the longest prefix and the largest unsigned int
+		for (unsigned int i = 0; i < deviceCount; i++)
+		{
+			if (i < contactCount)
+			{
+				snprintf(name, sizeof(name), "contact%u", i + 1);
+			}
+			else if (i < contactCount + voltageCount)
+			{
+				snprintf(name, sizeof(name), "voltage%u", i - contactCount + 1);
+			}
+			else
+			{
+				snprintf(name, sizeof(name), "switch%u", i - contactCount - voltageCount + 1);
+			}
+			names.push_back(name);
+		}
+		pendingSince.assign(deviceCount, 0);
+		commandStart.assign(deviceCount, std::chrono::steady_clock::time_point());
+
+		for (unsigned int i = 0; i < deviceCount; i++)
+		{
+			const __FlashStringHelper *n = F(names[i].c_str());
+			if (i < contactCount)
+			{
+				st::Everything::addSensor(new st::IS_Contact(n, FIRST_CONTACT_PIN + i, LOW, true));
+			}
+			else if (i < contactCount + voltageCount)
+			{
+				st::Everything::addSensor(new st::PS_Voltage(n, 30, (i % 30), VOLTAGE_PIN, 0, 1023, 0, 5));
+			}
+			else
+			{
+				st::Everything::addExecutor(new st::EX_Switch(n, FIRST_SWITCH_PIN + (i - contactCount - voltageCount), LOW, true));
+			}
+		}
+		st::Everything::initDevices();
+		hostsim::setOutputCallback(onOutput);
+
+		//1 - idle loop throughput
+		const unsigned long ITERATIONS = 200000;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < ITERATIONS; i++)
+		{
+			st::Everything::run();
+			hostsim::advanceMicros(LOOP_STEP_US);
+		}
+		double nsPerRun = hostNs(start, ITERATIONS);
+
+		//2 - latencies: every STIMULUS_MS one contact changes and one switch is commanded, round robin
+		const unsigned long DURATION_MS = 120000;
+		const unsigned long STIMULUS_MS = 257;	//not a multiple of the transmit interval, so stimuli land at every point of it
+		unsigned long long end = hostsim::now() + DURATION_MS * 1000ULL;
+		unsigned long long nextStimulus = hostsim::now();
+		unsigned int nextContact = 0, nextSwitch = 0;
+		unsigned long long depthSum = 0, depthSamples = 0;
+		uint16_t depthMax = 0;
+		unsigned long allocationsBefore = g_nAllocations;
+		unsigned long sentBefore = messagesSent;
+		while (hostsim::now() < end)
+		{
+			if (hostsim::now() >= nextStimulus)
+			{
+				nextStimulus += STIMULUS_MS * 1000ULL;
+
+				unsigned int contact = nextContact++ % contactCount;
+				if (pendingSince[contact] == 0)
+				{
+					hostsim::setDigital(FIRST_CONTACT_PIN + contact, !digitalRead(FIRST_CONTACT_PIN + contact));
+					pendingSince[contact] = hostsim::now();
+				}
+
+				if (switchCount > 0)
+				{
+					unsigned int sw = nextSwitch++ % switchCount;
+					unsigned int device = contactCount + voltageCount + sw;
+					if (pendingSince[device] == 0)
+					{
+						pendingSince[device] = hostsim::now();
+						String command = F(names[device].c_str());
+						command += hostsim::getOutput(FIRST_SWITCH_PIN + sw) ? F(" on") : F(" off");	//inverted logic - HIGH is off
+						loopback->receive(command);
+						commandStart[device] = std::chrono::steady_clock::now();	//delivered by the run() just below
+					}
+				}
+			}
+
+			st::Everything::run();
+			hostsim::advanceMicros(LOOP_STEP_US);
+
+			uint16_t depth = st::Everything::getMessageQueue().count();
+			depthSum += depth;
+			depthSamples++;
+			if (depth > depthMax)
+			{
+				depthMax = depth;
+			}
+		}
+		unsigned long allocations = g_nAllocations - allocationsBefore;
+		unsigned long sent = messagesSent - sentBefore;
+
+		//3 - host cost of the message paths (no throttling, so every run() pass sends what is queued)
+		loopback->setTransmitInterval(0);
+		const unsigned long CALLS = 100000;
+		volatile unsigned long found = 0;
+		start = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < CALLS; i++)
+		{
+			const std::string &n = names[i % deviceCount];
+			found += st::Everything::getDeviceByName(n.c_str(), n.size()) != 0;
+		}
+		double nsPerLookup = hostNs(start, CALLS);
+
+		start = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < CALLS; i++)
+		{
+			st::Everything::run();
+			hostsim::advanceMicros(LOOP_STEP_US);
+		}
+		double nsPerIdleRun = hostNs(start, CALLS);
+
+		double nsPerCommand = 0;
+		if (switchCount > 0)
+		{
+			String commands[2];
+			commands[0] = F(names[contactCount + voltageCount].c_str());
+			commands[0] += F(" on");
+			commands[1] = F(names[contactCount + voltageCount].c_str());
+			commands[1] += F(" off");
+			start = std::chrono::steady_clock::now();
+			for (unsigned long i = 0; i < CALLS; i++)
+			{
+				st::receiveSmartString(commands[i & 1]);
+				st::Everything::run();
+				hostsim::advanceMicros(LOOP_STEP_US);
+			}
+			nsPerCommand = hostNs(start, CALLS);
+		}
+
+		start = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < CALLS; i++)
+		{
+			st::Everything::sendSmartString("voltage1 2.50", 13);
+			st::Everything::run();
+			hostsim::advanceMicros(LOOP_STEP_US);
+		}
+		double nsPerMessage = hostNs(start, CALLS);
+
+		//4 - heap cost of building a message: the String concatenation the devices used before st::Message, and st::Message
+		//(same values, so both produce the same text)
+		st::Device *voltage = st::Everything::getDeviceByName("voltage1", 8);
+		st::Device *contact = st::Everything::getDeviceByName("contact1", 8);
+		String temperatureName("temperature1");		//PS_TemperatureHumidity keeps its attribute names in Strings
+		BuildCost voltageString = measureBuild([&](unsigned long i) { st::Everything::sendSmartString(voltage->getName() + " " + String(2.5f + i % 100 / 100.0f)); });
+		BuildCost voltageMessage = measureBuild([&](unsigned long i) { st::Message(voltage->getNameF()).value(2.5f + i % 100 / 100.0f).send(); });
+		BuildCost temperatureString = measureBuild([&](unsigned long i) { st::Everything::sendSmartString(temperatureName + " " + String(72.5f + i % 100 / 100.0f)); });
+		BuildCost temperatureMessage = measureBuild([&](unsigned long i) { st::Message(temperatureName).value(72.5f + i % 100 / 100.0f).send(); });
+		BuildCost contactString = measureBuild([&](unsigned long i) { st::Everything::sendSmartString(contact->getName() + (i & 1 ? F(" closed") : F(" open"))); });
+		BuildCost contactMessage = measureBuild([&](unsigned long i) { st::Message(contact->getNameF()).value(i & 1 ? F("closed") : F("open")).send(); });
+
+		printf("{\"devices\":%u,\"contacts\":%u,\"voltages\":%u,\"switches\":%u,\"transmit_ms\":%d,\"batch\":%s,",
+			deviceCount, contactCount, voltageCount, switchCount, transmitMs, batch ? "true" : "false");
+		printf("\"loop_iterations_per_sec\":%.0f,", 1e9 / nsPerRun);
+		edgeToSend.print("edge_to_send_us");
+		printf(",");
+		commandToOutput.print("command_to_output_ns");
+		printf(",\"queue_depth\":{\"mean\":%.2f,\"max\":%u,\"capacity\":%u},", depthSamples ? (double)depthSum / depthSamples : 0.0, depthMax, st::Everything::getMessageQueue().capacity());
+		printf("\"messages_sent\":%lu,\"dropped\":%lu,\"allocs_per_message\":%.2f,", sent, st::Everything::getMessageQueue().getDropCount(), sent ? (double)allocations / sent : 0.0);
+		printf("\"ns_per_getDeviceByName\":%.1f,\"ns_per_idle_run\":%.1f,\"ns_per_receiveSmartString\":%.1f,\"ns_per_sendSmartString\":%.1f,",
+			nsPerLookup, nsPerIdleRun, nsPerCommand, nsPerMessage);
+		printf("\"message_build\":{\"voltage\":{");
+		voltageString.print("string");
+		printf(",");
+		voltageMessage.print("message");
+		printf("},\"temperature\":{");
+		temperatureString.print("string");
+		printf(",");
+		temperatureMessage.print("message");
+		printf("},\"contact\":{");
+		contactString.print("string");
+		printf(",");
+		contactMessage.print("message");
+		printf("}}}\n");
+		fflush(stdout);
+		return found == CALLS ? 0 : 1;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<unsigned int> counts;
+	int transmitMs = 100;
+	bool batch = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--devices") == 0 && i + 1 < argc)
+		{
+			for (char *p = strtok(argv[++i], ","); p != 0; p = strtok(0, ","))
+			{
+				counts.push_back(strtoul(p, 0, 10));
+			}
+		}
+		else if (strcmp(argv[i], "--transmit-ms") == 0 && i + 1 < argc)
+		{
+			transmitMs = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--batch") == 0)
+		{
+			batch = true;
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [--devices <n>[,<n>...]] [--transmit-ms <ms>] [--batch]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (counts.empty())
+	{
+		counts.push_back(10);
+		counts.push_back(50);
+		counts.push_back(200);
+	}
+
+	int result = 0;
+	for (size_t i = 0; i < counts.size(); i++)
+	{
+		if (counts[i] < 4 || counts[i] > ST_MAX_SENSOR_COUNT)
+		{
+			fprintf(stderr, "device count %u must be between 4 and %u\n", counts[i], (unsigned int)ST_MAX_SENSOR_COUNT);
+			return 2;
+		}
+
+		//st::Everything is static - each device count gets a fresh process
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			_exit(benchmark(counts[i], transmitMs, batch));
+		}
+		int status = 1;
+		waitpid(pid, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		{
+			result = 1;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,230 @@
+//******************************************************************************************
+//  File: st_hostsim.cpp
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Runs a typical ST_Anything sketch (voltage, contact, motion and switch) on the
+//			  Linux host against the mock Arduino core, replays a trace of input changes and hub
+//			  commands, and prints every transmission with its virtual time.
+//
+//			  Usage:  st_hostsim [--trace <file>] [--seconds <n>] [--start-millis <ms>] [--debug] [--task] [--udp] [--loss <percent>]
+//								 [--outage <from>:<to>] [--eeprom <file>]
+//				--trace			trace to replay (default: traces/example.trace)
+//				--seconds		virtual seconds to run (default 180)
+//				--start-millis	millis() value to start at (default one minute before the 49 day
+//								rollover, so every run crosses it)
+//				--debug			turns on st::Everything::debug and echoes Serial to stdout
+//				--task			runs the loopback transport behind SmartThingsTask, in its own thread
+//								(the transmission times then depend on thread scheduling)
+//				--udp			uses st::SmartThingsUdp against a UDP loopback Hub (UdpLoopback) instead of
+//								the loopback transport - the times printed are when the Hub received each message
+//				--loss			with --udp, loses this percentage of the datagrams in each direction
+//				--outage		takes the loopback transport's link down from <from> to <to> seconds into the run -
+//								messages are spooled (st::MessageSpool, in the mock EEPROM) and replayed afterwards
+//				--eeprom		loads the mock EEPROM from this file before the run and saves it afterwards, so a
+//								second run finds the messages a first one left in the spool (a "restart")
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Added --task
+//    2026-10-18  agent          Added --udp and --loss
+//    2026-10-18  agent          Added --outage and --eeprom
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <PS_Voltage.h>
+#include <IS_Contact.h>
+#include <IS_Motion.h>
+#include <EX_Switch.h>
+#include <SmartThingsTask.h>
+#include <EEPROM.h>
+#include "SmartThingsLoopback.h"
+#include "UdpLoopback.h"
+
+#define PIN_VOLTAGE_1		A0
+#define PIN_CONTACT_1		3
+#define PIN_MOTION_1		4
+#define PIN_SWITCH_1		5
+
+#ifndef HOSTSIM_DEFAULT_TRACE
+	#define HOSTSIM_DEFAULT_TRACE "traces/example.trace"
+#endif
+
+static st::SmartThingsLoopback *loopback = 0;
+static st::SmartThingsUdp<UdpLoopback> *udp = 0;
+static unsigned long long outageFrom = 0;	//virtual time (hostsim::now()) the link goes down
+static unsigned long long outageTo = 0;		//virtual time it comes back
+
+static void hubMessage(const String &message)
+{
+	if (udp != 0)
+	{
+		udp->getUdp().sendCommand(message);
+	}
+	else
+	{
+		loopback->receive(message);
+	}
+}
+
+static void loop()
+{
+	if (loopback != 0 && outageTo > outageFrom)
+	{
+		unsigned long long now = hostsim::now();
+		loopback->setLinkUp(now < outageFrom || now >= outageTo);
+	}
+	st::Everything::run();
+}
+
+int main(int argc, char *argv[])
+{
+	const char *trace = HOSTSIM_DEFAULT_TRACE;
+	unsigned long seconds = 180;
+	unsigned long long startMillis = 0xFFFFFFFFULL - 60000;
+	bool task = false;
+	bool useUdp = false;
+	unsigned int loss = 0;
+	unsigned long outageStart = 0;
+	unsigned long outageEnd = 0;
+	const char *eeprom = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+		{
+			trace = argv[++i];
+		}
+		else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+		{
+			seconds = strtoul(argv[++i], 0, 10);
+		}
+		else if (strcmp(argv[i], "--start-millis") == 0 && i + 1 < argc)
+		{
+			startMillis = strtoull(argv[++i], 0, 0);
+		}
+		else if (strcmp(argv[i], "--debug") == 0)
+		{
+			st::Everything::debug = true;
+			Serial.echo = true;
+		}
+		else if (strcmp(argv[i], "--task") == 0)
+		{
+			task = true;
+		}
+		else if (strcmp(argv[i], "--udp") == 0)
+		{
+			useUdp = true;
+		}
+		else if (strcmp(argv[i], "--loss") == 0 && i + 1 < argc)
+		{
+			loss = strtoul(argv[++i], 0, 10);
+		}
+		else if (strcmp(argv[i], "--outage") == 0 && i + 1 < argc && sscanf(argv[i + 1], "%lu:%lu", &outageStart, &outageEnd) == 2 && outageEnd > outageStart)
+		{
+			i++;
+		}
+		else if (strcmp(argv[i], "--eeprom") == 0 && i + 1 < argc)
+		{
+			eeprom = argv[++i];
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [--trace <file>] [--seconds <n>] [--start-millis <ms>] [--debug] [--task] [--udp] [--loss <percent>] [--outage <from>:<to>] [--eeprom <file>]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (useUdp && outageEnd > 0)
+	{
+		fprintf(stderr, "--outage only works with the loopback transport, not with --udp\n");
+		return 2;
+	}
+
+	hostsim::setMillis(startMillis);
+	outageFrom = hostsim::now() + outageStart * 1000000ULL;
+	outageTo = hostsim::now() + outageEnd * 1000000ULL;
+	if (eeprom != 0)
+	{
+		EEPROM.load(eeprom);	//a missing file is an erased EEPROM
+	}
+
+	//the sketch's setup()
+	static st::PS_Voltage sensor1(F("voltage1"), 15, 0, PIN_VOLTAGE_1, 0, 1023, 0, 5);
+	static st::IS_Contact sensor2(F("contact1"), PIN_CONTACT_1, LOW, true);
+	static st::IS_Motion sensor3(F("motion1"), PIN_MOTION_1, HIGH, false);
+	static st::EX_Switch executor1(F("switch1"), PIN_SWITCH_1, LOW, true);
+
+	st::SmartThings *transport;
+	if (useUdp)
+	{
+		IPAddress hubIP(192, 168, 1, 100);
+		udp = new st::SmartThingsUdp<UdpLoopback>(8090, hubIP, 39501, st::receiveSmartString, "UDP", st::Everything::debug, 100);
+		udp->getUdp().setHub(hubIP, 39501);
+		udp->getUdp().setLoss(loss);
+		udp->getUdp().setKeep(false);
+		udp->getUdp().setPrint(true);
+		transport = udp;
+	}
+	else
+	{
+		loopback = new st::SmartThingsLoopback(st::receiveSmartString, 100, false, true);
+		transport = loopback;
+	}
+	st::SmartThingsTask *networkTask = task ? new st::SmartThingsTask(transport, -1, st::Everything::debug) : 0;
+	st::Everything::SmartThing = task ? static_cast<st::SmartThings*>(networkTask) : transport;
+	st::Everything::init();
+	st::Everything::addSensor(&sensor1);
+	st::Everything::addSensor(&sensor2);
+	st::Everything::addSensor(&sensor3);
+	st::Everything::addExecutor(&executor1);
+	st::Everything::initDevices();
+
+	hostsim::setHubHandler(hubMessage);
+	if (!hostsim::loadTrace(trace))
+	{
+		fprintf(stderr, "cannot read trace %s\n", trace);
+		return 1;
+	}
+
+	//the sketch's loop()
+	hostsim::runFor(seconds * 1000, loop);
+
+	if (networkTask != 0)
+	{
+		networkTask->stop();
+		printf("network task: %u messages not sent, %lu dropped, %lu hub commands dropped\n",
+			networkTask->getOutboundCount(), networkTask->getOutboundDropped(), networkTask->getInboundDropped());
+	}
+
+	if (udp != 0)
+	{
+		UdpLoopback &hub = udp->getUdp();
+		printf("udp: %lu messages sent, %lu retransmitted, %lu lost, %u not acknowledged; %lu commands delivered, %lu retransmitted, %u not acknowledged; %lu duplicates ignored by the hub, %lu by the device; %lu datagrams lost\n",
+			udp->getSentCount(), udp->getRetransmitCount(), udp->getLostCount(), udp->getPendingCount(),
+			udp->getCommandCount(), hub.getCommandRetransmits(), hub.getUnacknowledgedCommands(),
+			hub.getDuplicates(), udp->getDuplicateCount(), hub.getLost());
+	}
+
+	if (outageEnd > 0 || eeprom != 0)
+	{
+		const st::MessageSpool &spool = st::Everything::getMessageSpool();
+		printf("spool: %lu messages spooled, %lu replayed, %lu dropped, %u left; %lu lost while the link was down; eeprom: %lu bytes written, at most %lu times each\n",
+			spool.getSpooledCount(), spool.getReplayedCount(), spool.getDropCount(), spool.count(),
+			loopback != 0 ? loopback->getLostCount() : 0, EEPROM.getTotalWriteCount(), EEPROM.getMaxWriteCount());
+	}
+	if (eeprom != 0 && !EEPROM.save(eeprom))
+	{
+		fprintf(stderr, "cannot write %s\n", eeprom);
+	}
+
+	printf("done: millis()=%lu, switch1 output=%d, %u trace events not reached\n",
+		millis(), hostsim::getOutput(PIN_SWITCH_1), hostsim::pendingEvents());
+	return 0;
+}
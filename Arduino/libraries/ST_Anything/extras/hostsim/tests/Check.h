@@ -0,0 +1,53 @@
+//******************************************************************************************
+//  File: Check.h (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  The few lines of test harness the hostsim tests share.  CHECK() prints the file,
+//			  line and expression of every failed check and carries on; a test's main() ends
+//			  with "return checkResult();", which is non-zero (so ctest reports a failure) if
+//			  any check failed.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#ifndef HOSTSIM_CHECK_H
+#define HOSTSIM_CHECK_H
+
+#include <stdio.h>
+
+namespace hostsim
+{
+	inline unsigned int &checkFailures()
+	{
+		static unsigned int failures = 0;
+		return failures;
+	}
+
+	inline int checkResult()
+	{
+		if (checkFailures() == 0)
+		{
+			printf("all checks passed\n");
+			return 0;
+		}
+		printf("%u check(s) failed\n", checkFailures());
+		return 1;
+	}
+}
+
+#define CHECK(expr) \
+	do { \
+		if (!(expr)) \
+		{ \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+			hostsim::checkFailures()++; \
+		} \
+	} while (0)
+
+#endif
@@ -0,0 +1,76 @@
+//******************************************************************************************
+//  File: test_auto_phase.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Everything::autoPhase - PollingSensors created with PollingSensor::OFFSET_AUTO
+//			  get spread out offsets, a sensor created with offset 0 keeps it, and a sensor whose
+//			  OFFSET_AUTO is never planned (autoPhase off) polls as if created with offset 0.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <PollingSensor.h>
+#include "SmartThingsLoopback.h"
+#include "Check.h"
+
+namespace
+{
+	class TestSensor : public st::PollingSensor
+	{
+		public:
+			TestSensor(const __FlashStringHelper *name, long interval, long offset) : PollingSensor(name, interval, offset) {}
+			virtual void getData() {}
+	};
+
+	const long INTERVAL = 60;	//seconds
+}
+
+int main()
+{
+	static TestSensor auto1(F("auto1"), INTERVAL, st::PollingSensor::OFFSET_AUTO);
+	static TestSensor pinned0(F("pinned0"), INTERVAL, 0);
+	static TestSensor auto2(F("auto2"), INTERVAL, st::PollingSensor::OFFSET_AUTO);
+	static TestSensor pinned5(F("pinned5"), INTERVAL, 5);
+	static TestSensor auto3(F("auto3"), INTERVAL, st::PollingSensor::OFFSET_AUTO);
+	CHECK(auto1.getOffset() == 0 && pinned5.getOffset() == 5000);
+
+	st::SmartThingsLoopback loopback(st::receiveSmartString, 100);
+	st::Everything::SmartThing = &loopback;
+	st::Everything::autoPhase = true;
+	st::Everything::init();
+	st::Everything::addSensor(&auto1);
+	st::Everything::addSensor(&pinned0);
+	st::Everything::addSensor(&auto2);
+	st::Everything::addSensor(&pinned5);
+	st::Everything::addSensor(&auto3);
+	st::Everything::initDevices();
+
+	//first deadlines are interval + offset from the end of initDevices()
+	unsigned long start = pinned0.getNextPoll() - INTERVAL * 1000;
+	CHECK(pinned5.getNextPoll() - start == INTERVAL * 1000 + 5000);
+	unsigned long phases[] = { auto1.getNextPoll() - start, auto2.getNextPoll() - start, auto3.getNextPoll() - start, INTERVAL * 1000, INTERVAL * 1000 + 5000 };
+	for (int i = 0; i < 3; i++)
+	{
+		CHECK(phases[i] >= (unsigned long)INTERVAL * 1000 && phases[i] < (unsigned long)INTERVAL * 2000);
+		for (int j = i + 1; j < 5; j++)
+		{
+			CHECK(phases[i] != phases[j]);	//every planned sensor got an offset of its own, away from the pinned ones
+		}
+	}
+
+	//never planned - OFFSET_AUTO is offset 0
+	TestSensor unplanned(F("unplanned"), INTERVAL, st::PollingSensor::OFFSET_AUTO);
+	unplanned.update();
+	CHECK(unplanned.getNextPoll() == millis() + INTERVAL * 1000);
+
+	return hostsim::checkResult();
+}
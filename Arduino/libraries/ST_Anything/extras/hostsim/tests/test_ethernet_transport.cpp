@@ -0,0 +1,139 @@
+//******************************************************************************************
+//  File: test_ethernet_transport.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  SmartThingsEthernetW5x00 (the SmartThingsHttpTransport core on the fake Ethernet
+//			  library) end to end - a request from the hub reaches the callout and is answered,
+//			  send() becomes a POST to the hub, a hub outage trips the circuit breaker (and the
+//			  message is handed back to st::Everything), a cable pull takes isLinkUp() down, and
+//			  messages are delivered again once the hub is back.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <HostNet.h>
+#include <SmartThingsEthernetW5x00.h>
+#include "Check.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	const uint16_t SERVER_PORT = 8090;
+	const char OK[] = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+
+	std::vector<std::string> g_Commands;
+	void callout(String message)
+	{
+		g_Commands.push_back(message.c_str());
+	}
+
+	//runs the transport until it is ready to send again, answering every request the hub has been sent
+	void runUntilReady(st::SmartThingsEthernetW5x00 &transport, int steps = 120000)
+	{
+		for (int i = 0; i < steps && !transport.isReadyToSend(); i++)
+		{
+			transport.run();
+			const std::vector<hostsim::SocketPtr> &hub = hostsim::outbound();
+			if (!hub.empty() && hub.back()->toBoard.empty() && hub.back()->fromBoard.size() > 4 &&
+				hub.back()->fromBoard.compare(hub.back()->fromBoard.size() - 1, 1, "\n") != 0)
+			{
+				hub.back()->toBoard = OK;		//the whole request has been written (the body does not end the way a header does)
+			}
+			hostsim::advanceMillis(1);
+		}
+	}
+
+	bool hubReceived(const char *message)
+	{
+		for (size_t i = 0; i < hostsim::outbound().size(); i++)
+		{
+			if (hostsim::outbound()[i]->fromBoard.find(message) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+int main()
+{
+	byte mac[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED };
+	st::SmartThingsEthernetW5x00 transport(mac, IPAddress(192, 168, 1, 50), IPAddress(192, 168, 1, 1), IPAddress(255, 255, 255, 0), IPAddress(192, 168, 1, 1), SERVER_PORT, IPAddress(192, 168, 1, 2), 39500, callout);
+	const st::HubHealth &health = *transport.getHubHealth();
+	transport.init();
+	CHECK(transport.isLinkUp() && transport.isReadyToSend());
+
+	//a command from the hub reaches the callout, and is answered
+	hostsim::SocketPtr request = hostsim::connect(SERVER_PORT);
+	request->toBoard = "POST /switch1%20on? HTTP/1.1\r\nHOST: 192.168.1.50:8090\r\n\r\n";
+	transport.run();
+	CHECK(g_Commands.size() == 1 && g_Commands[0] == "switch1 on");
+	CHECK(request->fromBoard.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+	transport.run();
+	CHECK(!request->boardOpen);
+
+	//send() is a POST to the hub
+	transport.send("switch1 on");
+	CHECK(!transport.isReadyToSend());		//in progress
+	runUntilReady(transport);
+	CHECK(transport.isReadyToSend());
+	CHECK(hostsim::outbound().size() == 1);
+	hostsim::SocketPtr hub = hostsim::outbound().back();
+	CHECK(hub->ip == IPAddress(192, 168, 1, 2) && hub->port == 39500);
+	CHECK(hub->fromBoard.compare(0, 16, "POST / HTTP/1.1\r") == 0);
+	CHECK(hubReceived("\r\n\r\nswitch1 on"));
+	CHECK(health.getSuccessCount() == 1);
+
+	//the hub goes down - the POST fails, is retried after a backoff and trips the breaker, and is handed back
+	hub->peerOpen = false;
+	hostsim::setReachable(false);
+	transport.send("contact1 open");
+	for (int i = 0; i < 120000 && health.getState() != st::HubHealth::Open; i++)
+	{
+		transport.run();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(health.getState() == st::HubHealth::Open && health.getTripCount() == 1);
+	CHECK(!transport.isLinkUp() && !transport.isReadyToSend());
+	String undelivered;
+	CHECK(transport.popUndelivered(undelivered) && undelivered == "contact1 open");
+
+	//meanwhile commands from the hub still arrive
+	request = hostsim::connect(SERVER_PORT);
+	request->toBoard = "POST /refresh? HTTP/1.1\r\n\r\n";
+	transport.run();
+	CHECK(g_Commands.size() == 2 && g_Commands[1] == "refresh");
+
+	//the hub is back - once the backoff has passed the next message is the probe, which closes the breaker
+	hostsim::setReachable(true);
+	runUntilReady(transport);
+	CHECK(transport.isLinkUp() && health.getState() == st::HubHealth::Open);
+	unsigned long probes = health.getProbeCount();
+	transport.send("contact1 closed");
+	CHECK(health.getState() == st::HubHealth::HalfOpen);
+	runUntilReady(transport);
+	CHECK(health.getState() == st::HubHealth::Closed && health.getProbeCount() == probes + 1);
+	CHECK(hubReceived("contact1 closed"));
+	transport.send("contact1 open");
+	runUntilReady(transport);
+	CHECK(hubReceived("contact1 open"));
+
+	//a cable pull takes the link down, whatever the hub's health
+	hostsim::setLinkUp(false);
+	CHECK(!transport.isLinkUp());
+	hostsim::setLinkUp(true);
+	CHECK(transport.isLinkUp());
+
+	return hostsim::checkResult();
+}
@@ -0,0 +1,116 @@
+//******************************************************************************************
+//  File: test_gpio_snapshot.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::GpioSnapshot against the mock core's AVR style port registers - polled
+//			  InterruptSensors take their pins from one read of each used port per pass through
+//			  st::Everything::run(), never from digitalRead(), and a level change is only seen
+//			  after the next capture().
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <GpioSnapshot.h>
+#include <IS_Contact.h>
+#include "SmartThingsLoopback.h"
+#include "Check.h"
+
+#include <string>
+
+namespace
+{
+	//contact1-3 share port 1 (pins 0-7), contact4 is alone on port 2 (pins 8-15)
+	const byte PIN_CONTACT_1 = 2;
+	const byte PIN_CONTACT_2 = 3;
+	const byte PIN_CONTACT_3 = 5;
+	const byte PIN_CONTACT_4 = 10;
+	const unsigned long USED_PORTS = 2;
+
+	bool sent(st::SmartThingsLoopback &loopback, const char *message)
+	{
+		for (size_t i = 0; i < loopback.getSent().size(); i++)
+		{
+			if (loopback.getSent()[i].body.find(message) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+int main()
+{
+	//pins and ports
+	byte port;
+	st::GpioSnapshot::Mask mask;
+	CHECK(st::GpioSnapshot::registerPin(PIN_CONTACT_1, port, mask));
+	CHECK(port == 1 && mask == 0x04);
+	CHECK(st::GpioSnapshot::registerPin(PIN_CONTACT_4, port, mask));
+	CHECK(port == 2 && mask == 0x04);
+	CHECK(!st::GpioSnapshot::registerPin(NUM_DIGITAL_PINS, port, mask));
+	CHECK(port == st::GpioSnapshot::NO_PORT);
+
+	//the sketch
+	hostsim::setDigital(PIN_CONTACT_1, HIGH);
+	hostsim::setDigital(PIN_CONTACT_2, HIGH);
+	hostsim::setDigital(PIN_CONTACT_3, HIGH);
+	hostsim::setDigital(PIN_CONTACT_4, HIGH);
+	static st::IS_Contact contact1(F("contact1"), PIN_CONTACT_1, LOW, true);
+	static st::IS_Contact contact2(F("contact2"), PIN_CONTACT_2, LOW, true);
+	static st::IS_Contact contact3(F("contact3"), PIN_CONTACT_3, LOW, true);
+	static st::IS_Contact contact4(F("contact4"), PIN_CONTACT_4, LOW, true);
+	st::SmartThingsLoopback loopback(st::receiveSmartString, 100);
+	st::Everything::SmartThing = &loopback;
+	st::Everything::init();
+	st::Everything::addSensor(&contact1);
+	st::Everything::addSensor(&contact2);
+	st::Everything::addSensor(&contact3);
+	st::Everything::addSensor(&contact4);
+	st::Everything::initDevices();
+	CHECK(sent(loopback, "contact1 open"));
+	CHECK(sent(loopback, "contact4 open"));
+
+	//one read of each used port per run(), no digitalRead()
+	const unsigned long RUNS = 100;
+	unsigned long digitalReads = hostsim::digitalReadCount();
+	unsigned long portReads = hostsim::portReadCount();
+	for (unsigned long i = 0; i < RUNS; i++)
+	{
+		st::Everything::run();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(hostsim::digitalReadCount() == digitalReads);
+	CHECK(hostsim::portReadCount() - portReads == RUNS * USED_PORTS);
+
+	//every sensor sees the inputs as they were at the capture
+	st::GpioSnapshot::registerPin(PIN_CONTACT_2, port, mask);
+	st::GpioSnapshot::capture();
+	hostsim::setDigital(PIN_CONTACT_2, LOW);
+	CHECK(st::GpioSnapshot::read(PIN_CONTACT_2, port, mask) == HIGH);
+	st::GpioSnapshot::capture();
+	CHECK(st::GpioSnapshot::read(PIN_CONTACT_2, port, mask) == LOW);
+
+	//and the sensors still follow their pins
+	loopback.clearSent();
+	hostsim::setDigital(PIN_CONTACT_4, LOW);
+	for (unsigned long i = 0; i < 500; i++)
+	{
+		st::Everything::run();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(sent(loopback, "contact2 closed"));
+	CHECK(sent(loopback, "contact4 closed"));
+	CHECK(!sent(loopback, "contact1 closed"));
+
+	return hostsim::checkResult();
+}
@@ -0,0 +1,197 @@
+//******************************************************************************************
+//  File: test_http_client.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::HttpPostClient<EthernetClient> against the fake network - a POST goes through
+//			  Connecting, Writing and AwaitingResponse one run() at a time, a reply that arrives in
+//			  pieces is put together, and a POST that cannot connect, whose reply never comes or
+//			  whose connection is closed before the reply is completed with the matching result.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <HostNet.h>
+#include <Ethernet.h>
+#include <SmartThingsHttpClient.h>
+#include "Check.h"
+
+#include <string>
+
+namespace
+{
+	typedef st::HttpPostClient<EthernetClient> PostClient;
+
+	const IPAddress HUB_IP(192, 168, 1, 2);
+	const uint16_t HUB_PORT = 39500;
+	const char OK[] = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+
+	int g_nResult;
+	int g_nCalls;
+
+	void onComplete(void *context, int result)
+	{
+		*static_cast<int*>(context) += 1;
+		g_nResult = result;
+		g_nCalls++;
+	}
+
+	//runs the client until it is idle again, at most steps times, 1 ms apart
+	void runUntilIdle(PostClient &client, int steps = 5000)
+	{
+		for (int i = 0; i < steps && !client.isIdle(); i++)
+		{
+			client.run();
+			hostsim::advanceMillis(1);
+		}
+	}
+
+	bool bodyEnds(const hostsim::SocketPtr &socket, const std::string &body)
+	{
+		return socket->fromBoard.size() >= body.size() && socket->fromBoard.compare(socket->fromBoard.size() - body.size(), body.size(), body) == 0;
+	}
+}
+
+int main()
+{
+	//a POST, one step per run()
+	{
+		PostClient client(HUB_IP, HUB_PORT);
+		int calls = 0;
+		CHECK(client.isReady());
+		CHECK(client.post("contact1 open", onComplete, &calls));
+		CHECK(client.getState() == PostClient::Connecting);
+		CHECK(!client.post("contact2 open"));		//one request at a time
+		client.run();
+		CHECK(client.getState() == PostClient::Writing);
+		CHECK(hostsim::outbound().size() == 1);
+		hostsim::SocketPtr hub = hostsim::outbound().back();
+		CHECK(hub->ip == HUB_IP && hub->port == HUB_PORT);
+		client.run();
+		CHECK(client.getState() == PostClient::AwaitingResponse);
+		CHECK(hub->fromBoard.compare(0, 16, "POST / HTTP/1.1\r") == 0);
+		CHECK(hub->fromBoard.find("CONTENT-LENGTH: 13\r\n") != std::string::npos);
+		CHECK(bodyEnds(hub, "\r\n\r\ncontact1 open"));
+
+		//the reply arrives in pieces
+		for (int i = 0; i < 10; i++)
+		{
+			client.run();
+		}
+		CHECK(client.getState() == PostClient::AwaitingResponse);
+		hub->toBoard = "HTTP/1.1 2";
+		client.run();
+		hub->toBoard = "00 OK\r\nContent-Len";
+		client.run();
+		CHECK(client.getState() == PostClient::AwaitingResponse && calls == 0);
+		hub->toBoard = "gth: 2\r\n\r\no";
+		client.run();
+		CHECK(client.getState() == PostClient::AwaitingResponse);
+		hub->toBoard = "k";
+		client.run();
+		runUntilIdle(client);
+		CHECK(calls == 1 && g_nResult == 200);
+		CHECK(client.getHealth().getSuccessCount() == 1);
+	}
+
+	//a body longer than HTTP_WRITE_CHUNK is written over several run() passes
+	{
+		hostsim::resetNetwork();
+		PostClient client(HUB_IP, HUB_PORT);
+		std::string body;
+		for (int i = 0; i < 40; i++)
+		{
+			body += "temperature1 72.50\n";
+		}
+		CHECK(body.size() > HTTP_WRITE_CHUNK);
+		CHECK(client.post(body.c_str()));
+		client.run();
+		client.run();
+		CHECK(client.getState() == PostClient::Writing);
+		while (client.getState() == PostClient::Writing)
+		{
+			client.run();
+		}
+		CHECK(bodyEnds(hostsim::outbound().back(), body));
+		hostsim::outbound().back()->toBoard = OK;
+		runUntilIdle(client);
+		CHECK(client.isIdle());
+	}
+
+	//no reply within the timeout
+	{
+		hostsim::resetNetwork();
+		PostClient client(HUB_IP, HUB_PORT, 500);
+		int calls = 0;
+		CHECK(client.post("switch1 on", onComplete, &calls));
+		runUntilIdle(client, 499);
+		CHECK(calls == 0);
+		runUntilIdle(client);
+		CHECK(calls == 1 && g_nResult == st::HTTP_TIMEOUT);
+		CHECK(!client.isConnected());			//a connection in an unknown state is not kept
+		CHECK(!hostsim::outbound().back()->boardOpen);
+	}
+
+	//the hub closes the connection without replying
+	{
+		hostsim::resetNetwork();
+		PostClient client(HUB_IP, HUB_PORT);
+		int calls = 0;
+		CHECK(client.post("switch1 on", onComplete, &calls));
+		client.run();
+		client.run();
+		hostsim::outbound().back()->peerOpen = false;
+		runUntilIdle(client);
+		CHECK(calls == 1 && g_nResult == st::HTTP_NO_RESPONSE);
+		CHECK(client.getHealth().getFailureCount() == 1);
+	}
+
+	//the hub closes the connection after the status line - the status still counts
+	{
+		hostsim::resetNetwork();
+		PostClient client(HUB_IP, HUB_PORT);
+		int calls = 0;
+		CHECK(client.post("switch1 on", onComplete, &calls));
+		client.run();
+		client.run();
+		hostsim::outbound().back()->toBoard = "HTTP/1.1 500 Internal Server Error\r\n";
+		hostsim::outbound().back()->peerOpen = false;
+		runUntilIdle(client);
+		CHECK(calls == 1 && g_nResult == 500);
+	}
+
+	//the hub cannot be reached
+	{
+		hostsim::resetNetwork();
+		hostsim::setReachable(false);
+		PostClient client(HUB_IP, HUB_PORT);
+		int calls = 0;
+		CHECK(client.post("switch1 on", onComplete, &calls));
+		client.run();
+		CHECK(calls == 1 && g_nResult == st::HTTP_CONNECT_FAILED);
+		CHECK(client.isIdle() && !client.isReady());	//backing off
+		CHECK(client.getConnectCount() == 1);
+	}
+
+	//the connection drops while the request is written
+	{
+		hostsim::resetNetwork();
+		PostClient client(HUB_IP, HUB_PORT);
+		int calls = 0;
+		CHECK(client.post("switch1 on", onComplete, &calls));
+		client.run();
+		hostsim::outbound().back()->peerOpen = false;
+		runUntilIdle(client);
+		CHECK(calls == 1 && g_nResult == st::HTTP_WRITE_FAILED);
+	}
+
+	CHECK(g_nCalls == 6);
+	return hostsim::checkResult();
+}
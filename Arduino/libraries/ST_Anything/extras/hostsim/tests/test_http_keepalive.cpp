@@ -0,0 +1,146 @@
+//******************************************************************************************
+//  File: test_http_keepalive.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  The keep-alive connection of st::HttpPostClient<EthernetClient> against the fake
+//			  network - consecutive POSTs reuse one connection, and it is given up (the next POST
+//			  connects again) when the hub closes it, answers "Connection: close", HTTP/1.0 or
+//			  without a Content-Length, or it has been idle too long.  A request whose reused
+//			  connection turns out to be dead is sent again on a new one.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <HostNet.h>
+#include <Ethernet.h>
+#include <SmartThingsHttpClient.h>
+#include "Check.h"
+
+#include <string>
+
+namespace
+{
+	typedef st::HttpPostClient<EthernetClient> PostClient;
+
+	const char OK[] = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+
+	int g_nResult;
+	int g_nCalls;
+
+	void onComplete(void *, int result)
+	{
+		g_nResult = result;
+		g_nCalls++;
+	}
+
+	//POSTs body and answers it with reply on whatever connection the client wrote it to
+	bool postAndReply(PostClient &client, const char *body, const char *reply)
+	{
+		int calls = g_nCalls;
+		if (!client.post(body, onComplete))
+		{
+			return false;
+		}
+		for (int i = 0; i < 100 && client.getState() != PostClient::AwaitingResponse; i++)
+		{
+			client.run();
+		}
+		hostsim::outbound().back()->toBoard += reply;
+		for (int i = 0; i < 100 && !client.isIdle(); i++)
+		{
+			client.run();
+		}
+		return g_nCalls == calls + 1 && g_nResult == 200;
+	}
+
+	size_t count(const std::string &s, const char *what)
+	{
+		size_t n = 0;
+		for (size_t pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1))
+		{
+			n++;
+		}
+		return n;
+	}
+}
+
+int main()
+{
+	PostClient client(IPAddress(192, 168, 1, 2), 39500);
+	CHECK(client.isKeepAliveEnabled());
+
+	//consecutive POSTs share one connection
+	CHECK(postAndReply(client, "contact1 open", OK));
+	CHECK(postAndReply(client, "contact1 closed", OK));
+	CHECK(postAndReply(client, "switch1 on", OK));
+	CHECK(client.getConnectCount() == 1 && hostsim::outbound().size() == 1);
+	CHECK(count(hostsim::outbound()[0]->fromBoard, "POST / HTTP/1.1") == 3);
+	CHECK(hostsim::outbound()[0]->fromBoard.find("CONNECTION: KEEP-ALIVE") != std::string::npos);
+	CHECK(client.isConnected());
+
+	//the hub closes the idle connection - noticed by run(), the next POST connects again
+	hostsim::outbound()[0]->peerOpen = false;
+	client.run();
+	CHECK(!client.isConnected());
+	CHECK(postAndReply(client, "switch1 off", OK));
+	CHECK(client.getConnectCount() == 2);
+
+	//"Connection: close", HTTP/1.0 and a reply without Content-Length each end the connection
+	CHECK(postAndReply(client, "contact1 open", "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 0\r\n\r\n"));
+	CHECK(!client.isConnected() && !hostsim::outbound().back()->boardOpen);
+	CHECK(postAndReply(client, "contact1 closed", "HTTP/1.0 200 OK\r\nContent-Length: 0\r\n\r\n"));
+	CHECK(!client.isConnected());
+	CHECK(postAndReply(client, "switch1 on", "HTTP/1.1 200 OK\r\n\r\n"));
+	CHECK(!client.isConnected());
+	CHECK(client.getConnectCount() == 4);
+
+	//a body in the reply is read past, so the connection can be reused
+	CHECK(postAndReply(client, "switch1 off", "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello"));
+	CHECK(postAndReply(client, "switch1 on", OK));
+	CHECK(client.getConnectCount() == 5);
+
+	//idle for HTTP_KEEPALIVE_IDLE_TIMEOUT - closed by the board
+	hostsim::advanceMillis(HTTP_KEEPALIVE_IDLE_TIMEOUT - 1);
+	client.run();
+	CHECK(client.isConnected());
+	hostsim::advanceMillis(1);
+	client.run();
+	CHECK(!client.isConnected() && !hostsim::outbound().back()->boardOpen);
+
+	//the hub drops a reused connection after the request went out, before any reply - sent again
+	//on a new connection, and the callback only sees the final result
+	CHECK(postAndReply(client, "contact1 open", OK));
+	int calls = g_nCalls;
+	CHECK(client.post("contact1 closed", onComplete));
+	while (client.getState() != PostClient::AwaitingResponse)
+	{
+		client.run();
+	}
+	hostsim::SocketPtr stale = hostsim::outbound().back();
+	stale->peerOpen = false;
+	client.run();
+	CHECK(g_nCalls == calls);
+	while (client.getState() != PostClient::AwaitingResponse)
+	{
+		client.run();
+	}
+	CHECK(hostsim::outbound().back() != stale);
+	CHECK(hostsim::outbound().back()->fromBoard.find("contact1 closed") != std::string::npos);
+	hostsim::outbound().back()->toBoard = OK;
+	while (!client.isIdle())
+	{
+		client.run();
+	}
+	CHECK(g_nCalls == calls + 1 && g_nResult == 200);
+	CHECK(client.getHealth().getFailureCount() == 0);
+
+	return hostsim::checkResult();
+}
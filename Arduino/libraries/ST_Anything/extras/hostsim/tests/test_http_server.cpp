@@ -0,0 +1,154 @@
+//******************************************************************************************
+//  File: test_http_server.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::HttpRequestServer<EthernetServer, EthernetClient> against the fake network - a
+//			  request that arrives in pieces over several run() calls, percent-decoding, several
+//			  clients at once (completed order, a slow one not holding up the others, more than
+//			  HTTP_SERVER_MAX_CLIENTS), and requests dropped on timeout, disconnect or overflow.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Checks the whole 204 response
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <HostNet.h>
+#include <Ethernet.h>
+#include <SmartThingsHttpServer.h>
+#include "Check.h"
+
+#include <string>
+
+namespace
+{
+	typedef st::HttpRequestServer<EthernetServer, EthernetClient> Server;
+
+	const uint16_t PORT = 8090;
+
+	//sends one whole request on a new connection and returns the command the server decoded from it
+	std::string roundTrip(Server &server, const char *request)
+	{
+		hostsim::SocketPtr hub = hostsim::connect(PORT);
+		hub->toBoard = request;
+		server.run();
+		String command;
+		if (!server.pop(command))
+		{
+			return "<none>";
+		}
+		server.run();		//closes the connection
+		return command.c_str();
+	}
+}
+
+int main()
+{
+	Server server(PORT);
+	server.begin();
+
+	//a request that arrives in pieces - run() takes what is there and returns
+	hostsim::SocketPtr hub = hostsim::connect(PORT);
+	String command;
+	const char *pieces[] = { "PO", "ST /swi", "tch1%2", "0on?", " HTTP/1.1\r", "\nHOST: 192.168.1.50:8090\r\n", "CONTENT-LENGTH: 0\r\n\r" };
+	for (unsigned int i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++)
+	{
+		hub->toBoard += pieces[i];
+		server.run();
+		CHECK(hub->toBoard.empty());
+		CHECK(!server.pop(command));
+		CHECK(hub->fromBoard.empty());
+	}
+	hub->toBoard += "\n";
+	server.run();
+	CHECK(hub->fromBoard == "HTTP/1.1 200 OK\r\n\r\n");
+	CHECK(server.pop(command) && command == "switch1 on");
+	CHECK(!server.pop(command));
+	CHECK(hub->boardOpen);		//the reply gets one more run() to go out
+	server.run();
+	CHECK(!hub->boardOpen);
+	CHECK(server.getOpenCount() == 0 && server.getRequestCount() == 1);
+
+	//percent-decoding, in place
+	CHECK(roundTrip(server, "POST /contact1%20open? HTTP/1.1\r\n\r\n") == "contact1 open");
+	CHECK(roundTrip(server, "POST /a%41%2fb%2Fc%7e HTTP/1.1\r\n\r\n") == "aA/b/c~");
+	CHECK(roundTrip(server, "POST /100%25%20done HTTP/1.1\r\n\r\n") == "100% done");
+	CHECK(roundTrip(server, "POST /bad%zzescape%2 HTTP/1.1\r\n\r\n") == "bad%zzescape%2");	//not an escape - kept
+	CHECK(roundTrip(server, "GET /refresh\r\n\r\n") == "refresh");		//no '?', no HTTP version
+	CHECK(roundTrip(server, "POST / HTTP/1.1\r\n\r\n") == "");			//no command - 204
+
+	//a command longer than the buffer is queued empty, and answered 204
+	std::string longRequest = "POST /";
+	longRequest.append(HTTP_REQUEST_BUFFER, 'x');
+	longRequest += " HTTP/1.1\r\n\r\n";
+	hub = hostsim::connect(PORT);
+	hub->toBoard = longRequest;
+	server.run();
+	CHECK(server.pop(command) && command.length() == 0);
+	CHECK(hub->fromBoard == "HTTP/1.1 204 No Content\r\n\r\n");		//nothing after the blank line that ends the headers
+	server.run();
+
+	//several clients - a slow one does not hold up the others, and commands come out in completed order
+	hostsim::SocketPtr slow = hostsim::connect(PORT);
+	slow->toBoard = "POST /slow%20one";
+	server.run();
+	hostsim::SocketPtr first = hostsim::connect(PORT);
+	hostsim::SocketPtr second = hostsim::connect(PORT);
+	second->toBoard = "POST /second? HTTP/1.1\r\n";
+	first->toBoard = "POST /first? HTTP/1.1\r\n";
+	server.run();
+	server.run();
+	CHECK(server.getOpenCount() == 3);
+	second->toBoard = "\r\n";
+	server.run();
+	first->toBoard = "\r\n";
+	server.run();
+	slow->toBoard = "? HTTP/1.1\r\n\r\n";
+	server.run();
+	CHECK(server.pop(command) && command == "second");
+	CHECK(server.pop(command) && command == "first");
+	CHECK(server.pop(command) && command == "slow one");
+	CHECK(!server.pop(command));
+	server.run();
+	CHECK(server.getOpenCount() == 0);
+
+	//more clients than HTTP_SERVER_MAX_CLIENTS - the extra one is accepted once a slot is free
+	hostsim::SocketPtr waiting[HTTP_SERVER_MAX_CLIENTS + 1];
+	for (int i = 0; i <= HTTP_SERVER_MAX_CLIENTS; i++)
+	{
+		waiting[i] = hostsim::connect(PORT);
+		waiting[i]->toBoard = "POST /";
+		server.run();
+	}
+	CHECK(server.getOpenCount() == HTTP_SERVER_MAX_CLIENTS);
+	CHECK(waiting[HTTP_SERVER_MAX_CLIENTS]->toBoard == "POST /");	//not read yet
+	waiting[0]->toBoard = "switch1%20off HTTP/1.1\r\n\r\n";
+	server.run();
+	CHECK(server.pop(command) && command == "switch1 off");
+	server.run();
+	server.run();
+	CHECK(waiting[HTTP_SERVER_MAX_CLIENTS]->toBoard.empty());		//accepted into the freed slot
+
+	//dropped - a client that disconnects halfway, and the ones that never finish
+	unsigned long dropped = server.getDroppedCount();
+	waiting[1]->peerOpen = false;
+	server.run();
+	CHECK(server.getDroppedCount() == dropped + 1);
+	CHECK(!waiting[1]->boardOpen);
+	hostsim::advanceMillis(HTTP_REQUEST_TIMEOUT);
+	server.run();
+	CHECK(server.getDroppedCount() == dropped + HTTP_SERVER_MAX_CLIENTS);
+	CHECK(server.getOpenCount() == 0);
+	CHECK(!server.pop(command));
+
+	//and the server still works afterwards
+	CHECK(roundTrip(server, "POST /switch1%20on? HTTP/1.1\r\n\r\n") == "switch1 on");
+
+	return hostsim::checkResult();
+}
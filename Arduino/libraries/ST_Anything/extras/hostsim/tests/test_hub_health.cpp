@@ -0,0 +1,259 @@
+//******************************************************************************************
+//  File: test_hub_health.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::HubHealth's backoff and circuit breaker (Closed -> Open -> HalfOpen -> Open or
+//			  Closed), and how SmartThingsHttpTransport (through SmartThingsEthernetW5x00 on the fake
+//			  network) behaves while the hub is down - a POST is retried until the circuit breaker
+//			  opens (at most HTTP_MAX_RETRIES times) and then handed back, send() holds a Message
+//			  instead of waiting or dropping it, and st::Everything::initDevices() spools its
+//			  messages, in order, instead of hanging.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <HostNet.h>
+#include <SmartThingsEthernetW5x00.h>
+#include <SmartThingsHubHealth.h>
+#include <Everything.h>
+#include <PollingSensor.h>
+#include "Check.h"
+
+#include <map>
+#include <string>
+
+namespace
+{
+	const char OK[] = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+
+	class TestSensor : public st::PollingSensor
+	{
+		public:
+			TestSensor(const __FlashStringHelper *name) : PollingSensor(name, 60, 0) {}
+			virtual void getData() { st::Everything::sendSmartString(String(getNameF()) + " 1"); }
+	};
+
+	//the backoff after a failure is the nominal one, shortened by up to a quarter of it
+	bool backoffIs(const st::HubHealth &health, unsigned long nominal)
+	{
+		return health.getBackoff() <= nominal && health.getBackoff() >= nominal - nominal / 4;
+	}
+
+	//the hub - answers every request that has been written to it
+	std::map<hostsim::Socket*, size_t> g_Replied;
+	void answerHub()
+	{
+		for (size_t i = 0; i < hostsim::outbound().size(); i++)
+		{
+			hostsim::Socket *socket = hostsim::outbound()[i].get();
+			size_t requests = 0;
+			for (size_t pos = socket->fromBoard.find("\r\n\r\n"); pos != std::string::npos; pos = socket->fromBoard.find("\r\n\r\n", pos + 1))
+			{
+				requests++;
+			}
+			for (; g_Replied[socket] < requests; g_Replied[socket]++)
+			{
+				socket->toBoard += OK;
+			}
+		}
+	}
+
+	bool hubReceived(const char *message)
+	{
+		for (size_t i = 0; i < hostsim::outbound().size(); i++)
+		{
+			if (hostsim::outbound()[i]->fromBoard.find(message) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//first is found in an earlier request than second
+	bool hubOrder(const char *first, const char *second)
+	{
+		std::string all;
+		for (size_t i = 0; i < hostsim::outbound().size(); i++)
+		{
+			all += hostsim::outbound()[i]->fromBoard;
+		}
+		size_t a = all.find(first);
+		size_t b = all.find(second);
+		return a != std::string::npos && b != std::string::npos && a < b;
+	}
+
+	void loop()
+	{
+		st::Everything::run();
+		answerHub();
+	}
+}
+
+int main()
+{
+	//HubHealth on its own - backoff doubling, trip, probe
+	{
+		st::HubHealth health;
+		CHECK(health.getState() == st::HubHealth::Closed && health.isRequestAllowed() && !health.isOpen());
+
+		health.recordFailure();
+		CHECK(health.getState() == st::HubHealth::Closed && backoffIs(health, HUB_BACKOFF_INITIAL));
+		CHECK(!health.isRequestAllowed() && !health.isOpen());		//backing off, but the hub is not considered down yet
+		hostsim::advanceMillis(health.getTimeUntilAttempt());
+		CHECK(health.isRequestAllowed());
+
+		health.recordFailure();
+		CHECK(health.getState() == st::HubHealth::Closed && backoffIs(health, 2 * HUB_BACKOFF_INITIAL));
+		for (int i = 2; i < HUB_FAILURE_THRESHOLD - 1; i++)
+		{
+			health.recordFailure();
+		}
+		CHECK(health.getState() == st::HubHealth::Closed);
+		health.recordFailure();		//the threshold
+		CHECK(health.getState() == st::HubHealth::Open && health.getTripCount() == 1);
+		CHECK(health.isOpen() && !health.isRequestAllowed());
+		CHECK(backoffIs(health, HUB_BACKOFF_INITIAL << (HUB_FAILURE_THRESHOLD - 1)));
+
+		//the backoff has passed - one probe goes out
+		hostsim::advanceMillis(health.getTimeUntilAttempt());
+		CHECK(!health.isOpen() && health.isRequestAllowed());
+		health.recordAttempt();
+		CHECK(health.getState() == st::HubHealth::HalfOpen && health.getProbeCount() == 1);
+		CHECK(health.isOpen() && !health.isRequestAllowed());		//only the probe
+
+		//the probe fails - open again, twice the backoff, without counting another trip
+		health.recordFailure();
+		CHECK(health.getState() == st::HubHealth::Open && health.getTripCount() == 1);
+		CHECK(backoffIs(health, HUB_BACKOFF_INITIAL << HUB_FAILURE_THRESHOLD));
+
+		//the next probe is answered - closed
+		hostsim::advanceMillis(health.getTimeUntilAttempt());
+		health.recordAttempt();
+		health.recordSuccess();
+		CHECK(health.getState() == st::HubHealth::Closed && health.getConsecutiveFailures() == 0 && health.getBackoff() == 0);
+		CHECK(health.isRequestAllowed() && !health.isOpen());
+
+		//the backoff stops growing at HUB_BACKOFF_MAX
+		for (int i = 0; i < 40; i++)
+		{
+			health.recordFailure();
+		}
+		CHECK(backoffIs(health, HUB_BACKOFF_MAX) && health.getTripCount() == 2);
+	}
+
+	byte mac[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED };
+	IPAddress hubIP(192, 168, 1, 2);
+	st::SmartThingsEthernetW5x00 transport(mac, IPAddress(192, 168, 1, 50), IPAddress(192, 168, 1, 1), IPAddress(255, 255, 255, 0), IPAddress(192, 168, 1, 1), 8090, hubIP, 39500, st::receiveSmartString);
+	const st::HubHealth &health = *transport.getHubHealth();
+	transport.init();
+
+	//a POST that cannot connect is retried until the circuit breaker opens, then handed back
+	hostsim::setReachable(false);
+	CHECK(transport.isReadyToSend());
+	transport.send("contact1 open");
+	for (int i = 0; i < 120000 && transport.getUndeliveredCount() == 0; i++)
+	{
+		transport.run();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(health.getFailureCount() == HUB_FAILURE_THRESHOLD && HUB_FAILURE_THRESHOLD <= 1 + HTTP_MAX_RETRIES);
+	CHECK(transport.getUndeliveredCount() == 1);
+	CHECK(health.getState() == st::HubHealth::Open);
+	CHECK(!transport.isLinkUp() && !transport.isReadyToSend());
+	String message;
+	CHECK(transport.popUndelivered(message) && message == "contact1 open");
+	CHECK(!transport.popUndelivered(message));
+
+	//send() while the client is backing off - held, not waited for or dropped
+	unsigned long start = millis();
+	transport.send("contact2 open");
+	transport.send("contact3 open");
+	CHECK(millis() == start);
+	CHECK(transport.getHeldLength() == strlen("contact2 open\ncontact3 open"));
+	CHECK(transport.getUndeliveredCount() == 1);
+
+	//no room to hold another - handed back
+	String longMessage = "x";
+	while (longMessage.length() < HTTP_HELD_MAX_LENGTH)
+	{
+		longMessage += "x";
+	}
+	transport.send(longMessage);
+	CHECK(transport.getUndeliveredCount() == 2);
+	CHECK(transport.popUndelivered(message) && message == longMessage);
+
+	//the hub is back - batching is not enabled, so the held Messages go out one POST each, the first as the probe
+	hostsim::setReachable(true);
+	for (int i = 0; i < 120000 && (health.getState() != st::HubHealth::Closed || transport.getHeldLength() > 0 || !transport.isReadyToSend()); i++)
+	{
+		transport.run();
+		answerHub();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(health.getState() == st::HubHealth::Closed);
+	CHECK(hubReceived("\r\n\r\ncontact2 open") && hubReceived("\r\n\r\ncontact3 open"));
+	CHECK(!hubReceived("contact2 open\ncontact3 open"));
+	CHECK(transport.getHeldLength() == 0 && transport.isReadyToSend());
+
+	//with batching enabled, held Messages go out as one batch
+	transport.enableBatching(true);
+	transport.send("contact4 open");
+	transport.send("contact5 open");
+	transport.send("contact6 open");
+	for (int i = 0; i < 1000 && (transport.getHeldLength() > 0 || !transport.isReadyToSend()); i++)
+	{
+		transport.run();
+		answerHub();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(hubReceived("\r\n\r\ncontact4 open") && hubReceived("contact5 open\ncontact6 open"));
+	transport.enableBatching(false);
+
+	//st::Everything::initDevices() with the hub down - the messages are spooled, initDevices() does not hang
+	static TestSensor sensor1(F("temperature1"));
+	static TestSensor sensor2(F("temperature2"));
+	static TestSensor sensor3(F("temperature3"));
+	hostsim::setReachable(false);
+	for (size_t i = 0; i < hostsim::outbound().size(); i++)
+	{
+		hostsim::outbound()[i]->peerOpen = false;	//the hub drops the kept alive connection as it goes down
+	}
+	transport.run();
+	st::Everything::SmartThing = &transport;
+	st::Everything::init();
+	st::Everything::addSensor(&sensor1);
+	st::Everything::addSensor(&sensor2);
+	st::Everything::addSensor(&sensor3);
+	start = millis();
+	st::Everything::initDevices();
+	CHECK(millis() - start < 60000);
+	CHECK(st::Everything::getMessageQueue().isEmpty());
+	CHECK(st::Everything::getMessageSpool().count() == 3);		//temperature1 (handed back as the breaker opened), then 2 and 3
+	CHECK(transport.getUndeliveredCount() == 3);
+
+	//and sendSmartStringNow() with the breaker open returns at once
+	CHECK(!transport.isLinkUp());
+	start = millis();
+	st::Everything::sendSmartStringNow(String("temperature1 2"));
+	CHECK(millis() - start < 1000);
+	CHECK(st::Everything::getMessageSpool().count() == 4);
+
+	//once the hub is back the spooled messages are replayed, oldest first - nothing was dropped
+	hostsim::setReachable(true);
+	hostsim::runFor(120000, loop);
+	CHECK(st::Everything::getMessageSpool().isEmpty() && st::Everything::getMessageSpool().getDropCount() == 0);
+	CHECK(hubReceived("temperature1 1 @") && hubReceived("temperature2 1 @") && hubReceived("temperature3 1 @") && hubReceived("temperature1 2 @"));
+	CHECK(hubOrder("temperature1 1 @", "temperature1 2 @"));
+	CHECK(health.getState() == st::HubHealth::Closed);
+
+	return hostsim::checkResult();
+}
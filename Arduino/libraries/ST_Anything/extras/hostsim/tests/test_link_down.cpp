@@ -0,0 +1,110 @@
+//******************************************************************************************
+//  File: test_link_down.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  Messages sent while the link to the hub is down are kept, not waited for or lost -
+//			  st::Everything::sendSmartStringNow() spools its message (ENABLE_MESSAGE_SPOOL) instead
+//			  of waiting for a transport that is not ready, and st::SmartThingsTask keeps the messages
+//			  already in its queue until the link is back.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <SmartThingsTask.h>
+#include "SmartThingsLoopback.h"
+#include "Check.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+	//not ready to send while the link is down - as an HTTP transport is while its circuit breaker is open
+	class BreakerLoopback : public st::SmartThingsLoopback
+	{
+		public:
+			BreakerLoopback() : SmartThingsLoopback(st::receiveSmartString, 100) {}
+			virtual bool isReadyToSend() { return isLinkUp(); }
+	};
+
+	bool sent(st::SmartThingsLoopback &loopback, const char *message)
+	{
+		for (size_t i = 0; i < loopback.getSent().size(); i++)
+		{
+			if (loopback.getSent()[i].body.find(message) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void loop()
+	{
+		st::Everything::run();
+	}
+
+	//waits (in real time) for the network task
+	bool waitFor(st::SmartThingsTask &task, byte outboundCount)
+	{
+		for (int i = 0; i < 2000 && task.getOutboundCount() != outboundCount; i++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return task.getOutboundCount() == outboundCount;
+	}
+}
+
+int main()
+{
+	//sendSmartStringNow() with the link down - spooled, without waiting for the transport
+	BreakerLoopback loopback;
+	st::Everything::SmartThing = &loopback;
+	st::Everything::init();
+	st::Everything::initDevices();
+	loopback.clearSent();
+
+	loopback.setLinkUp(false);
+	unsigned long start = millis();
+	CHECK(st::Everything::sendSmartStringNow(String("contact1 open")));
+	CHECK(millis() - start < 1000);
+	CHECK(st::Everything::getMessageQueue().isEmpty());
+	CHECK(st::Everything::getMessageSpool().count() == 1);
+	CHECK(loopback.getSent().empty() && loopback.getLostCount() == 0);
+
+	//and replayed once the link is back
+	loopback.setLinkUp(true);
+	hostsim::runFor(3000, loop);
+	CHECK(sent(loopback, "contact1 open @"));
+	CHECK(st::Everything::getMessageSpool().isEmpty());
+	CHECK(loopback.getLostCount() == 0);
+
+	//SmartThingsTask - messages already queued for the network task wait for the link
+	st::SmartThingsLoopback wrapped(st::receiveSmartString, 100);
+	st::SmartThingsTask task(&wrapped);
+	task.init();
+	wrapped.setLinkUp(false);
+	task.send("switch1 on");
+	task.send("switch1 off");
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	CHECK(task.getOutboundCount() == 2);
+	CHECK(wrapped.getSent().empty() && wrapped.getLostCount() == 0);
+	CHECK(!task.isLinkUp());		//so st::Everything spools what comes next
+
+	wrapped.setLinkUp(true);
+	CHECK(waitFor(task, 0));
+	task.stop();
+	CHECK(wrapped.getSent().size() == 2 && wrapped.getSent()[0].body == "switch1 on" && wrapped.getSent()[1].body == "switch1 off");
+	CHECK(wrapped.getLostCount() == 0);
+
+	return hostsim::checkResult();
+}
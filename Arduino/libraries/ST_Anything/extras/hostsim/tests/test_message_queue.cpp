@@ -0,0 +1,100 @@
+//******************************************************************************************
+//  File: test_message_queue.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::MessageQueue on its own, built with a queue of more than 255 slots and
+//			  ST_MESSAGE_SLOT_SIZE=128 (see CMakeLists.txt) - messages longer than the default 65
+//			  characters fit, positions and counts do not stop at 255, the ring buffer wraps correctly,
+//			  and coalescing finds messages on both sides of the wrap.  insert() puts messages
+//			  handed back by the communication method ahead of the queued ones, across the wrap.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//    2026-10-18  agent          Queue of 300 slots - positions and counts are 16 bit
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <MessageQueue.h>
+#include "Check.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int main()
+{
+	static st::MessageQueue queue;
+	const unsigned int SIZE = queue.capacity();
+	CHECK(SIZE > 255);
+
+	//ST_MESSAGE_SLOT_SIZE - 127 characters fit, 128 do not
+	char longMessage[129];
+	memset(longMessage, 'x', sizeof(longMessage));
+	CHECK(st::Constants::MESSAGE_SLOT_SIZE == 128);
+	CHECK(queue.push(longMessage, 127));
+	CHECK(strlen(queue.peek()) == 127);
+	queue.pop();
+	CHECK(!queue.push(longMessage, 128) && queue.getDropCount() == 1);
+
+	//move the head near the end of the slots, then fill the queue so it wraps
+	char message[32];
+	for (unsigned int i = 0; i < SIZE - 10; i++)
+	{
+		CHECK(queue.push("old 0", 5));
+		queue.pop();
+	}
+	for (unsigned int i = 0; i < SIZE; i++)
+	{
+		snprintf(message, sizeof(message), "dev%u %u", i, i);
+		CHECK(queue.push(message, strlen(message), true));
+	}
+	CHECK(queue.isFull());
+	CHECK(!queue.push("extra 1", 7));
+
+	//every position reads back in order
+	for (unsigned int i = 0; i < SIZE; i++)
+	{
+		snprintf(message, sizeof(message), "dev%u %u", i, i);
+		CHECK(queue.peek(i) != 0 && strcmp(queue.peek(i), message) == 0);
+	}
+
+	//coalescing finds the newest and oldest messages on either side of the wrap
+	CHECK(queue.push("dev0 100", 8, true));
+	snprintf(message, sizeof(message), "dev%u 100", SIZE - 1);
+	CHECK(queue.push(message, strlen(message), true));
+	CHECK(queue.getCoalescedCount() == 2);
+	CHECK(strcmp(queue.peek(0), "dev0 100") == 0);
+	CHECK(strcmp(queue.peek(SIZE - 1), message) == 0);
+
+	//and pop() walks the whole ring
+	for (unsigned int i = 0; i < SIZE; i++)
+	{
+		CHECK(queue.peek() != 0);
+		queue.pop();
+	}
+	CHECK(queue.isEmpty());
+
+	//insert() at the head, which is at slot 0 after a whole walk of the ring - the new head wraps to the last slot
+	CHECK(queue.push("dev1 1", 6, true));
+	CHECK(queue.push("dev2 2", 6));
+	CHECK(queue.insert(0, "back0 0", 7));
+	CHECK(queue.insert(1, "back1 1", 7));
+	CHECK(queue.count() == 4);
+	CHECK(strcmp(queue.peek(0), "back0 0") == 0 && strcmp(queue.peek(1), "back1 1") == 0);
+	CHECK(strcmp(queue.peek(2), "dev1 1") == 0 && strcmp(queue.peek(3), "dev2 2") == 0);
+	CHECK(queue.push("back0 5", 7, true));		//inserted messages are never coalesced
+	CHECK(queue.count() == 5 && strcmp(queue.peek(0), "back0 0") == 0);
+	CHECK(queue.push("dev1 5", 6, true));		//the moved replaceable message still is
+	CHECK(queue.count() == 5 && strcmp(queue.peek(2), "dev1 5") == 0);
+	CHECK(!queue.insert(6, "back2 2", 7));
+	while (!queue.isFull())
+	{
+		queue.push("fill 0", 6);
+	}
+	CHECK(!queue.insert(0, "back2 2", 7));
+	return hostsim::checkResult();
+}
@@ -0,0 +1,125 @@
+//******************************************************************************************
+//  File: test_registry.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::Registry<...> - devices are constructed in place (a device that cannot be copied,
+//			  and one that points into itself, both work), registered with st::Everything, and hub
+//			  commands and lookups by name reach the right device.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <Registry.h>
+#include <EX_Switch.h>
+#include <IS_Contact.h>
+#include <PollingSensor.h>
+#include <Message.h>
+#include "SmartThingsLoopback.h"
+#include "Check.h"
+
+#include <string>
+
+namespace
+{
+	const byte PIN_SWITCH = 4;
+	const byte PIN_CONTACT = 6;
+
+	struct Bus
+	{
+		int value;
+		Bus(int v) : value(v) {}
+	};
+
+	//like PS_DS18B20_Temperature (DallasTemperature holds the address of its OneWire member) - a copy would read a dead object's bus
+	class BusSensor : public st::PollingSensor
+	{
+		private:
+			Bus m_Bus;
+			Bus *m_pBus;
+
+		public:
+			BusSensor(const __FlashStringHelper *name, long interval, long offset, int value) :
+				PollingSensor(name, interval, offset),
+				m_Bus(value),
+				m_pBus(&m_Bus)
+			{
+			}
+			BusSensor(const BusSensor&) = delete;
+
+			bool busIsMine() const {return m_pBus == &m_Bus;}
+			void setBus(int value) {m_Bus.value = value;}
+			virtual void getData() {st::Message(getNameF()).value((long)m_pBus->value).sendReading();}
+	};
+
+	bool sent(st::SmartThingsLoopback &loopback, const char *message)
+	{
+		for (size_t i = 0; i < loopback.getSent().size(); i++)
+		{
+			if (loopback.getSent()[i].body.find(message) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+int main()
+{
+	hostsim::setDigital(PIN_CONTACT, HIGH);
+	static st::Registry<st::EX_Switch, st::IS_Contact, BusSensor> devices(
+		st::deviceArgs(F("switch1"), PIN_SWITCH, LOW, false),
+		st::deviceArgs(F("contact1"), PIN_CONTACT, LOW, true),
+		st::deviceArgs(F("bus1"), 60L, 0L, 42));
+	CHECK(devices.count() == 3);
+	CHECK(devices.get<2>().busIsMine());
+
+	st::SmartThingsLoopback loopback(st::receiveSmartString, 100);
+	st::Everything::SmartThing = &loopback;
+	st::Everything::init();
+	CHECK(st::Everything::addRegistry(&devices));
+	st::Everything::initDevices();
+	CHECK(sent(loopback, "switch1 off"));
+	CHECK(sent(loopback, "contact1 open"));
+	CHECK(sent(loopback, "bus1 42"));
+
+	//lookups by name find the objects inside the registry
+	CHECK(st::Everything::getDeviceByName("switch1", 7) == &devices.get<0>());
+	CHECK(st::Everything::getDeviceByName("contact1", 8) == &devices.get<1>());
+	CHECK(st::Everything::getDeviceByName(String("bus1")) == &devices.get<2>());
+	CHECK(st::Everything::getDeviceByName("bus2", 4) == 0);
+
+	//hub commands are dispatched by name
+	loopback.clearSent();
+	st::receiveSmartString("switch1 on");
+	CHECK(hostsim::getOutput(PIN_SWITCH) == HIGH);
+	devices.get<2>().setBus(7);
+	st::Everything::getDeviceByName("bus1", 4)->refresh();	//through the vtable, as st::Everything's refresh pass does
+	for (int i = 0; i < 1000; i++)
+	{
+		st::Everything::run();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(sent(loopback, "switch1 on"));
+	CHECK(sent(loopback, "bus1 7"));
+
+	//and the registry's update() still follows the inputs
+	hostsim::setDigital(PIN_CONTACT, LOW);
+	for (int i = 0; i < 1000; i++)
+	{
+		st::Everything::run();
+		hostsim::advanceMillis(1);
+	}
+	CHECK(sent(loopback, "contact1 closed"));
+
+	return hostsim::checkResult();
+}
@@ -0,0 +1,139 @@
+//******************************************************************************************
+//  File: test_udp.cpp (hostsim tests)
+//  Authors: agent (based on original programming by Dan G Ogorchock & Daniel J Ogorchock)
+//
+//  Summary:  st::SmartThingsUdp against the UDP loopback hub - the hub's commands are read
+//			  by send() and isReadyToSend() too, but only run() passes them to the callout, so a
+//			  "refresh" or a device that sends at once (sendSmartStringNow()) never runs while
+//			  st::Everything is in the middle of sending its queue.
+//
+//  Change History:
+//
+//    Date        Who            What
+//    ----        ---            ----
+//    2026-10-18  agent          Original Creation
+//
+//
+//******************************************************************************************
+
+#include <Arduino.h>
+#include <HostSim.h>
+#include <Everything.h>
+#include <IS_Contact.h>
+#include "UdpLoopback.h"
+#include "Check.h"
+
+#include <string>
+
+namespace
+{
+	typedef st::SmartThingsUdp<UdpLoopback> Transport;
+
+	unsigned int callouts = 0;
+
+	void countingCallout(String message)
+	{
+		(void)message;
+		callouts++;
+	}
+
+	//a sketch whose device answers "now" at once, as IS_DoorControl and IS_Button do from beSmart()
+	void sketchCallout(String message)
+	{
+		callouts++;
+		if (message == "now")
+		{
+			st::Everything::sendSmartStringNow(String("door1 opening"));
+		}
+		else
+		{
+			st::receiveSmartString(message);
+		}
+	}
+
+	unsigned int received(UdpLoopback &hub, const char *message)
+	{
+		unsigned int count = 0;
+		for (size_t i = 0; i < hub.getReceived().size(); i++)
+		{
+			if (hub.getReceived()[i].body.find(message) != std::string::npos)
+			{
+				count++;
+			}
+		}
+		return count;
+	}
+
+	void loop()
+	{
+		st::Everything::run();
+	}
+}
+
+int main()
+{
+	IPAddress hubIP(192, 168, 1, 100);
+
+	//send() and isReadyToSend() read the command, run() delivers it
+	Transport transport(8090, hubIP, 39501, countingCallout);
+	transport.getUdp().setHub(hubIP, 39501);
+	transport.init();
+	transport.getUdp().sendCommand("switch1 on");
+	transport.send("contact1 open");
+	CHECK(transport.isReadyToSend());
+	CHECK(callouts == 0 && transport.getHeldCommandCount() == 1);
+	CHECK(transport.getUdp().getUnacknowledgedCommands() == 0);
+	transport.run();
+	CHECK(callouts == 1 && transport.getHeldCommandCount() == 0);
+
+	//commands beyond UDP_COMMAND_QUEUE are not acknowledged, and the hub's retransmission is delivered later
+	callouts = 0;
+	for (int i = 0; i <= UDP_COMMAND_QUEUE; i++)
+	{
+		transport.getUdp().sendCommand("switch1 on");
+	}
+	CHECK(transport.isReadyToSend());
+	CHECK(transport.getHeldCommandCount() == UDP_COMMAND_QUEUE);
+	CHECK(transport.getUdp().getUnacknowledgedCommands() == 1);
+	transport.run();
+	CHECK(callouts == UDP_COMMAND_QUEUE);
+	hostsim::advanceMillis(UDP_RETRANSMIT_INTERVAL);
+	transport.run();
+	CHECK(callouts == UDP_COMMAND_QUEUE + 1 && transport.getUdp().getUnacknowledgedCommands() == 0);
+
+	//st::Everything - commands arriving while its queue is being sent
+	static st::IS_Contact contact1(F("contact1"), 2, LOW, true);
+	static st::IS_Contact contact2(F("contact2"), 3, LOW, true);
+	static Transport udp(8090, hubIP, 39501, sketchCallout);
+	udp.getUdp().setHub(hubIP, 39501);
+	st::Everything::refreshSnapshot = true;
+	st::Everything::SmartThing = &udp;
+	st::Everything::init();
+	st::Everything::addSensor(&contact1);
+	st::Everything::addSensor(&contact2);
+	st::Everything::initDevices();
+
+	//the commands arrive while sendSmartStringNow() waits for the transport - they are held until run()
+	callouts = 0;
+	st::Everything::sendSmartString(String("temperature1 0"));
+	st::Everything::sendSmartString(String("temperature1 1"));
+	udp.getUdp().sendCommand("now");
+	udp.getUdp().sendCommand("refresh");
+	st::Everything::sendSmartStringNow(String("temperature1 2"));
+	CHECK(callouts == 0);
+	CHECK(st::Everything::getMessageQueue().isEmpty());
+	hostsim::runFor(5000, loop);
+
+	CHECK(callouts == 2);
+	CHECK(st::Everything::getMessageQueue().isEmpty());
+	CHECK(received(udp.getUdp(), "temperature1 0") == 1 && received(udp.getUdp(), "temperature1 2") == 1);
+	CHECK(received(udp.getUdp(), "door1 opening") == 1);
+	CHECK(received(udp.getUdp(), "contact1 closed") == 2);		//initDevices() and the refresh
+	for (size_t i = 0; i < udp.getUdp().getReceived().size(); i++)
+	{
+		CHECK(!udp.getUdp().getReceived()[i].body.empty());
+	}
+	CHECK(udp.getLostCount() == 0);
+
+	return hostsim::checkResult();
+}
@@ -163,8 +163,8 @@ namespace st
 
 			}
 
-		Everything::sendSmartString(m_strTemperature + " " + String(m_fTemperatureSensorValue));
-		Everything::sendSmartString(m_strHumidity + " " + String(m_fHumiditySensorValue));
+		Message(m_strTemperature).value(m_fTemperatureSensorValue).sendReading();
+		Message(m_strHumidity).value(m_fHumiditySensorValue).sendReading();
 
 	}
 	
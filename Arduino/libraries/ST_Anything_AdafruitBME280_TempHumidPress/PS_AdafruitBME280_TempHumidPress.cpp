@@ -184,9 +184,9 @@ namespace st
 				m_fPressureSensorValue = (m_fFilterConstant * (bme.readPressure() / 100.0F)) + (1 - m_fFilterConstant) * m_fPressureSensorValue;
 			}
 
-		Everything::sendSmartString(m_strTemperature + " " + String(m_fTemperatureSensorValue));
-		Everything::sendSmartString(m_strHumidity + " " + String(m_fHumiditySensorValue));
-		Everything::sendSmartString(m_strPressure + " " + String(m_fPressureSensorValue));
+		Message(m_strTemperature).value(m_fTemperatureSensorValue).sendReading();
+		Message(m_strHumidity).value(m_fHumiditySensorValue).sendReading();
+		Message(m_strPressure).value(m_fPressureSensorValue).sendReading();
 
 	}
 	
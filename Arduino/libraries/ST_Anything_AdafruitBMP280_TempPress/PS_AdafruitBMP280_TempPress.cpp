@@ -170,8 +170,8 @@ namespace st
 				m_fPressureSensorValue = (m_fFilterConstant * (bmp.readPressure() / 100.0F)) + (1 - m_fFilterConstant) * m_fPressureSensorValue;
 			}
 
-		Everything::sendSmartString(m_strTemperature + " " + String(m_fTemperatureSensorValue));
-		Everything::sendSmartString(m_strPressure + " " + String(m_fPressureSensorValue));
+		Message(m_strTemperature).value(m_fTemperatureSensorValue).sendReading();
+		Message(m_strPressure).value(m_fPressureSensorValue).sendReading();
 
 	}
 	
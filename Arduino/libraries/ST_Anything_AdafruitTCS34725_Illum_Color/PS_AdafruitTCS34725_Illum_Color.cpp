@@ -122,10 +122,20 @@ namespace st
 		//Serial.print("C: "); Serial.print(m_nclear, DEC); Serial.print(" ");
 		//Serial.println(" ");
 
-		String strSensorValue = String(m_nlux, DEC) + ':' + String(m_ncolorTemp, DEC) + ':' + String(m_nred, DEC) + ':' + String(m_ngreen, DEC) + ':' + String(m_nblue, DEC) + ':' + String(m_nclear, DEC);
-
-		//Send data to SmartThings/Hubitat
-		Everything::sendSmartString(getName() + " " + strSensorValue);
+		//Send data to SmartThings/Hubitat - "name lux:colorTemp:red:green:blue:clear"
+		Message msg(getNameF());
+		msg.value(m_nlux);
+		msg.print(':');
+		msg.print(m_ncolorTemp, DEC);
+		msg.print(':');
+		msg.print(m_nred, DEC);
+		msg.print(':');
+		msg.print(m_ngreen, DEC);
+		msg.print(':');
+		msg.print(m_nblue, DEC);
+		msg.print(':');
+		msg.print(m_nclear, DEC);
+		msg.sendReading();
 
 	}
 	
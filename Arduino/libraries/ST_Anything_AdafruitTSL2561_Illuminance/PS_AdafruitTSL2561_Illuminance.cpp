@@ -119,7 +119,7 @@ namespace st
 		{
 			m_nlux = event.light;
 			//send data to SmartThings/Hubitat
-			Everything::sendSmartString(getName() + " " + String(m_nlux));
+			Message(getNameF()).value(m_nlux).sendReading();
 		}
 		else
 		{
@@ -115,7 +115,7 @@ namespace st
 
 		if (numGoodValues > 0) {
 			m_dblTemperatureSensorValue = totalTemperature / numGoodValues;
-			Everything::sendSmartString(getName() + " " + String(int(m_dblTemperatureSensorValue)));
+			Message(getNameF()).value(int(m_dblTemperatureSensorValue)).sendReading();
 		}
 		else
 		{
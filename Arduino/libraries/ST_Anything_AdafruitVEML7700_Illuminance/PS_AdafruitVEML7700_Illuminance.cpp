@@ -124,7 +124,7 @@ namespace st
 		if ((m_nLux >= 0) && (m_nLux <= 120000))
 		{
 			//send data to SmartThings/Hubitat
-			Everything::sendSmartString(getName() + " " + String(m_nLux));
+			Message(getNameF()).value(m_nLux).sendReading();
 		}
 		else
 		{
@@ -76,7 +76,7 @@ void PS_Adafruit_MPR121::refresh() {
 
   // Send 'init' message to allow Parent Driver to set numberOfButtons
   // attribute automatically
-  Everything::sendSmartString(getName() + F(" init"));
+  Message(getNameF()).value(F("init")).send();
 }
 
 void PS_Adafruit_MPR121::update() {  // Get the currently touched pads
@@ -129,7 +129,10 @@ if (!isBlockedStatus) {
             Serial.println(currentButton);
             startTouch[currentButton] = currentTime;
             waitingActive = currentTime;
-            Everything::sendSmartStringNow(getName() + String(currentButton) + _PUSHED);
+            Message msg(getNameF());
+            msg.print(currentButton);
+            msg.print(_PUSHED);
+            msg.sendNow();
             
             // F) if positive and equal to the old status then ...
             } else if (bitRead(curr_touched, currentButton) && (bitRead(old_touched, currentButton))) {
@@ -140,7 +143,10 @@ if (!isBlockedStatus) {
                 Serial.println(currentButton);
                 bitSet(isHold, currentButton);
                 waitingActive = currentTime;
-                Everything::sendSmartString(getName() + String(currentButton) + _HELD);
+                Message msg(getNameF());
+                msg.print(currentButton);
+                msg.print(_HELD);
+                msg.send();
               }
 
             // H) if negative and different from the old status then ... 
@@ -156,7 +162,10 @@ if (!isBlockedStatus) {
             // register the RELEASE for the button
             Serial.print("released: ");
             Serial.println(currentButton);
-            Everything::sendSmartString(getName() + String(currentButton) + _RELEASED);
+            Message msg(getNameF());
+            msg.print(currentButton);
+            msg.print(_RELEASED);
+            msg.send();
             }
           }
         }
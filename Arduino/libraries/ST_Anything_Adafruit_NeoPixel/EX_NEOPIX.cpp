@@ -81,7 +81,7 @@ namespace st
     
     void EX_NEOPIX::init()
     {
-        Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+        Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
     }
 
     void EX_NEOPIX::beSmart(const String &str)
@@ -107,12 +107,12 @@ namespace st
 
         writeRGBToPins();
 
-        Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+        Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
     }
     
     void EX_NEOPIX::refresh()
     {
-        Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+        Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
     }
     
     void EX_NEOPIX::setPin(byte pin)
@@ -101,7 +101,7 @@ namespace st
 		m_nLux = myLux.readLightLevel();
 
 		//Send data to SmartThings/Hubitat
-		Everything::sendSmartString(getName() + " " + String(m_nLux));
+		Message(getNameF()).value(m_nLux).sendReading();
 
 	}
 	
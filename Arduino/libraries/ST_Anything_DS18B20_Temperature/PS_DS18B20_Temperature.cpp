@@ -150,11 +150,13 @@ namespace st
 
 			if (m_numSensors == 1)
 			{
-				Everything::sendSmartString(getName() + " " + String(m_dblTemperatureSensorValue));
+				Message(getNameF()).value(m_dblTemperatureSensorValue).sendReading();
 			}
 			else
 			{
-				Everything::sendSmartString(getName() + index + " " + String(m_dblTemperatureSensorValue));
+				Message msg(getNameF());
+				msg.print(index);
+				msg.value(m_dblTemperatureSensorValue).sendReading();
 			}
 		}
 	}
@@ -192,7 +192,7 @@ namespace st
 			Serial.println(m_nSensorValue);		
 
 		// Send the value to our parent which will then update the device handler
-			Everything::sendSmartString(getName() + " " + String(m_nSensorValue));
+			Message(getNameF()).value(m_nSensorValue).sendReading();
 		}
 	}
 	
@@ -17,7 +17,7 @@
 //
 //
 //              I2C address options
-//                MAX44009_A0_LOW             0x4A      //< Pin A0 pulled Low
+//                MAX44009_A0_LOW             0x4A      //< Pin A0 pulled Low
 //                MAX44009_A0_HIGH            0x4B      //< Pin A0 pulled Hi
 //
 //
@@ -110,7 +110,7 @@ namespace st
 		else
 		{
 			//send data to SmartThings/Hubitat
-			Everything::sendSmartString(getName() + " " + String(m_fLux));
+			Message(getNameF()).value(m_fLux).sendReading();
 		}
 	}
 	
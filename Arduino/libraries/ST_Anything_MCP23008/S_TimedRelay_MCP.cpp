@@ -76,7 +76,7 @@ namespace st
 	
 	void S_TimedRelay_MCP::init()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	//update function 
@@ -129,7 +129,7 @@ namespace st
 				m_bTimerPending = false;
 
 				//Queue the relay status update the ST Cloud
-				Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+				Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 			}
 		}
 	}
@@ -155,7 +155,7 @@ namespace st
 				m_bTimerPending = true;
 			}
 			//Queue the relay status update the ST Cloud 
-			Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+			Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 			
 			//Set the initial count to zero
 			m_iCurrentCount = 0;
@@ -172,7 +172,7 @@ namespace st
 			m_bTimerPending = false;
 			
 			//Queue the relay status update the ST Cloud 
-			Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+			Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 			
 			//Reset the count to the number of required cycles to prevent Update() routine from running if someone sends an OFF command
 			m_iCurrentCount = m_iNumCycles;
@@ -187,7 +187,7 @@ namespace st
 	void S_TimedRelay_MCP::refresh()
 	{
 		//Queue the relay status update the ST Cloud
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	void S_TimedRelay_MCP::setOutputPin(byte pin)
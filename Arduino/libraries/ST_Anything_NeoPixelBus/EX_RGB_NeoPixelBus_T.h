@@ -133,7 +133,7 @@ namespace st
 			//initialize
 			void init()
 			{
-				Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+				Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	
 				if (st::Executor::debug) {
 					Serial.println("EX_RGB_NeoPixelBus_T - " + getName() + " init called. Sending Begin to RGB strip to clear it out.");
@@ -168,12 +168,12 @@ namespace st
 				writeCommandToOutput();
 
 				//Send data to SmartThings/Hubitat
-				Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+				Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 			}
 
 			void refresh()
 			{
-				Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+				Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 			}
 	};
 }
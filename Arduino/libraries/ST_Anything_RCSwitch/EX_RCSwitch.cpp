@@ -79,7 +79,7 @@ namespace st
 	void EX_RCSwitch::init()
 	{
 		writeStateToPin();
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH ? F("on") : F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH ? F("on") : F("off")).send();
 	}
 
 	void EX_RCSwitch::beSmart(const String &str)
@@ -100,12 +100,12 @@ namespace st
 		
 		writeStateToPin();
 		
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_RCSwitch::refresh()
 	{
-		Everything::sendSmartString(getName() + " " + (m_bCurrentState == HIGH?F("on"):F("off")));
+		Message(getNameF()).value(m_bCurrentState == HIGH?F("on"):F("off")).send();
 	}
 	
 	void EX_RCSwitch::setPin(byte pin)
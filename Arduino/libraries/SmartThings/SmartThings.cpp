@@ -6,6 +6,7 @@
 //
 //	History
 //	2017-02-04  Dan Ogorchock  Created
+//	2026-10-18  agent          Added sendBatch() to send several messages in one transmission
 //*******************************************************************************
 #include <SmartThings.h>
 
@@ -18,11 +19,46 @@ namespace st
 		_calloutFunction(callout),
 		_shieldType(shieldType),
 		_isDebugEnabled(enableDebug),
-		m_nTransmitInterval(transmitInterval)
+		m_nTransmitInterval(transmitInterval),
+		m_bBatching(false)
 	{
 
 	}
 
+	//*******************************************************************************
+	/// Send several Messages to the Hub 
+	//*******************************************************************************
+	void SmartThings::sendBatch(const char *const messages[], unsigned int count)
+	{
+		if (!isBatchingEnabled())
+		{
+			for (unsigned int i = 0; i < count; i++)
+			{
+				send(messages[i]);
+			}
+			return;
+		}
+
+		//size the body once so it is built with a single allocation
+		unsigned int length = 0;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			length += strlen(messages[i]) + 1;
+		}
+
+		String body;
+		body.reserve(length);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (i > 0)
+			{
+				body += '\n';
+			}
+			body += messages[i];
+		}
+		send(body);
+	}
+
 	//*****************************************************************************
 	//SmartThings::~SmartThings()
 	//*****************************************************************************
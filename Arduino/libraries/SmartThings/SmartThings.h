@@ -6,6 +6,12 @@
 //
 //	History
 //	2017-02-04  Dan Ogorchock  Created
+//	2026-10-18  agent          Added sendBatch() to send several messages in one transmission
+//	2026-10-18  agent          Added getCallout()/setCallout() (used by SmartThingsTask)
+//	2026-10-18  agent          Added isReadyToSend() for communication methods that transmit asynchronously
+//	2026-10-18  agent          Added isLinkUp() so messages can be kept while the network is down
+//	2026-10-18  agent          Added getHubHealth() (backoff/circuit breaker counters)
+//	2026-10-18  agent          Added popUndelivered() so messages a communication method gives up on go back to st::Everything
 //*******************************************************************************
 #ifndef __SMARTTHINGS_H__ 
 #define __SMARTTHINGS_H__
@@ -19,6 +25,8 @@ typedef void SmartThingsCallout_t(String message);
 
 namespace st
 {
+	class HubHealth;	//SmartThingsHubHealth.h
+
 	class SmartThings
 	{
 	private:
@@ -28,6 +36,7 @@ namespace st
 		bool _isDebugEnabled;
 		String _shieldType;
 		int m_nTransmitInterval;
+		bool m_bBatching;
 
 	public:
 
@@ -61,6 +70,64 @@ namespace st
 		//*******************************************************************************
 		virtual int getTransmitInterval() const { return m_nTransmitInterval; }
 
+		//*******************************************************************************
+		/// Send several Messages to the Hub 
+		///   If batching is enabled, all messages are packed into one newline-delimited
+		///   transmission (one connection/POST instead of one per message).  Otherwise
+		///   each message is passed to send() individually.
+		//*******************************************************************************
+		virtual void sendBatch(const char *const messages[], unsigned int count);
+
+		//*******************************************************************************
+		/// Enable/Disable batching in sendBatch() - requires a Hub driver that splits a
+		///   newline-delimited body (e.g. hubduino-parent-ethernet.groovy)
+		//*******************************************************************************
+		void enableBatching(bool enable) { m_bBatching = enable; }
+		bool isBatchingEnabled() const { return m_bBatching && supportsBatching(); }
+
+		//*******************************************************************************
+		/// Returns true if this communication method can carry a multi-message body
+		//*******************************************************************************
+		virtual bool supportsBatching() const { return false; }
+
+		//*******************************************************************************
+		/// Returns true once another Message can be passed to send()/sendBatch()
+		///   Communication methods that transmit asynchronously (see SmartThingsHttpClient.h)
+		///   advance the transmission in progress and return false until it has finished;
+		///   st::Everything keeps its messages queued meanwhile.
+		//*******************************************************************************
+		virtual bool isReadyToSend() { return true; }
+
+		//*******************************************************************************
+		/// Returns false while the link to the network (WiFi association, Ethernet cable)
+		///   is down, or the hub is considered down (circuit breaker open, see
+		///   SmartThingsHubHealth.h), when anything passed to send() would be lost.
+		///   st::Everything keeps its messages meanwhile if ENABLE_MESSAGE_SPOOL is
+		///   defined (see MessageSpool.h).
+		///   Must be cheap - it is called on every transmission.
+		//*******************************************************************************
+		virtual bool isLinkUp() { return true; }
+
+		//*******************************************************************************
+		/// Returns the health of the connection to the hub (backoff, circuit breaker and
+		///   their counters), or 0 if the communication method does not track it
+		//*******************************************************************************
+		virtual const HubHealth* getHubHealth() { return 0; }
+
+		//*******************************************************************************
+		/// Moves the oldest Message the communication method has given up on (e.g. its
+		///   retries ran out while the hub was down) into message - returns false if
+		///   there is none.  st::Everything takes them back on every pass and sends them
+		///   again (or spools them, see ENABLE_MESSAGE_SPOOL), so they are not lost.
+		//*******************************************************************************
+		virtual bool popUndelivered(String &message) { (void)message; return false; }
+
+		//*******************************************************************************
+		/// Get/Set the Callout Function that is called on Msg Reception
+		//*******************************************************************************
+		SmartThingsCallout_t* getCallout() const { return _calloutFunction; }
+		void setCallout(SmartThingsCallout_t *callout) { _calloutFunction = callout; }
+
 	};
 
 }
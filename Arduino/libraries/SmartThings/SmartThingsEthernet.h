@@ -9,6 +9,7 @@
 //  2017-05-02  Dan Ogorchock  Add support for W5500 Ethernet2 Shield
 //  2018-01-06  Dan Ogorchock  Added RSSI Interval as user-definable interval
 //  2020-07-26  Dan Ogorchock  Changed the final RSSI interval from 60 seconds to 900 seconds
+//  2026-10-18  agent          Ethernet/WiFi methods support batched (newline-delimited) POST bodies
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSETHERNET_H__ 
@@ -100,6 +101,10 @@ namespace st
 		//*******************************************************************************
 		virtual void send(String message) = 0; //all derived classes must implement this pure virtual function
 
+		//*******************************************************************************
+		/// The HTTP POST body can carry several newline-delimited messages
+		//*******************************************************************************
+		virtual bool supportsBatching() const { return true; }
 
 	};
 }
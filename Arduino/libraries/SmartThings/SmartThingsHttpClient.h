@@ -0,0 +1,567 @@
+//*******************************************************************************
+//	SmartThings Arduino Library - Non-blocking HTTP POST client
+//
+//	Sends one HTTP POST to the hub at a time as a state machine that is advanced
+//	by run(), instead of connecting, writing and waiting for the reply in a single
+//	blocking call:
+//
+//		Idle -> Connecting -> Writing -> AwaitingResponse -> (Closing) -> Idle
+//		Idle -> Waiting -> Connecting -> ...		(retry() after a failure)
+//
+//	  Connecting		- connect() to the hub.  The Arduino Client API has no
+//						  non-blocking connect, so this one step still waits for the
+//						  TCP handshake (or the network library's connect timeout).
+//	  Writing			- the request headers are written in one piece, then the
+//						  body at most HTTP_WRITE_CHUNK bytes per run()
+//	  AwaitingResponse	- reads whatever part of the reply has arrived, without
+//						  waiting for the rest: the status line ("HTTP/1.1 200 OK"),
+//						  the headers and CONTENT-LENGTH bytes of body
+//	  Closing			- stop()s the client, unless the connection is kept alive
+//	  Waiting			- retry() was called after a failure - the request goes out
+//						  again once the hub health backoff has passed
+//
+//	Keep-alive - the connection to the hub is kept open after a reply and reused
+//	for the next POST, so consecutive messages do not each pay for a TCP handshake
+//	and teardown.  It is closed (and the next POST connects again) when:
+//	  - the hub closes it, or answers "CONNECTION: close", HTTP/1.0 or without a
+//		CONTENT-LENGTH (the end of such a reply can only be told by the close)
+//	  - it has been idle for HTTP_KEEPALIVE_IDLE_TIMEOUT milliseconds
+//	  - a request fails
+//	If a reused connection turns out to have been dropped by the hub before any
+//	reply arrived, the request is sent again once on a new connection without
+//	involving the callback.  Define HTTP_KEEPALIVE_IDLE_TIMEOUT as 0 to close the
+//	connection after every POST.
+//
+//	Each request has its own timeout (from post() to the end of the reply) and an
+//	optional completion callback, called with the HTTP status code or one of the
+//	negative HTTP_* results below.  The callback may call post() or retry().
+//
+//	Hub health - every result is recorded in a st::HubHealth (see
+//	SmartThingsHubHealth.h).  After a failure, retry() waits for an exponential
+//	backoff instead of connecting again right away, and once the hub has failed
+//	HUB_FAILURE_THRESHOLD times in a row the circuit breaker opens: isReady() stays
+//	false and post() fails fast, without any connect(), until the backoff has passed
+//	and a single probe request has been answered.
+//
+//	The template parameter is the network library's client class (WiFiClient,
+//	EthernetClient, WiFiEspClient, ...) - anything with the Arduino Client API.
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//	2026-10-18  agent          Persistent (keep-alive) connection to the hub
+//	2026-10-18  agent          Hub health tracking - retry() backs off, circuit breaker
+//	2026-10-18  agent          Added getBody()
+//*******************************************************************************
+#ifndef __SMARTTHINGSHTTPCLIENT_H__
+#define __SMARTTHINGSHTTPCLIENT_H__
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "SmartThingsHubHealth.h"
+
+//Default time allowed for one request, from post() until the hub's reply has arrived (in milliseconds)
+#ifndef HTTP_RESPONSE_TIMEOUT
+	#define HTTP_RESPONSE_TIMEOUT 1000
+#endif
+
+//Maximum number of body bytes written per run()
+#ifndef HTTP_WRITE_CHUNK
+	#define HTTP_WRITE_CHUNK 256
+#endif
+
+//An idle connection to the hub is closed after this long (in milliseconds) - 0 closes it after every POST
+#ifndef HTTP_KEEPALIVE_IDLE_TIMEOUT
+	#define HTTP_KEEPALIVE_IDLE_TIMEOUT 30000
+#endif
+
+namespace st
+{
+	//*******************************************************************************
+	// Request results passed to the completion callback (HTTP status codes are > 0)
+	//*******************************************************************************
+	enum HttpResult
+	{
+		HTTP_CONNECT_FAILED = -1,	//connect() failed
+		HTTP_WRITE_FAILED = -2,		//the connection dropped while the request was written
+		HTTP_TIMEOUT = -3,			//no status line within the request's timeout
+		HTTP_NO_RESPONSE = -4		//the hub closed the connection without a status line
+	};
+
+	//*******************************************************************************
+	// Completion callback - context is the pointer given to post()
+	//*******************************************************************************
+	typedef void HttpCallback_t(void *context, int result);
+
+	template <class ClientT>
+	class HttpPostClient
+	{
+	public:
+		enum State
+		{
+			Idle,
+			Connecting,
+			Writing,
+			AwaitingResponse,
+			Closing,
+			Waiting
+		};
+
+	private:
+		enum ResponsePart
+		{
+			StatusLine,
+			Headers,
+			Body
+		};
+
+		ClientT m_Client;
+		IPAddress m_HostIP;
+		uint16_t m_nHostPort;
+		unsigned long m_nDefaultTimeout;
+
+		State m_State;
+		String m_Body;
+		unsigned int m_nWritten;			//body bytes written so far
+		bool m_bHeaderWritten;
+		byte m_nAttempts;
+		unsigned long m_nStartMillis;
+		unsigned long m_nTimeout;
+		HttpCallback_t *m_pCallback;
+		void *m_pContext;
+
+		//the reply
+		ResponsePart m_ResponsePart;
+		int m_nStatus;						//status code parsed so far
+		byte m_nStatusField;				//0 = in "HTTP/1.1", 1 = in the status code, 2 = after it
+		char m_Line[24];					//current header line, lower case (only the start of long lines is kept)
+		byte m_nLineLength;
+		long m_nBodyRemaining;				//-1 = no CONTENT-LENGTH
+		bool m_bReplyStarted;				//any byte of the reply has arrived
+
+		//the connection
+		bool m_bConnected;					//connect() succeeded and the connection has not been stop()ped since
+		bool m_bReused;						//the request went out on a connection kept alive from an earlier one
+		bool m_bCloseAfterReply;
+		unsigned long m_nIdleSinceMillis;
+		unsigned long m_nConnectCount;
+
+		HubHealth m_Health;
+
+		void writeHeader()
+		{
+			//one write() for the whole header - each print() can be a packet of its own on some network modules
+			char header[128];
+			int length = snprintf(header, sizeof(header),
+				"POST / HTTP/1.1\r\nHOST: %u.%u.%u.%u:%u\r\nCONTENT-TYPE: text\r\nCONNECTION: %s\r\nCONTENT-LENGTH: %u\r\n\r\n",
+				m_HostIP[0], m_HostIP[1], m_HostIP[2], m_HostIP[3], m_nHostPort, isKeepAliveEnabled() ? "KEEP-ALIVE" : "CLOSE", m_Body.length());
+			m_Client.write((const uint8_t*)header, length);
+			m_bHeaderWritten = true;
+		}
+
+		void parseHeaderLine()
+		{
+			m_Line[m_nLineLength] = '\0';
+			if (strncmp(m_Line, "content-length:", 15) == 0)
+			{
+				m_nBodyRemaining = atol(m_Line + 15);
+			}
+			else if (strncmp(m_Line, "connection:", 11) == 0 && strstr(m_Line + 11, "close") != 0)
+			{
+				m_bCloseAfterReply = true;
+			}
+		}
+
+		//parses the reply one character at a time - returns true once all of it has been read
+		bool parseResponse(char c)
+		{
+			switch (m_ResponsePart)
+			{
+				case StatusLine:
+					if (c == '\n')
+					{
+						m_ResponsePart = Headers;
+						m_nLineLength = 0;
+					}
+					else if (c == ' ')
+					{
+						if (m_nStatusField < 2)
+						{
+							m_nStatusField++;
+						}
+					}
+					else if (m_nStatusField == 0)
+					{
+						if (m_nLineLength == 7 && c == '0')
+						{
+							m_bCloseAfterReply = true;	//HTTP/1.0
+						}
+						m_nLineLength++;
+					}
+					else if (m_nStatusField == 1 && c >= '0' && c <= '9')
+					{
+						m_nStatus = m_nStatus * 10 + (c - '0');
+					}
+					return false;
+
+				case Headers:
+					if (c == '\n')
+					{
+						if (m_nLineLength > 0)
+						{
+							parseHeaderLine();
+							m_nLineLength = 0;
+							return false;
+						}
+						//end of the headers
+						if (m_nBodyRemaining > 0)
+						{
+							m_ResponsePart = Body;
+							return false;
+						}
+						if (m_nBodyRemaining < 0)
+						{
+							m_bCloseAfterReply = true;	//the body (if any) ends when the hub closes the connection
+						}
+						return true;
+					}
+					if (c != '\r' && m_nLineLength < sizeof(m_Line) - 1)
+					{
+						m_Line[m_nLineLength++] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+					}
+					return false;
+
+				case Body:
+					return --m_nBodyRemaining <= 0;
+			}
+			return false;
+		}
+
+		void closeConnection()
+		{
+			m_Client.stop();
+			m_bConnected = false;
+		}
+
+		void complete(int result)
+		{
+			if (result < 0)
+			{
+				m_Health.recordFailure();
+			}
+			else
+			{
+				m_Health.recordSuccess();
+			}
+			if (result < 0 || m_bCloseAfterReply || !isKeepAliveEnabled())
+			{
+				closeConnection();
+			}
+			else
+			{
+				m_nIdleSinceMillis = millis();
+			}
+			m_State = Idle;
+			if (m_pCallback != 0)
+			{
+				m_pCallback(m_pContext, result);	//may start the next request
+			}
+		}
+
+		//a request that went out on a kept alive connection failed before any reply arrived - the hub has
+		//probably dropped the connection meanwhile, so the request is sent again on a new one
+		bool reconnectIfStale()
+		{
+			if (!m_bReused || m_bReplyStarted)
+			{
+				return false;
+			}
+			closeConnection();
+			startRequest();
+			return true;
+		}
+
+		bool isConnectionUsable()
+		{
+			if (!m_bConnected || !isKeepAliveEnabled())
+			{
+				return false;
+			}
+			if (!m_Client.connected() || (uint32_t)(millis() - m_nIdleSinceMillis) >= HTTP_KEEPALIVE_IDLE_TIMEOUT)
+			{
+				closeConnection();
+				return false;
+			}
+			return true;
+		}
+
+		bool isTimedOut() const { return (uint32_t)(millis() - m_nStartMillis) >= m_nTimeout; }
+
+		//the status code has been read in full (the rest of the reply may still be missing)
+		bool hasStatus() const { return m_nStatus > 0 && (m_nStatusField == 2 || m_ResponsePart != StatusLine); }
+
+		void startRequest()
+		{
+			m_nWritten = 0;
+			m_bHeaderWritten = false;
+			m_ResponsePart = StatusLine;
+			m_nStatus = 0;
+			m_nStatusField = 0;
+			m_nLineLength = 0;
+			m_nBodyRemaining = -1;
+			m_bReplyStarted = false;
+			m_bCloseAfterReply = false;
+			m_nStartMillis = millis();
+			m_Health.recordAttempt();
+
+			m_bReused = isConnectionUsable();
+			if (m_bReused)
+			{
+				while (m_Client.available())
+				{
+					m_Client.read();		//anything left over from the previous reply
+				}
+				m_State = Writing;
+			}
+			else
+			{
+				m_Client.stop();		//make sure the socket of the previous request is free
+				m_State = Connecting;
+			}
+		}
+
+	public:
+		//*******************************************************************************
+		/// @brief  HttpPostClient Constructor
+		///   @param[in] hostIP - TCP/IP Address of the Hub
+		///   @param[in] hostPort - TCP/IP Port of the Hub
+		///   @param[in] timeout (optional) - default time allowed per request (in milliseconds)
+		//*******************************************************************************
+		HttpPostClient(IPAddress hostIP, uint16_t hostPort, unsigned long timeout = HTTP_RESPONSE_TIMEOUT) :
+			m_HostIP(hostIP),
+			m_nHostPort(hostPort),
+			m_nDefaultTimeout(timeout),
+			m_State(Idle),
+			m_nWritten(0),
+			m_bHeaderWritten(false),
+			m_nAttempts(0),
+			m_nStartMillis(0),
+			m_nTimeout(timeout),
+			m_pCallback(0),
+			m_pContext(0),
+			m_ResponsePart(StatusLine),
+			m_nStatus(0),
+			m_nStatusField(0),
+			m_nLineLength(0),
+			m_nBodyRemaining(-1),
+			m_bReplyStarted(false),
+			m_bConnected(false),
+			m_bReused(false),
+			m_bCloseAfterReply(false),
+			m_nIdleSinceMillis(0),
+			m_nConnectCount(0)
+		{
+		}
+
+		//*******************************************************************************
+		/// Start a POST of body - returns false (and does nothing) if a request is
+		///   still in progress, or if the hub is considered down (see isReady()).
+		///   timeout 0 uses the default given to the constructor.
+		//*******************************************************************************
+		bool post(const String &body, HttpCallback_t *callback = 0, void *context = 0, unsigned long timeout = 0)
+		{
+			if (m_State != Idle)
+			{
+				return false;
+			}
+			if (!m_Health.isRequestAllowed())
+			{
+				m_Health.recordRejected();		//fail fast - no connect() while backing off
+				return false;
+			}
+			m_Body = body;
+			m_pCallback = callback;
+			m_pContext = context;
+			m_nTimeout = timeout ? timeout : m_nDefaultTimeout;
+			m_nAttempts = 1;
+			startRequest();
+			return true;
+		}
+
+		//*******************************************************************************
+		/// Start the last request again on a new connection (e.g. from the callback
+		///   after HTTP_CONNECT_FAILED) - it waits until the backoff after the failure
+		///   has passed (see SmartThingsHubHealth.h), and meanwhile isIdle() is false
+		//*******************************************************************************
+		bool retry()
+		{
+			if (m_State != Idle || m_nAttempts == 0)
+			{
+				return false;
+			}
+			closeConnection();
+			m_State = Waiting;
+			return true;
+		}
+
+		//*******************************************************************************
+		/// Advance the request in progress by one step - never waits for the network,
+		///   except inside connect() (see above).  While idle, notices a kept alive
+		///   connection being closed by the hub or timing out.
+		//*******************************************************************************
+		void run()
+		{
+			switch (m_State)
+			{
+				case Idle:
+					if (m_bConnected)
+					{
+						isConnectionUsable();
+					}
+					break;
+
+				case Connecting:
+					m_nConnectCount++;
+					if (m_Client.connect(m_HostIP, m_nHostPort))
+					{
+						m_bConnected = true;
+						m_State = Writing;
+					}
+					else
+					{
+						complete(HTTP_CONNECT_FAILED);
+					}
+					break;
+
+				case Writing:
+				{
+					if (!m_Client.connected())
+					{
+						if (!reconnectIfStale())
+						{
+							complete(HTTP_WRITE_FAILED);
+						}
+						break;
+					}
+					if (isTimedOut())
+					{
+						complete(HTTP_TIMEOUT);
+						break;
+					}
+					if (!m_bHeaderWritten)
+					{
+						writeHeader();
+					}
+					unsigned int remaining = m_Body.length() - m_nWritten;
+					unsigned int chunk = remaining < HTTP_WRITE_CHUNK ? remaining : HTTP_WRITE_CHUNK;
+					if (chunk > 0)
+					{
+						size_t written = m_Client.write((const uint8_t*)m_Body.c_str() + m_nWritten, chunk);
+						if (written == 0)
+						{
+							if (!reconnectIfStale())
+							{
+								complete(HTTP_WRITE_FAILED);
+							}
+							break;
+						}
+						m_nWritten += written;
+					}
+					if (m_nWritten >= m_Body.length())
+					{
+						m_State = AwaitingResponse;
+					}
+					break;
+				}
+
+				case AwaitingResponse:
+				{
+					bool done = false;
+					while (!done && m_Client.available())
+					{
+						m_bReplyStarted = true;
+						done = parseResponse((char)m_Client.read());
+					}
+					if (done)
+					{
+						m_State = Closing;
+					}
+					else if (isTimedOut())
+					{
+						//the hub has answered, but the rest of the reply is missing - the connection cannot be reused
+						m_bCloseAfterReply = true;
+						complete(hasStatus() ? m_nStatus : (int)HTTP_TIMEOUT);
+					}
+					else if (!m_Client.connected() && !m_Client.available())
+					{
+						if (!reconnectIfStale())
+						{
+							m_bCloseAfterReply = true;
+							complete(hasStatus() ? m_nStatus : (int)HTTP_NO_RESPONSE);
+						}
+					}
+					break;
+				}
+
+				case Closing:
+					complete(m_nStatus);		//closes the connection unless it is kept alive
+					break;
+
+				case Waiting:
+					if (m_Health.isRequestAllowed())
+					{
+						if (m_nAttempts < 255)
+						{
+							m_nAttempts++;
+						}
+						startRequest();
+					}
+					break;
+			}
+		}
+
+		//*******************************************************************************
+		/// Run the request in progress to completion (blocking - bounded by its timeout
+		///   plus connect()).  Does not wait for the backoff of a request waiting to be
+		///   retried - it stays Waiting.
+		//*******************************************************************************
+		void finish()
+		{
+			while (m_State != Idle && m_State != Waiting)
+			{
+				run();
+				yield();
+			}
+		}
+
+		//*******************************************************************************
+		/// Close the connection to the hub (if one is kept alive) - only while idle
+		//*******************************************************************************
+		void disconnect()
+		{
+			if (m_State == Idle)
+			{
+				closeConnection();
+			}
+		}
+
+		//*******************************************************************************
+		/// Gets
+		//*******************************************************************************
+		bool isIdle() const { return m_State == Idle; }
+		bool isReady() const { return m_State == Idle && m_Health.isRequestAllowed(); }		//post() would start a request
+		State getState() const { return m_State; }
+		byte getAttempts() const { return m_nAttempts; }		//attempts at the current/last request (1 + retries)
+		const String& getBody() const { return m_Body; }		//body of the current/last request
+		bool isKeepAliveEnabled() const { return HTTP_KEEPALIVE_IDLE_TIMEOUT > 0; }
+		bool isConnected() const { return m_bConnected; }		//a connection is open (or kept alive)
+		unsigned long getConnectCount() const { return m_nConnectCount; }	//connect() calls so far
+		const IPAddress& getHostIP() const { return m_HostIP; }
+		uint16_t getHostPort() const { return m_nHostPort; }
+		ClientT& getClient() { return m_Client; }
+		const HubHealth& getHealth() const { return m_Health; }
+	};
+}
+#endif
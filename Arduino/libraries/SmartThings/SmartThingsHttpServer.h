@@ -0,0 +1,384 @@
+//*******************************************************************************
+//	SmartThings Arduino Library - Non-blocking HTTP request server
+//
+//	Reads the Hub's requests ("POST /switch1%20on? HTTP/1.1" ...) without waiting
+//	for a client: run() parses whatever bytes have arrived on each open connection
+//	and returns, so a slow or half-open client can no longer hold up the sketch.
+//
+//	  - up to HTTP_SERVER_MAX_CLIENTS requests are read at the same time, each by
+//		its own parser state machine over a fixed HTTP_REQUEST_BUFFER byte buffer
+//		(no String, no heap)
+//	  - the command is the request target between the first '/' and the '?' (or
+//		the end of the target), percent-decoded in place ("%20" -> ' ', ...)
+//	  - once the blank line ending the headers arrives, the reply is written
+//		(200 OK, or 204 No Content without a command) and the command is queued
+//		for pop(), in the order the requests were completed.  The connection is
+//		closed by the next run(), which gives the reply time to go out.
+//	  - a request that is not complete after HTTP_REQUEST_TIMEOUT milliseconds,
+//		or whose client disconnects, is dropped
+//	  - a command that does not fit the buffer is queued as an empty command
+//
+//	Several network libraries (Ethernet, WiFiNINA, WiFi101, WiFiEsp) return any
+//	connection that has unread data from server.available(), including those
+//	already being read.  run() reads every open connection dry before asking for
+//	a new one, and only asks while a slot is free, so that is only new data.
+//
+//	The template parameters are the network library's server class and the client
+//	class its available() returns (WiFiServer/WiFiClient, EthernetServer/
+//	EthernetClient, WiFiEspServer/WiFiEspClient, ...).
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//	2026-10-18  agent          The 204 response ends at the blank line after its status line (no stray CRLF)
+//*******************************************************************************
+#ifndef __SMARTTHINGSHTTPSERVER_H__
+#define __SMARTTHINGSHTTPSERVER_H__
+
+#include <Arduino.h>
+
+//Number of requests that are read at the same time
+#ifndef HTTP_SERVER_MAX_CLIENTS
+	#if defined(__AVR__)
+		#define HTTP_SERVER_MAX_CLIENTS 2
+	#else
+		#define HTTP_SERVER_MAX_CLIENTS 4
+	#endif
+#endif
+
+//Size of each request's command buffer (including the terminating '\0')
+#ifndef HTTP_REQUEST_BUFFER
+	#if defined(__AVR__)
+		#define HTTP_REQUEST_BUFFER 64
+	#else
+		#define HTTP_REQUEST_BUFFER 128
+	#endif
+#endif
+
+//Time allowed for a client to send its whole request (in milliseconds)
+#ifndef HTTP_REQUEST_TIMEOUT
+	#define HTTP_REQUEST_TIMEOUT 2000
+#endif
+
+namespace st
+{
+	template <class ServerT, class ClientT>
+	class HttpRequestServer
+	{
+	private:
+		enum State
+		{
+			Free,
+			Method,				//"POST"
+			Target,				//up to the first '/'
+			Command,			//up to the '?' (or the end of the target)
+			RequestLine,		//the rest of the request line
+			Headers,			//up to the blank line
+			Complete,			//replied - the command is waiting for pop()
+			Closing				//popped (or dropped) - the connection is closed by the next run()
+		};
+
+		struct Connection
+		{
+			ClientT client;
+			State state;
+			byte length;
+			bool overflow;
+			bool lineIsBlank;
+			byte sequence;					//order in which the requests were completed
+			unsigned long startMillis;
+			char command[HTTP_REQUEST_BUFFER];
+		};
+
+		ServerT m_Server;
+		Connection m_Connections[HTTP_SERVER_MAX_CLIENTS];
+		byte m_nNextSequence;				//given to the next completed request
+		byte m_nPopSequence;				//of the next command to pop()
+		unsigned long m_nRequestCount;
+		unsigned long m_nDroppedCount;
+
+		static byte hexValue(char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return 0xFF;
+		}
+
+		//decodes "%XX" escapes in place - a '%' not followed by two hex digits is kept as it is
+		static void percentDecode(char *s)
+		{
+			char *out = s;
+			for (char *in = s; *in; in++)
+			{
+				if (in[0] == '%' && hexValue(in[1]) != 0xFF && hexValue(in[2]) != 0xFF)
+				{
+					*out++ = (char)((hexValue(in[1]) << 4) | hexValue(in[2]));
+					in += 2;
+				}
+				else
+				{
+					*out++ = *in;
+				}
+			}
+			*out = '\0';
+		}
+
+		void endCommand(Connection &c)
+		{
+			c.command[c.length] = '\0';
+			percentDecode(c.command);
+		}
+
+		void completeRequest(Connection &c)
+		{
+			bool valid = !c.overflow && c.command[0] != '\0';
+			if (c.overflow)
+			{
+				c.command[0] = '\0';
+			}
+
+			//one write() - each print() can be a packet of its own on some network modules
+			static const char ok[] = "HTTP/1.1 200 OK\r\n\r\n";
+			static const char noContent[] = "HTTP/1.1 204 No Content\r\n\r\n";
+			if (valid)
+			{
+				c.client.write((const uint8_t*)ok, sizeof(ok) - 1);
+			}
+			else
+			{
+				c.client.write((const uint8_t*)noContent, sizeof(noContent) - 1);
+			}
+
+			c.sequence = m_nNextSequence++;
+			c.state = Complete;
+			m_nRequestCount++;
+		}
+
+		//parses one character of a request
+		void parse(Connection &c, char ch)
+		{
+			if (ch == '\n' && c.state < Headers)
+			{
+				//the request line ended early (no target or no '?')
+				if (c.state == Command)
+				{
+					endCommand(c);
+				}
+				c.state = Headers;
+				c.lineIsBlank = true;
+				return;
+			}
+
+			switch (c.state)
+			{
+				case Method:
+					if (ch == ' ')
+					{
+						c.state = Target;
+					}
+					break;
+
+				case Target:
+					if (ch == '/')
+					{
+						c.state = Command;
+					}
+					break;
+
+				case Command:
+					if (ch == '?' || ch == ' ' || ch == '\r')
+					{
+						endCommand(c);
+						c.state = RequestLine;
+					}
+					else if (c.length < HTTP_REQUEST_BUFFER - 1)
+					{
+						c.command[c.length++] = ch;
+					}
+					else
+					{
+						c.overflow = true;
+					}
+					break;
+
+				case RequestLine:
+					break;
+
+				case Headers:
+					if (ch == '\n')
+					{
+						if (c.lineIsBlank)
+						{
+							completeRequest(c);
+						}
+						c.lineIsBlank = true;
+					}
+					else if (ch != '\r')
+					{
+						c.lineIsBlank = false;
+					}
+					break;
+
+				default:
+					break;
+			}
+		}
+
+		void close(Connection &c)
+		{
+			c.client.stop();
+			c.state = Free;
+		}
+
+		void accept(const ClientT &client)
+		{
+			for (byte i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++)
+			{
+				Connection &c = m_Connections[i];
+				if (c.state == Free)
+				{
+					c.client = client;
+					c.state = Method;
+					c.length = 0;
+					c.overflow = false;
+					c.lineIsBlank = false;
+					c.command[0] = '\0';
+					c.startMillis = millis();
+					serviceConnection(c);
+					return;
+				}
+			}
+		}
+
+		bool hasFreeConnection() const
+		{
+			for (byte i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++)
+			{
+				if (m_Connections[i].state == Free)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void serviceConnection(Connection &c)
+		{
+			if (c.state == Free)
+			{
+				return;
+			}
+			if (c.state == Closing)
+			{
+				close(c);
+				return;
+			}
+
+			//read everything that has arrived - bytes after the end of the request (a body) are discarded
+			while (c.client.available())
+			{
+				char ch = (char)c.client.read();
+				if (c.state < Complete)
+				{
+					parse(c, ch);
+				}
+			}
+
+			if (c.state < Complete && (!c.client.connected() || (uint32_t)(millis() - c.startMillis) >= HTTP_REQUEST_TIMEOUT))
+			{
+				m_nDroppedCount++;
+				close(c);
+			}
+		}
+
+	public:
+		//*******************************************************************************
+		/// @brief  HttpRequestServer Constructor
+		///   @param[in] port - TCP/IP Port to listen on
+		//*******************************************************************************
+		HttpRequestServer(uint16_t port) :
+			m_Server(port),
+			m_nNextSequence(0),
+			m_nPopSequence(0),
+			m_nRequestCount(0),
+			m_nDroppedCount(0)
+		{
+			for (byte i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++)
+			{
+				m_Connections[i].state = Free;
+			}
+		}
+
+		//*******************************************************************************
+		/// Start listening (once the network is up)
+		//*******************************************************************************
+		void begin()
+		{
+			m_Server.begin();
+		}
+
+		//*******************************************************************************
+		/// Read whatever has arrived on the open connections, close finished ones and
+		///   accept a new one - never waits for a client
+		//*******************************************************************************
+		void run()
+		{
+			for (byte i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++)
+			{
+				serviceConnection(m_Connections[i]);
+			}
+
+			if (hasFreeConnection())
+			{
+				ClientT client = m_Server.available();
+				if (client)
+				{
+					accept(client);
+				}
+			}
+		}
+
+		//*******************************************************************************
+		/// Get the next received command, oldest first - returns false if there is none.
+		///   The command is empty if the request did not carry a valid one.
+		//*******************************************************************************
+		bool pop(String &command)
+		{
+			for (byte i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++)
+			{
+				Connection &c = m_Connections[i];
+				if (c.state == Complete && c.sequence == m_nPopSequence)
+				{
+					command = c.command;
+					c.state = Closing;
+					m_nPopSequence++;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//*******************************************************************************
+		/// Gets
+		//*******************************************************************************
+		byte getOpenCount() const					//connections being read or waiting to be closed
+		{
+			byte count = 0;
+			for (byte i = 0; i < HTTP_SERVER_MAX_CLIENTS; i++)
+			{
+				if (m_Connections[i].state != Free)
+				{
+					count++;
+				}
+			}
+			return count;
+		}
+		unsigned long getRequestCount() const { return m_nRequestCount; }	//complete requests so far
+		unsigned long getDroppedCount() const { return m_nDroppedCount; }	//requests dropped (timed out or disconnected) so far
+		ServerT& getServer() { return m_Server; }
+	};
+}
+#endif
@@ -0,0 +1,337 @@
+//*******************************************************************************
+//	SmartThings Arduino Library - HTTP transport core
+//
+//	Everything the Ethernet/WiFi communication methods (SmartThingsESP8266WiFi,
+//	SmartThingsESP32WiFi, SmartThingsESP32S3ETH, SmartThingsEthernetW5x00,
+//	SmartThingsWiFi101, SmartThingsWiFiNINA, SmartThingsWiFiEsp) have in common,
+//	written once:
+//	  - run() reads the Hub's requests (HttpRequestServer) and passes each command
+//		to the callout function
+//	  - send() POSTs a Message to the Hub (HttpPostClient), which isReadyToSend()
+//		advances without blocking.  send() never waits: a Message that arrives while
+//		the previous POST is still in progress (or while backing off) is held and
+//		POSTed by run()/isReadyToSend() once the client is ready - one POST per
+//		Message, or all of them in one newline-delimited batch if batching is
+//		enabled (see SmartThings::enableBatching()).
+//	  - a POST that could not connect is retried after the hub health backoff
+//		(see SmartThingsHubHealth.h), at most HTTP_MAX_RETRIES times and only until
+//		the circuit breaker opens, and isLinkUp()/getHubHealth() report on it
+//	  - a Message whose retries ran out, or that there is no room to hold, is never
+//		dropped: it is handed back through popUndelivered(), and st::Everything
+//		sends it again, or spools it ahead of the Messages queued after it while the
+//		hub is down - see SmartThings::popUndelivered()
+//
+//	The template parameters are the network library's server and client classes
+//	(WiFiServer/WiFiClient, EthernetServer/EthernetClient, ...).  A board library
+//	derives from SmartThingsHttpTransport<ServerT, ClientT>, brings the link up in
+//	init() (calling st_server.begin() once it is), and overrides the hooks below
+//	for whatever its hardware needs on the way:
+//	  maintainLink()		- every run(): OTA updates, DHCP lease renewal, RSSI reports
+//	  checkLink()			- before every POST: report (or restore) a lost link
+//	  restartLink()			- after a POST could not connect, before it is retried
+//	  isNetworkConnected()	- the link state, for isLinkUp()
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created from the identical run()/send() code of the seven board libraries
+//	2026-10-18  agent          send() holds a Message instead of waiting for (or dropping it behind) the POST in progress; retries are capped
+//	2026-10-18  agent          Constructors take shieldType by const reference - one String copy fewer per board constructor
+//	2026-10-18  agent          Messages given up on are handed back (popUndelivered()) instead of dropped; held Messages are only batched if batching is enabled
+//*******************************************************************************
+#ifndef __SMARTTHINGSHTTPTRANSPORT_H__
+#define __SMARTTHINGSHTTPTRANSPORT_H__
+
+#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpClient.h"
+#include "SmartThingsHttpServer.h"
+
+//A POST that could not connect is retried at most this many times (fewer if the circuit breaker opens first), then the Message is handed back to st::Everything
+#ifndef HTTP_MAX_RETRIES
+	#define HTTP_MAX_RETRIES 3
+#endif
+
+//Most characters of Messages send() holds while the client is busy (Messages beyond it are handed back to st::Everything)
+#ifndef HTTP_HELD_MAX_LENGTH
+	#if defined(__AVR__)
+		#define HTTP_HELD_MAX_LENGTH 128
+	#else
+		#define HTTP_HELD_MAX_LENGTH 512
+	#endif
+#endif
+
+namespace st
+{
+	template <class ServerT, class ClientT>
+	class SmartThingsHttpTransport : public SmartThingsEthernet
+	{
+	protected:
+		HttpRequestServer<ServerT, ClientT> st_server; //server - reads the Hub's requests without blocking (see SmartThingsHttpServer.h)
+		HttpPostClient<ClientT> st_http; //client - POSTs to the hub without blocking (see SmartThingsHttpClient.h)
+		String st_held; //Messages send() could not POST yet - newline-delimited, POSTed by postHeld()
+		String st_undelivered; //Messages given up on - newline-delimited, taken back with popUndelivered()
+		unsigned long st_nUndelivered; //Messages given up on so far (retries used up, or no room to hold them)
+
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink() {}
+
+		//*******************************************************************************
+		/// Called by send() before every POST
+		//*******************************************************************************
+		virtual void checkLink() {}
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink() {}
+
+		//*******************************************************************************
+		/// Returns false while the link to the network is down (for isLinkUp())
+		//*******************************************************************************
+		virtual bool isNetworkConnected() { return true; }
+
+		//*******************************************************************************
+		/// Called by st_http when a POST to the Hub has completed - a failed connection is retried after a backoff (see SmartThingsHubHealth.h)
+		//*******************************************************************************
+		static void postComplete(void *context, int result)
+		{
+			SmartThingsHttpTransport *self = static_cast<SmartThingsHttpTransport*>(context);
+
+			if (result == HTTP_CONNECT_FAILED)
+			{
+				//connection failed;
+				if (self->_isDebugEnabled)
+				{
+					Serial.println(F("***********************************************************"));
+					Serial.println(F("***** SmartThings.send() - Ethernet Connection Failed *****"));
+					Serial.println(F("***********************************************************"));
+					Serial.print(F("hubIP = "));
+					Serial.print(self->st_hubIP);
+					Serial.print(F(" "));
+					Serial.print(F("hubPort = "));
+					Serial.println(self->st_hubPort);
+				}
+
+				self->restartLink();
+
+				//the hub is considered down (isLinkUp() is false from here on), or the retries are used up
+				if (self->st_http.getHealth().isOpen() || self->st_http.getAttempts() > HTTP_MAX_RETRIES)
+				{
+					if (self->_isDebugEnabled)
+					{
+						Serial.println(F("SmartThings.send() - Hub unreachable - message handed back"));
+					}
+					self->giveUp(self->st_http.getBody());
+					return;
+				}
+
+				if (self->_isDebugEnabled)
+				{
+					Serial.println(F("***********************************************************"));
+					Serial.println(F("******        Attempting to resend missed data      *******"));
+					Serial.println(F("***********************************************************"));
+					Serial.print(F("Retrying in "));
+					Serial.print(self->st_http.getHealth().getTimeUntilAttempt());
+					Serial.println(F(" ms"));
+				}
+
+				self->st_http.retry();
+			}
+			else if (result < 0 && self->_isDebugEnabled)
+			{
+				Serial.print(F("SmartThings.send() - POST failed: "));
+				Serial.println(result);
+			}
+		}
+
+		//*******************************************************************************
+		/// Keeps Messages (one, or a newline-delimited batch) for popUndelivered()
+		//*******************************************************************************
+		void giveUp(const String &messages)
+		{
+			if (st_undelivered.length() > 0)
+			{
+				st_undelivered += '\n';
+			}
+			st_undelivered += messages;
+			st_nUndelivered++;
+		}
+
+		//*******************************************************************************
+		/// POSTs the held Messages once the client is ready for them - all of them in
+		///   one batch if batching is enabled, otherwise the oldest one
+		//*******************************************************************************
+		void postHeld()
+		{
+			if (st_held.length() > 0 && st_http.isReady())
+			{
+				checkLink();
+				int end = isBatchingEnabled() ? -1 : st_held.indexOf('\n');
+				if (end < 0)
+				{
+					st_http.post(st_held, postComplete, this);	//cannot be refused - isReady()
+					st_held = "";
+				}
+				else
+				{
+					st_http.post(st_held.substring(0, end), postComplete, this);
+					st_held.remove(0, end + 1);
+				}
+			}
+		}
+
+	public:
+		//*******************************************************************************
+		/// Constructors - the same arguments as SmartThingsEthernet's (STATIC, abbreviated STATIC, DHCP)
+		//*******************************************************************************
+		SmartThingsHttpTransport(IPAddress localIP, IPAddress localGateway, IPAddress localSubnetMask, IPAddress localDNSServer, uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, const String &shieldType, bool enableDebug, int transmitInterval, bool DHCP = false) :
+			SmartThingsEthernet(localIP, localGateway, localSubnetMask, localDNSServer, serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, DHCP),
+			st_server(serverPort),
+			st_http(st_hubIP, st_hubPort),
+			st_nUndelivered(0)
+		{
+		}
+
+		SmartThingsHttpTransport(IPAddress localIP, uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, const String &shieldType, bool enableDebug, int transmitInterval, bool DHCP = false) :
+			SmartThingsEthernet(localIP, serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, DHCP),
+			st_server(serverPort),
+			st_http(st_hubIP, st_hubPort),
+			st_nUndelivered(0)
+		{
+		}
+
+		SmartThingsHttpTransport(uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, const String &shieldType, bool enableDebug, int transmitInterval, bool DHCP = true) :
+			SmartThingsEthernet(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, DHCP),
+			st_server(serverPort),
+			st_http(st_hubIP, st_hubPort),
+			st_nUndelivered(0)
+		{
+		}
+
+		//*******************************************************************************
+		/// Run SmartThings Library - reads the Hub's requests and passes them to the callout function
+		//*******************************************************************************
+		virtual void run(void)
+		{
+			st_http.run();	//advance the POST in progress, if any
+			postHeld();
+
+			maintainLink();
+
+			st_server.run();	//read the Hub's requests that have arrived, if any - never waits for a client
+
+			String command;
+			while (st_server.pop(command))
+			{
+				if (command.length() > 0) {
+					if (_isDebugEnabled)
+					{
+						Serial.print(F("Handling request from ST. command = "));
+						Serial.println(command);
+					}
+					//Pass the message to user's SmartThings callout function
+					_calloutFunction(command);
+				}
+				else if (_isDebugEnabled)
+				{
+					Serial.println(F("No Valid Data Received"));
+				}
+			}
+		}
+
+		//*******************************************************************************
+		/// Send Message out over Ethernet to the Hub - never waits.  If the previous POST
+		///   is still in progress or the client is backing off (st::Everything waits for
+		///   isReadyToSend(), other callers may not), the Message is held and POSTed later.
+		//*******************************************************************************
+		virtual void send(String message)
+		{
+			if (st_held.length() == 0 && st_http.isReady())
+			{
+				checkLink();
+
+				//Start the POST - run() and isReadyToSend() advance it from here on, without blocking
+				st_http.post(message, postComplete, this);
+				return;
+			}
+
+			if (st_held.length() > 0 && st_held.length() + 1 + message.length() > HTTP_HELD_MAX_LENGTH)
+			{
+				if (_isDebugEnabled)
+				{
+					Serial.print(F("SmartThings.send() - Hub busy, no room to hold - message handed back: "));
+					Serial.println(message);
+				}
+				giveUp(message);
+				return;
+			}
+			if (st_held.length() > 0)
+			{
+				st_held += '\n';	//postHeld() POSTs the lines one by one, or as one batch if batching is enabled
+			}
+			st_held += message;
+		}
+
+		//*******************************************************************************
+		/// Advance the POST in progress - returns true once the next Message can be sent
+		///   (false while a POST or held Messages are in progress, or while backing off
+		///   after failed POSTs)
+		//*******************************************************************************
+		virtual bool isReadyToSend()
+		{
+			st_http.run();
+			postHeld();
+			return st_held.length() == 0 && st_http.isReady();
+		}
+
+		//*******************************************************************************
+		/// Returns false while the link to the network is down, or while the Hub is considered down (see SmartThingsHubHealth.h)
+		//*******************************************************************************
+		virtual bool isLinkUp()
+		{
+			return isNetworkConnected() && !st_http.getHealth().isOpen();
+		}
+
+		//*******************************************************************************
+		/// Returns the health of the connection to the Hub (backoff, circuit breaker and their counters)
+		//*******************************************************************************
+		virtual const HubHealth* getHubHealth()
+		{
+			return &st_http.getHealth();
+		}
+
+		//*******************************************************************************
+		/// Hands back the oldest Message given up on (retries used up, or no room to hold it)
+		//*******************************************************************************
+		virtual bool popUndelivered(String &message)
+		{
+			if (st_undelivered.length() == 0)
+			{
+				return false;
+			}
+			int end = st_undelivered.indexOf('\n');
+			if (end < 0)
+			{
+				message = st_undelivered;
+				st_undelivered = "";
+			}
+			else
+			{
+				message = st_undelivered.substring(0, end);
+				st_undelivered.remove(0, end + 1);
+			}
+			return true;
+		}
+
+		//*******************************************************************************
+		/// Gets
+		//*******************************************************************************
+		unsigned int getHeldLength() const { return st_held.length(); }	//characters of Messages waiting for the client
+		unsigned int getUndeliveredLength() const { return st_undelivered.length(); }	//characters of Messages waiting for popUndelivered()
+		unsigned long getUndeliveredCount() const { return st_nUndelivered; }		//Messages (or batches) handed back so far (retries used up, or no room to hold them)
+	};
+}
+#endif
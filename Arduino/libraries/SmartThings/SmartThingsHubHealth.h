@@ -0,0 +1,193 @@
+//*******************************************************************************
+//	SmartThings Arduino Library - Hub health tracking (backoff and circuit breaker)
+//
+//	Keeps track of whether the hub is answering the requests of one communication
+//	method, so that a hub which is rebooting or unreachable does not make every
+//	queued message pay for connect timeouts:
+//
+//	  Closed	- the hub is answering; requests go out as usual.  After a failed
+//				  request the next one waits for a backoff, which doubles with every
+//				  further consecutive failure (HUB_BACKOFF_INITIAL, 2x, 4x, ... up to
+//				  HUB_BACKOFF_MAX milliseconds, each shortened by up to a quarter at
+//				  random so several boards do not all retry at the same moment).
+//	  Open		- HUB_FAILURE_THRESHOLD consecutive requests have failed.  Requests
+//				  are refused without touching the network (the communication method
+//				  reports itself as not ready, so st::Everything keeps its messages)
+//				  until the backoff has passed.
+//	  HalfOpen	- the backoff has passed and one request is on its way as a probe.
+//				  If it succeeds the breaker closes; if it fails the breaker opens
+//				  again with twice the backoff.
+//
+//	A request counts as successful once the hub has answered it at all (any HTTP
+//	status code) - the hub is reachable, even if it did not like the message.
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//*******************************************************************************
+#ifndef __SMARTTHINGSHUBHEALTH_H__
+#define __SMARTTHINGSHUBHEALTH_H__
+
+#include <Arduino.h>
+
+//Backoff after the first failed request (in milliseconds) - doubled for each further consecutive failure
+#ifndef HUB_BACKOFF_INITIAL
+	#define HUB_BACKOFF_INITIAL 500
+#endif
+
+//Longest backoff between two attempts (in milliseconds)
+#ifndef HUB_BACKOFF_MAX
+	#define HUB_BACKOFF_MAX 60000
+#endif
+
+//Consecutive failed requests that open the circuit breaker
+#ifndef HUB_FAILURE_THRESHOLD
+	#define HUB_FAILURE_THRESHOLD 3
+#endif
+
+namespace st
+{
+	class HubHealth
+	{
+	public:
+		enum State
+		{
+			Closed,
+			Open,
+			HalfOpen
+		};
+
+	private:
+		State m_State;
+		byte m_nConsecutiveFailures;
+		unsigned long m_nBackoff;			//current backoff - 0 while the last request succeeded
+		unsigned long m_nFailedMillis;		//millis() of the last failure
+
+		//counters for monitoring
+		unsigned long m_nSuccesses;			//requests the hub answered
+		unsigned long m_nFailures;			//requests that did not reach the hub or got no answer
+		unsigned long m_nTrips;				//times the breaker opened after HUB_FAILURE_THRESHOLD failures
+		unsigned long m_nProbes;			//requests sent while the breaker was open
+		unsigned long m_nRejected;			//requests refused while the breaker was open or backing off
+
+	public:
+		//*******************************************************************************
+		/// @brief  HubHealth Constructor
+		//*******************************************************************************
+		HubHealth() :
+			m_State(Closed),
+			m_nConsecutiveFailures(0),
+			m_nBackoff(0),
+			m_nFailedMillis(0),
+			m_nSuccesses(0),
+			m_nFailures(0),
+			m_nTrips(0),
+			m_nProbes(0),
+			m_nRejected(0)
+		{
+		}
+
+		//*******************************************************************************
+		/// Returns true if a request may go out now - false while backing off after a
+		///   failure, or while a probe is on its way
+		//*******************************************************************************
+		bool isRequestAllowed() const
+		{
+			return m_State != HalfOpen && getTimeUntilAttempt() == 0;
+		}
+
+		//*******************************************************************************
+		/// Returns true while requests are refused because the hub is considered down -
+		///   the breaker is open (and no probe is due yet) or a probe is on its way
+		//*******************************************************************************
+		bool isOpen() const
+		{
+			return m_State == HalfOpen || (m_State == Open && getTimeUntilAttempt() > 0);
+		}
+
+		//*******************************************************************************
+		/// Called when a request is sent to the hub - the first one after the breaker
+		///   opened is the probe
+		//*******************************************************************************
+		void recordAttempt()
+		{
+			if (m_State == Open)
+			{
+				m_State = HalfOpen;
+				m_nProbes++;
+			}
+		}
+
+		//*******************************************************************************
+		/// Called when the hub has answered a request - closes the breaker
+		//*******************************************************************************
+		void recordSuccess()
+		{
+			m_State = Closed;
+			m_nConsecutiveFailures = 0;
+			m_nBackoff = 0;
+			m_nSuccesses++;
+		}
+
+		//*******************************************************************************
+		/// Called when a request did not reach the hub or got no answer - starts the
+		///   next backoff, and opens the breaker once there have been too many failures
+		///   in a row (or the probe failed)
+		//*******************************************************************************
+		void recordFailure()
+		{
+			m_nFailures++;
+			if (m_nConsecutiveFailures < 255)
+			{
+				m_nConsecutiveFailures++;
+			}
+
+			unsigned long backoff = HUB_BACKOFF_INITIAL;
+			for (byte i = 1; i < m_nConsecutiveFailures && backoff < HUB_BACKOFF_MAX; i++)
+			{
+				backoff *= 2;
+			}
+			if (backoff > HUB_BACKOFF_MAX)
+			{
+				backoff = HUB_BACKOFF_MAX;
+			}
+			m_nBackoff = backoff - micros() % (backoff / 4 + 1);	//jitter
+			m_nFailedMillis = millis();
+
+			if (m_State == HalfOpen)
+			{
+				m_State = Open;
+			}
+			else if (m_State == Closed && m_nConsecutiveFailures >= HUB_FAILURE_THRESHOLD)
+			{
+				m_State = Open;
+				m_nTrips++;
+			}
+		}
+
+		//*******************************************************************************
+		/// Called when a request was refused (see isRequestAllowed())
+		//*******************************************************************************
+		void recordRejected() { m_nRejected++; }
+
+		//*******************************************************************************
+		/// Gets
+		//*******************************************************************************
+		State getState() const { return m_State; }
+		byte getConsecutiveFailures() const { return m_nConsecutiveFailures; }
+		unsigned long getBackoff() const { return m_nBackoff; }
+		unsigned long getTimeUntilAttempt() const		//milliseconds until the backoff has passed (0 if not backing off)
+		{
+			uint32_t elapsed = millis() - m_nFailedMillis;
+			return elapsed >= m_nBackoff ? 0 : m_nBackoff - elapsed;
+		}
+		unsigned long getSuccessCount() const { return m_nSuccesses; }
+		unsigned long getFailureCount() const { return m_nFailures; }
+		unsigned long getTripCount() const { return m_nTrips; }
+		unsigned long getProbeCount() const { return m_nProbes; }
+		unsigned long getRejectedCount() const { return m_nRejected; }
+	};
+}
+#endif
@@ -0,0 +1,422 @@
+//*******************************************************************************
+//	SmartThings Arduino Library - UDP datagram communication method
+//
+//	Sends every message to the Hub as one UDP datagram instead of one TCP connection
+//	and HTTP POST, so a "contact1 open" reaches the Hub in a single packet, and
+//	receives the Hub's commands on the same socket.
+//
+//	Datagrams are text, in both directions:
+//		D<seq> <message>		a message (or a newline-delimited batch of messages)
+//		A<seq>					acknowledges message <seq>
+//	<seq> is a 16 bit sequence number, counted separately by each side.  On the Hub,
+//	the HubDuino Parent Ethernet driver speaks this protocol when its Protocol preference
+//	is set to UDP (HubDuino/Drivers/hubduino-parent-ethernet.groovy) - hubPort is then 39501.
+//
+//	  - every message is kept in a window of UDP_WINDOW_SIZE slots until the Hub
+//		acknowledges it, and only the unacknowledged ones are sent again, every
+//		UDP_RETRANSMIT_INTERVAL milliseconds.  A message that is still not
+//		acknowledged after UDP_MAX_RETRANSMITS retransmissions is given up on.
+//	  - isReadyToSend() returns false while the window is full, so st::Everything
+//		keeps its messages queued meanwhile
+//	  - every command from the Hub is acknowledged, and passed to the callout unless
+//		it is a retransmission of one of the last UDP_RECEIVED_HISTORY commands.
+//		The socket is read by run(), send() and isReadyToSend(), but the commands are
+//		held (up to UDP_COMMAND_QUEUE of them) and only run() passes them to the
+//		callout - st::Everything's callout can refresh devices and send messages, which
+//		must not happen while st::Everything is in the middle of sending.  A command
+//		that arrives while UDP_COMMAND_QUEUE are held is not acknowledged, so the Hub
+//		sends it again.
+//	  - only datagrams from hubIP are accepted
+//
+//	The network must already be up: the sketch starts WiFi or Ethernet before
+//	st::Everything::init() (see the board libraries, e.g. SmartThingsESP8266WiFi,
+//	for how).  The template parameter is the network library's UDP class (WiFiUDP,
+//	EthernetUDP, WiFiEspUDP, ...) - anything with the Arduino UDP API.
+//
+//	For Example:  st::Everything::SmartThing = new st::SmartThingsUdp<WiFiUDP>(serverPort, hubIp, hubPort, st::receiveSmartString);
+//
+//	License
+//	(C) Copyright 2017 Dan Ogorchock
+//
+//	History
+//	2026-10-18  agent          Created
+//	2026-10-18  agent          Documented the Hub side (HubDuino Parent Ethernet driver, Protocol UDP)
+//	2026-10-18  agent          Commands are passed to the callout by run() only, never from send()/isReadyToSend()
+//*******************************************************************************
+#ifndef __SMARTTHINGSUDP_H__
+#define __SMARTTHINGSUDP_H__
+
+#include "SmartThings.h"
+#include <IPAddress.h>
+
+//Number of messages that may be waiting for the Hub's acknowledgement
+#ifndef UDP_WINDOW_SIZE
+	#if defined(__AVR__)
+		#define UDP_WINDOW_SIZE 4
+	#else
+		#define UDP_WINDOW_SIZE 8
+	#endif
+#endif
+
+//An unacknowledged message is sent again after this long (in milliseconds)
+#ifndef UDP_RETRANSMIT_INTERVAL
+	#define UDP_RETRANSMIT_INTERVAL 250
+#endif
+
+//An unacknowledged message is given up on after this many retransmissions
+#ifndef UDP_MAX_RETRANSMITS
+	#define UDP_MAX_RETRANSMITS 8
+#endif
+
+//Size of the buffer a received datagram is read into (longer ones are cut off)
+#ifndef UDP_RECEIVE_BUFFER
+	#if defined(__AVR__)
+		#define UDP_RECEIVE_BUFFER 64
+	#else
+		#define UDP_RECEIVE_BUFFER 128
+	#endif
+#endif
+
+//Number of the Hub's most recent sequence numbers remembered to recognize retransmitted commands
+#ifndef UDP_RECEIVED_HISTORY
+	#define UDP_RECEIVED_HISTORY 8
+#endif
+
+//Number of the Hub's commands held until run() passes them to the callout
+#ifndef UDP_COMMAND_QUEUE
+	#if defined(__AVR__)
+		#define UDP_COMMAND_QUEUE 2
+	#else
+		#define UDP_COMMAND_QUEUE 4
+	#endif
+#endif
+
+namespace st
+{
+	template <class UdpT>
+	class SmartThingsUdp: public SmartThings
+	{
+	private:
+		struct Datagram
+		{
+			String body;
+			uint16_t seq;
+			bool inUse;
+			byte retransmits;
+			unsigned long sentMillis;
+		};
+
+		UdpT m_Udp;
+		uint16_t m_nLocalPort;
+		IPAddress m_HubIP;
+		uint16_t m_nHubPort;
+
+		Datagram m_Window[UDP_WINDOW_SIZE];
+		uint16_t m_nNextSeq;
+		uint16_t m_Received[UDP_RECEIVED_HISTORY];		//the Hub's most recent sequence numbers
+		byte m_nReceivedCount;
+		byte m_nReceivedIndex;
+		String m_Commands[UDP_COMMAND_QUEUE];		//commands received, not passed to the callout yet
+		byte m_nCommandsHead;
+		byte m_nCommandsHeld;
+
+		unsigned long m_nSentCount;
+		unsigned long m_nRetransmitCount;
+		unsigned long m_nLostCount;
+		unsigned long m_nCommandCount;
+		unsigned long m_nDuplicateCount;
+
+		void transmit(Datagram &d)
+		{
+			char header[8];
+			int length = snprintf(header, sizeof(header), "D%u ", d.seq);
+			m_Udp.beginPacket(m_HubIP, m_nHubPort);
+			m_Udp.write((const uint8_t*)header, length);
+			m_Udp.write((const uint8_t*)d.body.c_str(), d.body.length());
+			m_Udp.endPacket();
+			d.sentMillis = millis();
+		}
+
+		void acknowledge(uint16_t seq)
+		{
+			char ack[8];
+			int length = snprintf(ack, sizeof(ack), "A%u", seq);
+			m_Udp.beginPacket(m_HubIP, m_nHubPort);
+			m_Udp.write((const uint8_t*)ack, length);
+			m_Udp.endPacket();
+		}
+
+		bool isRetransmission(uint16_t seq) const
+		{
+			for (byte i = 0; i < m_nReceivedCount; i++)
+			{
+				if (m_Received[i] == seq)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void rememberReceived(uint16_t seq)
+		{
+			m_Received[m_nReceivedIndex] = seq;
+			m_nReceivedIndex = (m_nReceivedIndex + 1) % UDP_RECEIVED_HISTORY;
+			if (m_nReceivedCount < UDP_RECEIVED_HISTORY)
+			{
+				m_nReceivedCount++;
+			}
+		}
+
+		//parses "<seq>" at text - returns the character after it, or 0 if there is no number
+		static const char* parseSeq(const char *text, uint16_t &seq)
+		{
+			if (*text < '0' || *text > '9')
+			{
+				return 0;
+			}
+			unsigned long value = 0;
+			while (*text >= '0' && *text <= '9')
+			{
+				value = value * 10 + (*text++ - '0');
+			}
+			seq = (uint16_t)value;
+			return text;
+		}
+
+		//reads the datagrams that have arrived - acknowledgements free their window slot,
+		//commands are acknowledged and held for deliverCommands()
+		void receive()
+		{
+			for (byte n = 0; n < 2 * UDP_WINDOW_SIZE; n++)		//bounded, so a flood cannot hold up the sketch
+			{
+				if (m_Udp.parsePacket() <= 0)
+				{
+					return;
+				}
+				char buffer[UDP_RECEIVE_BUFFER];
+				int length = m_Udp.read((unsigned char*)buffer, sizeof(buffer) - 1);
+				if (length <= 0 || !(m_Udp.remoteIP() == m_HubIP))
+				{
+					continue;
+				}
+				buffer[length] = '\0';
+
+				uint16_t seq;
+				const char *rest = parseSeq(buffer + 1, seq);
+				if (rest == 0)
+				{
+					continue;
+				}
+
+				if (buffer[0] == 'A')
+				{
+					for (byte i = 0; i < UDP_WINDOW_SIZE; i++)
+					{
+						if (m_Window[i].inUse && m_Window[i].seq == seq)
+						{
+							m_Window[i].inUse = false;
+							m_Window[i].body = "";
+							break;
+						}
+					}
+				}
+				else if (buffer[0] == 'D' && *rest == ' ')
+				{
+					if (isRetransmission(seq))
+					{
+						acknowledge(seq);
+						m_nDuplicateCount++;	//the acknowledgement was lost - the command has already been received
+						continue;
+					}
+					if (m_nCommandsHeld >= UDP_COMMAND_QUEUE)
+					{
+						continue;	//no room - not acknowledged, so the Hub sends it again
+					}
+					acknowledge(seq);
+					rememberReceived(seq);
+					m_Commands[(m_nCommandsHead + m_nCommandsHeld) % UDP_COMMAND_QUEUE] = rest + 1;
+					m_nCommandsHeld++;
+					if (_isDebugEnabled)
+					{
+						Serial.print(F("SmartThingsUdp: command received = "));
+						Serial.println(rest + 1);
+					}
+				}
+			}
+		}
+
+		//passes the held commands to the callout, oldest first
+		void deliverCommands()
+		{
+			while (m_nCommandsHeld > 0)
+			{
+				String command = m_Commands[m_nCommandsHead];
+				m_Commands[m_nCommandsHead] = "";
+				m_nCommandsHead = (m_nCommandsHead + 1) % UDP_COMMAND_QUEUE;
+				m_nCommandsHeld--;
+				m_nCommandCount++;
+				_calloutFunction(command);		//may send(), which may receive (and hold) further commands
+			}
+		}
+
+		//sends the unacknowledged messages again once their retransmit interval has passed
+		void retransmit()
+		{
+			for (byte i = 0; i < UDP_WINDOW_SIZE; i++)
+			{
+				Datagram &d = m_Window[i];
+				if (!d.inUse || (uint32_t)(millis() - d.sentMillis) < UDP_RETRANSMIT_INTERVAL)
+				{
+					continue;
+				}
+				if (d.retransmits >= UDP_MAX_RETRANSMITS)
+				{
+					m_nLostCount++;
+					if (_isDebugEnabled)
+					{
+						Serial.print(F("SmartThingsUdp: no acknowledgement from the Hub - message lost: "));
+						Serial.println(d.body);
+					}
+					d.inUse = false;
+					d.body = "";
+					continue;
+				}
+				d.retransmits++;
+				m_nRetransmitCount++;
+				transmit(d);
+			}
+		}
+
+		int findFreeSlot() const
+		{
+			for (byte i = 0; i < UDP_WINDOW_SIZE; i++)
+			{
+				if (!m_Window[i].inUse)
+				{
+					return i;
+				}
+			}
+			return -1;
+		}
+
+	public:
+		//*******************************************************************************
+		/// @brief  SmartThings UDP Constructor
+		///   @param[in] localPort - UDP Port of the Arduino (the Hub sends its commands here)
+		///   @param[in] hubIP - TCP/IP Address of the Hub
+		///   @param[in] hubPort - UDP Port of the Hub
+		///   @param[in] callout - Set the Callout Function that is called on Msg Reception
+		///   @param[in] shieldType (optional) - Set the Reported SheildType to the Server
+		///   @param[in] enableDebug (optional) - Enable internal Library debug
+		///   @param[in] transmitInterval (optional) - minimum time between messages (in milliseconds)
+		//*******************************************************************************
+		SmartThingsUdp(uint16_t localPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType = "UDP", bool enableDebug = false, int transmitInterval = 100) :
+			SmartThings(callout, shieldType, enableDebug, transmitInterval),
+			m_nLocalPort(localPort),
+			m_HubIP(hubIP),
+			m_nHubPort(hubPort),
+			m_nNextSeq(0),
+			m_nReceivedCount(0),
+			m_nReceivedIndex(0),
+			m_nCommandsHead(0),
+			m_nCommandsHeld(0),
+			m_nSentCount(0),
+			m_nRetransmitCount(0),
+			m_nLostCount(0),
+			m_nCommandCount(0),
+			m_nDuplicateCount(0)
+		{
+			for (byte i = 0; i < UDP_WINDOW_SIZE; i++)
+			{
+				m_Window[i].inUse = false;
+			}
+		}
+
+		//*******************************************************************************
+		/// Initialize SmartThingsUdp Library - the network must already be up
+		//*******************************************************************************
+		virtual void init(void)
+		{
+			m_Udp.begin(m_nLocalPort);
+			m_nNextSeq = (uint16_t)micros();	//so the Hub does not take the first messages after a restart for retransmissions
+
+			Serial.print(F("SmartThingsUdp: localPort = "));
+			Serial.print(m_nLocalPort);
+			Serial.print(F(", hubIP = "));
+			Serial.print(m_HubIP);
+			Serial.print(F(", hubPort = "));
+			Serial.println(m_nHubPort);
+		}
+
+		//*******************************************************************************
+		/// Run SmartThingsUdp Library - delivers the Hub's commands and retransmits
+		///   unacknowledged messages
+		//*******************************************************************************
+		virtual void run(void)
+		{
+			receive();
+			deliverCommands();
+			retransmit();
+		}
+
+		//*******************************************************************************
+		/// Send Message to the Hub - waits for a free window slot first if necessary
+		///   (st::Everything waits for isReadyToSend(), other callers may not)
+		//*******************************************************************************
+		virtual void send(String message)
+		{
+			int slot;
+			while ((slot = findFreeSlot()) < 0)
+			{
+				receive();
+				retransmit();
+				yield();
+			}
+
+			Datagram &d = m_Window[slot];
+			d.body = message;
+			d.seq = m_nNextSeq++;
+			d.retransmits = 0;
+			d.inUse = true;
+			m_nSentCount++;
+			transmit(d);
+		}
+
+		virtual bool supportsBatching() const { return true; }
+
+		//*******************************************************************************
+		/// Reads the Hub's acknowledgements - returns true while the window has room
+		//*******************************************************************************
+		virtual bool isReadyToSend()
+		{
+			receive();
+			retransmit();
+			return findFreeSlot() >= 0;
+		}
+
+		//*******************************************************************************
+		/// Gets
+		//*******************************************************************************
+		byte getPendingCount() const				//messages waiting for the Hub's acknowledgement
+		{
+			byte count = 0;
+			for (byte i = 0; i < UDP_WINDOW_SIZE; i++)
+			{
+				if (m_Window[i].inUse)
+				{
+					count++;
+				}
+			}
+			return count;
+		}
+		unsigned long getSentCount() const { return m_nSentCount; }				//messages sent (not counting retransmissions)
+		unsigned long getRetransmitCount() const { return m_nRetransmitCount; }
+		unsigned long getLostCount() const { return m_nLostCount; }				//messages given up on
+		unsigned long getCommandCount() const { return m_nCommandCount; }			//commands delivered to the callout
+		byte getHeldCommandCount() const { return m_nCommandsHeld; }				//commands received, waiting for run()
+		unsigned long getDuplicateCount() const { return m_nDuplicateCount; }		//retransmitted commands ignored
+		UdpT& getUdp() { return m_Udp; }
+	};
+}
+#endif
@@ -6,6 +6,11 @@
 //
 //	History
 //	2025-09-11  Dan Ogorchock  Created
+//	2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//	2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//	2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//	2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//	2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSESP32S3ETH_H__ 
@@ -13,7 +18,7 @@
 
 #include <SPI.h>
 #include <Ethernet.h>
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 
 // Define W5500 pin assignments
 #define W5500_CS    14  // Chip Select pin
@@ -29,13 +34,27 @@
 
 namespace st
 {
-	class SmartThingsESP32S3ETH: public SmartThingsEthernet
+	class SmartThingsESP32S3ETH: public SmartThingsHttpTransport<EthernetServer, EthernetClient>
 	{
 	private:
 		//Ethernet W5500 Specific 
 		byte st_mac[6];
-		EthernetServer st_server; //server
-		EthernetClient st_client; //client
+
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
+		//*******************************************************************************
+		/// Returns false while the Ethernet cable is unplugged (a W5100, which cannot tell, always reports the link up)
+		//*******************************************************************************
+		virtual bool isNetworkConnected();
 
 	public:
 
@@ -77,16 +96,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsEthernet Library 
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub 
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
@@ -15,6 +15,11 @@
 //  2020-06-20  Dan Ogorchock  Add user selectable host name (repurposing the old shieldType variable)
 //  2024-04-28  Dan Ogorchock  Added OTA update capability
 //  2025-02-23  Dan Ogorchock  Modified to work with the ESP32 v3.0 and newer board manager package
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //
 //*******************************************************************************
 
@@ -28,8 +33,7 @@ namespace st
 	// SmartThingsESP32WiFi Constructor - Static IP
 	//*******************************************************************************
 	SmartThingsESP32WiFi::SmartThingsESP32WiFi(String ssid, String password, IPAddress localIP, IPAddress localGateway, IPAddress localSubnetMask, IPAddress localDNSServer, uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType, bool enableDebug, int transmitInterval) :
-		SmartThingsEthernet(localIP, localGateway, localSubnetMask, localDNSServer, serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, false),
-		st_server(serverPort)
+		SmartThingsHttpTransport<WiFiServer, WiFiClient>(localIP, localGateway, localSubnetMask, localDNSServer, serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, false)
 	{
 		ssid.toCharArray(st_ssid, sizeof(st_ssid));
 		password.toCharArray(st_password, sizeof(st_password));
@@ -39,8 +43,7 @@ namespace st
 	// SmartThingsESP32WiFI Constructor - DHCP
 	//*******************************************************************************
 	SmartThingsESP32WiFi::SmartThingsESP32WiFi(String ssid, String password, uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType, bool enableDebug, int transmitInterval) :
-		SmartThingsEthernet(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true),
-		st_server(serverPort)
+		SmartThingsHttpTransport<WiFiServer, WiFiClient>(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true)
 	{
 		ssid.toCharArray(st_ssid, sizeof(st_ssid));
 		password.toCharArray(st_password, sizeof(st_password));
@@ -50,8 +53,7 @@ namespace st
 	// SmartThingsESP32WiFI Constructor - DHCP
 	//*******************************************************************************
 	SmartThingsESP32WiFi::SmartThingsESP32WiFi(uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType, bool enableDebug, int transmitInterval) :
-		SmartThingsEthernet(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true),
-		st_server(serverPort)
+		SmartThingsHttpTransport<WiFiServer, WiFiClient>(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true)
 	{
 		st_preExistingConnection = true;
 	}
@@ -235,16 +237,13 @@ namespace st
         Serial.println();
 	}
 
-	//*****************************************************************************
-	// Run SmartThingsESP32WiFI Library
-	//*****************************************************************************
-	void SmartThingsESP32WiFi::run(void)
+	//*******************************************************************************
+	/// Called by run() on every pass, before the Hub's requests are read
+	//*******************************************************************************
+	void SmartThingsESP32WiFi::maintainLink()
 	{
-        
-        ArduinoOTA.handle();
-        
-        String readString;
-		String tempString;
+		ArduinoOTA.handle();
+
 		String strRSSI;
 
 		if (WiFi.isConnected() == false)
@@ -279,85 +278,12 @@ namespace st
 				}
 			}
 		}
-
-		WiFiClient client = st_server.available();
-		if (client) {
-			boolean currentLineIsBlank = true;
-			while (client.connected()) {
-				if (client.available()) {
-					char c = client.read();
-					//read char by char HTTP request
-					if (readString.length() < 200) {
-						//store characters to string
-						readString += c;
-					}
-					else
-					{
-						if (_isDebugEnabled)
-						{
-							Serial.println(F(""));
-							Serial.println(F("SmartThings.run() - Exceeded 200 character limit"));
-							Serial.println(F(""));
-						}
-					}
-					// if you've gotten to the end of the line (received a newline
-					// character) and the line is blank, the http request has ended,
-					// so you can send a reply
-					if (c == '\n' && currentLineIsBlank) {
-						//now output HTML data header
-						tempString = readString.substring(readString.indexOf('/') + 1, readString.indexOf('?'));
-
-						if (tempString.length() > 0) {
-							client.println(F("HTTP/1.1 200 OK")); //send new page
-							client.println();
-						}
-						else {
-							client.println(F("HTTP/1.1 204 No Content"));
-							client.println();
-							client.println();
-							if (_isDebugEnabled)
-							{
-								Serial.println(F("No Valid Data Received"));
-							}
-						}
-						break;
-					}
-					if (c == '\n') {
-						// you're starting a new line
-						currentLineIsBlank = true;
-					}
-					else if (c != '\r') {
-						// you've gotten a character on the current line
-						currentLineIsBlank = false;
-					}
-				}
-			}
-
-			delay(1);
-			//stopping client
-			client.stop();
-
-			//Handle the received data after cleaning up the network connection
-			if (tempString.length() > 0) {
-				if (_isDebugEnabled)
-				{
-					Serial.print(F("Handling request from ST. tempString = "));
-					Serial.println(tempString);
-				}
-				//Pass the message to user's SmartThings callout function
-				tempString.replace("%20", " ");  //Clean up for Hubitat
-				_calloutFunction(tempString);
-			}
-
-			readString = "";
-			tempString = "";
-		}
 	}
 
 	//*******************************************************************************
-	/// Send Message out over Ethernet to the Hub
+	/// Called by send() before every POST
 	//*******************************************************************************
-	void SmartThingsESP32WiFi::send(String message)
+	void SmartThingsESP32WiFi::checkLink()
 	{
 		if (WiFi.isConnected() == false)
 		{
@@ -371,102 +297,29 @@ namespace st
 			//WiFi.reconnect();
 			//init();
 		}
+	}
 
-		//WiFiClient st_client;
-
-		//Make sure the client is stopped, to free up socket for new connection
-		st_client.stop();
-
-		if (st_client.connect(st_hubIP, st_hubPort))
-		{
-			st_client.println(F("POST / HTTP/1.1"));
-			st_client.print(F("HOST: "));
-			st_client.print(st_hubIP);
-			st_client.print(F(":"));
-			st_client.println(st_hubPort);
-			st_client.println(F("CONTENT-TYPE: text"));
-            st_client.println(F("CONNECTION: CLOSE"));
-			st_client.print(F("CONTENT-LENGTH: "));
-			st_client.println(message.length());
-			st_client.println();
-			st_client.print(message);
-		}
-		else
+	//*******************************************************************************
+	/// Called when a POST could not connect to the Hub, before it is retried
+	//*******************************************************************************
+	void SmartThingsESP32WiFi::restartLink()
+	{
+		if (_isDebugEnabled)
 		{
-			//connection failed;
-			if (_isDebugEnabled)
-			{
-				Serial.println(F("***********************************************************"));
-				Serial.println(F("***** SmartThings.send() - Ethernet Connection Failed *****"));
-				Serial.println(F("***********************************************************"));
-				Serial.print(F("hubIP = "));
-				Serial.print(st_hubIP);
-				Serial.print(F(" "));
-				Serial.print(F("hubPort = "));
-				Serial.println(st_hubPort);
-
-				Serial.println(F("***********************************************************"));
-				Serial.println(F("**** WiFi Disconnected.  ESP32 should auto-reconnect.  ***"));
-				Serial.println(F("***********************************************************"));
-			}
-
-			//WiFi.reconnect();
-			//init();      //Re-Init connection to get things working again
-
-			if (_isDebugEnabled)
-			{
-				Serial.println(F("***********************************************************"));
-				Serial.println(F("******        Attempting to resend missed data      *******"));
-				Serial.println(F("***********************************************************"));
-			}
-
-
-			st_client.flush();
-			st_client.stop();
-			if (st_client.connect(st_hubIP, st_hubPort))
-			{
-				st_client.println(F("POST / HTTP/1.1"));
-				st_client.print(F("HOST: "));
-				st_client.print(st_hubIP);
-				st_client.print(F(":"));
-				st_client.println(st_hubPort);
-				st_client.println(F("CONTENT-TYPE: text"));
-				st_client.print(F("CONTENT-LENGTH: "));
-				st_client.println(message.length());
-				st_client.println();
-				st_client.println(message);
-			}
-
+			Serial.println(F("***********************************************************"));
+			Serial.println(F("**** WiFi Disconnected.  ESP32 should auto-reconnect.  ***"));
+			Serial.println(F("***********************************************************"));
 		}
 
-        // Wait for a response
-        unsigned long timeout = millis();
-        while(!st_client.available())
-        {
-            if(millis() - timeout > 1000)
-            {
-                Serial.println(F("Post request timed out\n"));
-                st_client.stop();
-                return;
-            }
-        }
-
-
-		//if (_isDebugEnabled) { Serial.println(F("WiFi.send(): Reading for reply data "));}
-		// read any data returned from the POST
-        //while (st_client.connected()) {
-        while (st_client.available() && st_client.connected()) {
-			char c = st_client.read(); //gets byte from ethernet buffer
-            /*if((int) c == 255)
-            {
-                if(_isDebugEnabled)
-                    Serial.println(F("Breaking due to invalid value"));
-                break;
-            }*/
-            if (_isDebugEnabled) { Serial.print(c); } //prints byte to serial monitor
-		}
+		//WiFi.reconnect();
+		//init();      //Re-Init connection to get things working again
+	}
 
-		delay(1);
-		st_client.stop();
+	//*******************************************************************************
+	/// Returns false while WiFi is disconnected
+	//*******************************************************************************
+	bool SmartThingsESP32WiFi::isNetworkConnected()
+	{
+		return WiFi.isConnected();
 	}
 }
@@ -14,13 +14,18 @@
 //  2020-06-20  Dan Ogorchock  Add user selectable host name (repurposing the old shieldType variable)
 //  2024-04-28  Dan Ogorchock  Added OTA update capability
 //  2025-02-23  Dan Ogorchock  Modified to work with the ESP32 v3.0 and newer board manager package
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSESP32WIFI_H__
 #define __SMARTTHINGSESP32WIFI_H__
 
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 
 //*******************************************************************************
 // Using ESP32 WiFi
@@ -30,7 +35,7 @@
 
 namespace st
 {
-	class SmartThingsESP32WiFi: public SmartThingsEthernet
+	class SmartThingsESP32WiFi: public SmartThingsHttpTransport<WiFiServer, WiFiClient>
 	{
 	private:
 		//ESP32 WiFi Specific
@@ -38,8 +43,6 @@ namespace st
 		char st_password[50];
         static int disconnectCounter;	
 		boolean st_preExistingConnection = false;
-		WiFiServer st_server; //server
-		WiFiClient st_client; //client
 		long previousMillis;
 		long RSSIsendInterval;
 		char st_devicename[50];
@@ -49,6 +52,27 @@ namespace st
 		//**************************************************************************************
 		static void WiFiEvent(WiFiEvent_t event);
 
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called by send() before every POST
+		//*******************************************************************************
+		virtual void checkLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
+		//*******************************************************************************
+		/// Returns false while WiFi is disconnected
+		//*******************************************************************************
+		virtual bool isNetworkConnected();
+
 	public:
 		//*******************************************************************************
 		/// @brief  SmartThings ESP32 WiFi Constructor - Static IP
@@ -101,16 +125,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsESP32WiFI Library
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
@@ -13,6 +13,11 @@
 //  2018-12-10  Dan Ogorchock  Add user selectable host name (repurposing the old shieldType variable)
 //  2019-06-03  Dan Ogorchock  Changed to wait on st_client.available() instead of st_client.connected()
 //  2019-06-25  Dan Ogorchock  Fix default hostname to not use underscore character
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //*******************************************************************************
 
 #include "SmartThingsESP8266WiFi.h"
@@ -23,8 +28,7 @@ namespace st
 	// SmartThingsESP8266WiFI Constructor - Static IP
 	//*******************************************************************************
 	SmartThingsESP8266WiFi::SmartThingsESP8266WiFi(String ssid, String password, IPAddress localIP, IPAddress localGateway, IPAddress localSubnetMask, IPAddress localDNSServer, uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType, bool enableDebug, int transmitInterval) :
-		SmartThingsEthernet(localIP, localGateway, localSubnetMask, localDNSServer, serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, false),
-		st_server(serverPort)
+		SmartThingsHttpTransport<WiFiServer, WiFiClient>(localIP, localGateway, localSubnetMask, localDNSServer, serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, false)
 	{
 		ssid.toCharArray(st_ssid, sizeof(st_ssid));
 		password.toCharArray(st_password, sizeof(st_password));
@@ -34,8 +38,7 @@ namespace st
 	// SmartThingsESP8266WiFI Constructor - DHCP
 	//*******************************************************************************
 	SmartThingsESP8266WiFi::SmartThingsESP8266WiFi(String ssid, String password, uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType, bool enableDebug, int transmitInterval) :
-		SmartThingsEthernet(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true),
-		st_server(serverPort)
+		SmartThingsHttpTransport<WiFiServer, WiFiClient>(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true)
 	{
 		ssid.toCharArray(st_ssid, sizeof(st_ssid));
 		password.toCharArray(st_password, sizeof(st_password));
@@ -45,8 +48,7 @@ namespace st
 	// SmartThingsESP8266WiFI Constructor - DHCP
 	//*******************************************************************************
 	SmartThingsESP8266WiFi::SmartThingsESP8266WiFi(uint16_t serverPort, IPAddress hubIP, uint16_t hubPort, SmartThingsCallout_t *callout, String shieldType, bool enableDebug, int transmitInterval) :
-		SmartThingsEthernet(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true),
-		st_server(serverPort)
+		SmartThingsHttpTransport<WiFiServer, WiFiClient>(serverPort, hubIP, hubPort, callout, shieldType, enableDebug, transmitInterval, true)
 	{
 		st_preExistingConnection = true;
 	}
@@ -169,16 +171,13 @@ namespace st
 		Serial.println();
 	}
 
-	//*****************************************************************************
-	// Run SmartThingsESP8266WiFI Library
-	//*****************************************************************************
-	void SmartThingsESP8266WiFi::run(void)
+	//*******************************************************************************
+	/// Called by run() on every pass, before the Hub's requests are read
+	//*******************************************************************************
+	void SmartThingsESP8266WiFi::maintainLink()
 	{
-
 		ArduinoOTA.handle();
 
-		String readString;
-		String tempString;
 		String strRSSI;
 
 		if (WiFi.isConnected() == false)
@@ -213,85 +212,12 @@ namespace st
 				}
 			}
 		}
-
-		WiFiClient client = st_server.available();
-		if (client) {
-			boolean currentLineIsBlank = true;
-			while (client.connected()) {
-				if (client.available()) {
-					char c = client.read();
-					//read char by char HTTP request
-					if (readString.length() < 200) {
-						//store characters to string
-						readString += c;
-					}
-					else
-					{
-						if (_isDebugEnabled)
-						{
-							Serial.println(F(""));
-							Serial.println(F("SmartThings.run() - Exceeded 200 character limit"));
-							Serial.println(F(""));
-						}
-					}
-					// if you've gotten to the end of the line (received a newline
-					// character) and the line is blank, the http request has ended,
-					// so you can send a reply
-					if (c == '\n' && currentLineIsBlank) {
-						//now output HTML data header
-						tempString = readString.substring(readString.indexOf('/') + 1, readString.indexOf('?'));
-
-						if (tempString.length() > 0) {
-							client.println(F("HTTP/1.1 200 OK")); //send new page
-							client.println();
-						}
-						else {
-							client.println(F("HTTP/1.1 204 No Content"));
-							client.println();
-							client.println();
-							if (_isDebugEnabled)
-							{
-								Serial.println(F("No Valid Data Received"));
-							}
-						}
-						break;
-					}
-					if (c == '\n') {
-						// you're starting a new line
-						currentLineIsBlank = true;
-					}
-					else if (c != '\r') {
-						// you've gotten a character on the current line
-						currentLineIsBlank = false;
-					}
-				}
-			}
-
-			delay(1);
-			//stopping client
-			client.stop();
-
-			//Handle the received data after cleaning up the network connection
-			if (tempString.length() > 0) {
-				if (_isDebugEnabled)
-				{
-					Serial.print(F("Handling request from ST. tempString = "));
-					Serial.println(tempString);
-				}
-				//Pass the message to user's SmartThings callout function
-				tempString.replace("%20", " ");  //Clean up for Hubitat
-				_calloutFunction(tempString);
-			}
-
-			readString = "";
-			tempString = "";
-		}
 	}
 
 	//*******************************************************************************
-	/// Send Message out over Ethernet to the Hub
+	/// Called by send() before every POST
 	//*******************************************************************************
-	void SmartThingsESP8266WiFi::send(String message)
+	void SmartThingsESP8266WiFi::checkLink()
 	{
 		if (WiFi.isConnected() == false)
 		{
@@ -304,81 +230,29 @@ namespace st
 
 			//init();
 		}
+	}
 
-		//Make sure the client is stopped, to free up socket for new conenction
-		st_client.stop();
-
-		if (st_client.connect(st_hubIP, st_hubPort))
-		{
-			st_client.println(F("POST / HTTP/1.1"));
-			st_client.print(F("HOST: "));
-			st_client.print(st_hubIP);
-			st_client.print(F(":"));
-			st_client.println(st_hubPort);
-			st_client.println(F("CONTENT-TYPE: text"));
-			st_client.print(F("CONTENT-LENGTH: "));
-			st_client.println(message.length());
-			st_client.println();
-			st_client.println(message);
-		}
-		else
+	//*******************************************************************************
+	/// Called when a POST could not connect to the Hub, before it is retried
+	//*******************************************************************************
+	void SmartThingsESP8266WiFi::restartLink()
+	{
+		if (_isDebugEnabled)
 		{
-			//connection failed;
-			if (_isDebugEnabled)
-			{
-				Serial.println(F("***********************************************************"));
-				Serial.println(F("***** SmartThings.send() - Ethernet Connection Failed *****"));
-				Serial.println(F("***********************************************************"));
-				Serial.print(F("hubIP = "));
-				Serial.print(st_hubIP);
-				Serial.print(F(" "));
-				Serial.print(F("hubPort = "));
-				Serial.println(st_hubPort);
-
-				Serial.println(F("***********************************************************"));
-				Serial.println(F("**** WiFi Disconnected.  ESP8266 should auto-reconnect ****"));
-				Serial.println(F("***********************************************************"));
-			}
-
-			//init();      //Re-Init connection to get things working again
-
-			if (_isDebugEnabled)
-			{
-				Serial.println(F("***********************************************************"));
-				Serial.println(F("******        Attempting to resend missed data      *******"));
-				Serial.println(F("***********************************************************"));
-			}
-
-
-			st_client.flush();
-			st_client.stop();
-			if (st_client.connect(st_hubIP, st_hubPort))
-			{
-				st_client.println(F("POST / HTTP/1.1"));
-				st_client.print(F("HOST: "));
-				st_client.print(st_hubIP);
-				st_client.print(F(":"));
-				st_client.println(st_hubPort);
-				st_client.println(F("CONTENT-TYPE: text"));
-				st_client.print(F("CONTENT-LENGTH: "));
-				st_client.println(message.length());
-				st_client.println();
-				st_client.println(message);
-			}
-
+			Serial.println(F("***********************************************************"));
+			Serial.println(F("**** WiFi Disconnected.  ESP8266 should auto-reconnect ****"));
+			Serial.println(F("***********************************************************"));
 		}
 
-		//if (_isDebugEnabled) { Serial.println(F("WiFi.send(): Reading for reply data "));}
-		// read any data returned from the POST
-		//while (st_client.connected()) {
-		    while (st_client.available()) {
-			    char c = st_client.read(); //gets byte from ethernet buffer
-				//if (_isDebugEnabled) { Serial.print(c); } //prints byte to serial monitor
-			}
-		//}
+		//init();      //Re-Init connection to get things working again
+	}
 
-		delay(1);
-		st_client.stop();
+	//*******************************************************************************
+	/// Returns false while WiFi is disconnected
+	//*******************************************************************************
+	bool SmartThingsESP8266WiFi::isNetworkConnected()
+	{
+		return WiFi.isConnected();
 	}
 
 }
@@ -11,12 +11,17 @@
 //  2018-12-10  Dan Ogorchock  Add user selectable host name (repurposing the old shieldType variable)
 //  2019-05-01  Dan Ogorchock  Changed max transmit rate from every 100ms to every 
 //                             500ms to prevent duplicate child devices
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSESP8266WIFI_H__
 #define __SMARTTHINGSESP8266WIFI_H__
 
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 
 //*******************************************************************************
 // Using ESP8266 WiFi
@@ -26,19 +31,38 @@
 
 namespace st
 {
-	class SmartThingsESP8266WiFi: public SmartThingsEthernet
+	class SmartThingsESP8266WiFi: public SmartThingsHttpTransport<WiFiServer, WiFiClient>
 	{
 	private:
 		//ESP8266 WiFi Specific
 		char st_ssid[50];
 		char st_password[50];
 		boolean st_preExistingConnection = false;
-		WiFiServer st_server; //server
-		WiFiClient st_client; //client
 		long previousMillis;
 		long RSSIsendInterval;
 		char st_devicename[50];
 
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called by send() before every POST
+		//*******************************************************************************
+		virtual void checkLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
+		//*******************************************************************************
+		/// Returns false while WiFi is disconnected
+		//*******************************************************************************
+		virtual bool isNetworkConnected();
+
 	public:
 
 		//*******************************************************************************
@@ -92,16 +116,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsESP8266WiFI Library
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
@@ -10,13 +10,18 @@
 //  2019-05-01  Dan Ogorchock  Changed max transmit rate from every 100ms to every 
 //                             500ms to prevent duplicate child devices
 //  2020-04-18  Dan Ogorchock  Unified Arduino Ethernet Shield Class for 5100, 5200, 5500
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSETHERNETW5x00_H__ 
 #define __SMARTTHINGSETHERNETW5x00_H__
 
 
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 #include <SPI.h>
 #include <Ethernet.h>
 
@@ -26,13 +31,27 @@
 
 namespace st
 {
-	class SmartThingsEthernetW5x00: public SmartThingsEthernet
+	class SmartThingsEthernetW5x00: public SmartThingsHttpTransport<EthernetServer, EthernetClient>
 	{
 	private:
 		//Ethernet W5x00 Specific 
 		byte st_mac[6];
-		EthernetServer st_server; //server
-		EthernetClient st_client; //client
+
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
+		//*******************************************************************************
+		/// Returns false while the Ethernet cable is unplugged (a W5100, which cannot tell, always reports the link up)
+		//*******************************************************************************
+		virtual bool isNetworkConnected();
 
 	public:
 
@@ -74,16 +93,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsEthernet Library 
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub 
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
@@ -10,13 +10,18 @@
 //  2018-01-01  Dan Ogorchock  Added WiFi.RSSI() data collection
 //  2019-05-01  Dan Ogorchock  Changed max transmit rate from every 100ms to every 
 //                             500ms to prevent duplicate child devices
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSWIFI101_H__ 
 #define __SMARTTHINGSWIFI101_H__
 
 
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 
 //*******************************************************************************
 // Using WiFi101 library for the Arduino WiFi 101 shield or Adafruit ATWINC1500 
@@ -27,17 +32,36 @@
 
 namespace st
 {
-	class SmartThingsWiFi101: public SmartThingsEthernet
+	class SmartThingsWiFi101: public SmartThingsHttpTransport<WiFiServer, WiFiClient>
 	{
 	private:
 		//WiFi Specific
 		char st_ssid[50];
 		char st_password[50];
-		WiFiServer st_server; //server
-		WiFiClient st_client; //client
 		long previousMillis;
 		long RSSIsendInterval;
 
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called by send() before every POST
+		//*******************************************************************************
+		virtual void checkLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
+		//*******************************************************************************
+		/// Returns false while WiFi is disconnected
+		//*******************************************************************************
+		virtual bool isNetworkConnected();
+
 	public:
 
 		//*******************************************************************************
@@ -80,16 +104,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsWiFi101 Library 
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub 
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
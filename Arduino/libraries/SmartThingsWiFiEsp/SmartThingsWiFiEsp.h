@@ -9,13 +9,17 @@
 //  2018-01-06  Dan Ogorchock  Added WiFi.RSSI() data collection
 //  2019-05-01  Dan Ogorchock  Changed max transmit rate from every 100ms to every 
 //                             500ms to prevent duplicate child devices
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //*******************************************************************************
 
 #ifndef __SMARTTHINGSWIFIESP_H__ 
 #define __SMARTTHINGSWIFIESP_H__
 
 
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 
 //*******************************************************************************
 // Using WiFiEsp library for the ESP-01 board
@@ -25,18 +29,27 @@
 
 namespace st
 {
-	class SmartThingsWiFiEsp: public SmartThingsEthernet
+	class SmartThingsWiFiEsp: public SmartThingsHttpTransport<WiFiEspServer, WiFiEspClient>
 	{
 	private:
 		//WiFi Specific
 		char st_ssid[50];
 		char st_password[50];
-		WiFiEspServer st_server; //server
-		WiFiEspClient st_client; //client
 		Stream* st_espSerial;    //Serial UART used to commincate with the ESP-01 board
 		long previousMillis;
 		long RSSIsendInterval;
 
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
 	public:
 
 		//*******************************************************************************
@@ -78,16 +91,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsWiFiEsp Library 
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub 
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
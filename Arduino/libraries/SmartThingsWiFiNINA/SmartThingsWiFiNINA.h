@@ -9,6 +9,11 @@
 //	History
 //	2019-06-23  Dan Ogorchock  Created
 //  2019-08-17  Dan Ogorchock  NANO33IoT 
+//  2026-10-18  agent          Hub POSTs are sent without blocking (SmartThingsHttpClient)
+//  2026-10-18  agent          The Hub's requests are read without blocking (SmartThingsHttpServer)
+//  2026-10-18  agent          Added isLinkUp(), so st::Everything can keep its messages while the link is down
+//  2026-10-18  agent          Failed POSTs back off and trip a circuit breaker instead of retrying at once (SmartThingsHubHealth)
+//  2026-10-18  agent          run()/send() moved to the shared SmartThingsHttpTransport core - only the link bring-up is left here
 //
 //*******************************************************************************
 
@@ -16,7 +21,7 @@
 #define __SMARTTHINGSWIFININA_H__
 
 
-#include "SmartThingsEthernet.h"
+#include "SmartThingsHttpTransport.h"
 
 //*******************************************************************************
 // Using WiFiNINA library for the Arduino MKR 1010 or similar 
@@ -27,17 +32,36 @@
 
 namespace st
 {
-	class SmartThingsWiFiNINA: public SmartThingsEthernet
+	class SmartThingsWiFiNINA: public SmartThingsHttpTransport<WiFiServer, WiFiClient>
 	{
 	private:
 		//WiFi Specific
 		char st_ssid[50];
 		char st_password[50];
-		WiFiServer st_server; //server
-		WiFiClient st_client; //client
 		long previousMillis;
 		long RSSIsendInterval;
 
+	protected:
+		//*******************************************************************************
+		/// Called by run() on every pass, before the Hub's requests are read
+		//*******************************************************************************
+		virtual void maintainLink();
+
+		//*******************************************************************************
+		/// Called by send() before every POST
+		//*******************************************************************************
+		virtual void checkLink();
+
+		//*******************************************************************************
+		/// Called when a POST could not connect to the Hub, before it is retried
+		//*******************************************************************************
+		virtual void restartLink();
+
+		//*******************************************************************************
+		/// Returns false while WiFi is disconnected
+		//*******************************************************************************
+		virtual bool isNetworkConnected();
+
 	public:
 
 		//*******************************************************************************
@@ -80,16 +104,6 @@ namespace st
 		//*******************************************************************************
 		virtual void init(void);
 
-		//*******************************************************************************
-		/// Run SmartThingsWiFiNINA Library 
-		//*******************************************************************************
-		virtual void run(void);
-
-		//*******************************************************************************
-		/// Send Message to the Hub 
-		//*******************************************************************************
-		virtual void send(String message);
-
 	};
 }
 #endif
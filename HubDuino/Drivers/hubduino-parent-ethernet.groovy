@@ -50,6 +50,11 @@
  *    2020-06-25  Dan Ogorchock  Added Window Shade
  *    2020-09-19  Dan Ogorchock  Added "Releasable Button" Capability (requires new Arduino IS_Button.cpp and .h code)
  *    2022-02-08  Dan Ogorchock  Added support for new custom "weight measurement" child device
+ *    2026-10-18  agent          Accept batched updates (several newline-delimited updates in one POST body)
+ *    2026-10-18  agent          Added "profile" attribute for the optional Arduino loop-time profiler summary (send "profile" via sendData to request one)
+ *    2026-10-18  agent          Added "memory" attribute for the Arduino's memory telemetry (send "memory" via sendData to request one)
+ *    2026-10-18  agent          Accept updates replayed from the Arduino's message spool (" @<ms since captured>" appended)
+ *    2026-10-18  agent          Added "UDP" protocol preference for Arduinos using st::SmartThingsUdp ("D<seq> <message>" datagrams, "A<seq>" acknowledgements)
  *	
  */
  
@@ -62,6 +67,9 @@ metadata {
         capability "Signal Strength"
         capability "Presence Sensor"  //used to determine is the HubDuino microcontroller is still reporting data or not
         
+        attribute "profile", "string"	//"<device name>:<microseconds>" - slowest device call reported by the Arduino's optional profiler
+        attribute "memory", "string"	//"<free heap>:<largest free block>:<fragmentation %>:<min free heap>:<stack headroom>" - in bytes, -1 if not measured on that board
+        
         command "sendData", ["string"]
         //command "deleteAllChildDevices"
 	}
@@ -70,6 +78,7 @@ metadata {
 	preferences {
 		input "ip", "text", title: "Arduino IP Address", description: "IP Address in form 192.168.1.226", required: true, displayDuringSetup: true
 		input "port", "text", title: "Arduino Port", description: "port in form of 8090", defaultValue: "8090",required: true, displayDuringSetup: true
+        input "protocol", "enum", title: "Protocol", description: "HTTP for the Ethernet/WiFi classes, UDP for st::SmartThingsUdp (the sketch's hubPort must then be 39501)", options: ["HTTP", "UDP"], defaultValue: "HTTP", required: true, displayDuringSetup: true
         input "timeOut", "number", title: "Timeout in Seconds", description: "Max time w/o HubDuino update before setting presence to 'not present'", defaultValue: "900", range: "600..*",required: true, displayDuringSetup:true
         input name: "logEnable", type: "bool", title: "Enable debug logging", defaultValue: true
     }
@@ -92,9 +101,41 @@ def parse(String description) {
     }
 
     def bodyString = msg.body
+    if (msg.payload && !bodyString) {
+        //a UDP datagram from st::SmartThingsUdp
+        bodyString = parseDatagram(new String(hubitat.helper.HexUtils.hexStringToByteArray(msg.payload)))
+    }
 
     if (bodyString) {
         if (logEnable) log.debug "msg= $bodyString"
+        
+        if (device.currentValue("presence") != "present") {
+            sendEvent(name: "presence", value: "present", isStateChange: true, descriptionText: "New update received from HubDuino device")
+        }
+        
+        //Keep track of when the last update came in from the Arduino board
+        state.parseLastRanAt = now()
+
+        //The Arduino may batch several updates into one POST, one "name value" update per line
+        def results = []
+        bodyString.split("\n").each { line ->
+            if (line.trim()) {
+                def result = parseUpdate(line.trim(), mac)
+                if (result) results << result
+            }
+        }
+        return results.flatten()
+    }
+}
+
+private parseUpdate(String bodyString, mac) {
+    	//Updates held back by the Arduino's message spool while its network was down end with " @<milliseconds since captured>" (" @?" if captured before a restart)
+    	def replayed = bodyString.lastIndexOf(" @")
+    	if (replayed > 0) {
+            def age = bodyString.substring(replayed + 2)
+            bodyString = bodyString.substring(0, replayed)
+            if (logEnable) log.debug "Replayed update '${bodyString}', captured " + (age == "?" ? "before the Arduino restarted" : "${age} ms ago")
+        }
     	def parts = bodyString.split(" ")
     	def name  = parts.length>0?parts[0].trim():null
     	def value = parts.length>1?parts[1].trim():null
@@ -104,13 +145,6 @@ def parse(String description) {
         def namenum = name.substring(namebase.length()).trim()
 		
         def results = []
-        
-        if (device.currentValue("presence") != "present") {
-            sendEvent(name: "presence", value: "present", isStateChange: true, descriptionText: "New update received from HubDuino device")
-        }
-        
-        //Keep track of when the last update came in from the Arduino board
-        state.parseLastRanAt = now()
                 
 		if (name.startsWith("button")) {
             if (logEnable) log.debug "In parse:  name = ${name}, value = ${value}, btnNum = " + namenum
@@ -129,6 +163,12 @@ def parse(String description) {
             }
         }
 
+		if (name == "profile" || name == "memory") {
+			if (logEnable) log.debug "In parse: ${name} = ${value}"
+           	results = createEvent(name: name, value: value, displayed: false)
+			return results
+        }
+
 		if (name.startsWith("rssi")) {
 			if (logEnable) log.debug "In parse: RSSI name = ${name}, value = ${value}"
            	results = createEvent(name: name, value: value, displayed: false)
@@ -191,8 +231,71 @@ def parse(String description) {
         catch (e) {
         	log.error "Error in parse() routine, error = ${e}"
         }
+}
 
-	}
+//Handles a datagram from st::SmartThingsUdp - returns the update(s) it carries, or null for an
+//acknowledgement or a retransmission of an update that has already been parsed
+private parseDatagram(String datagram) {
+    def matcher = datagram =~ /^([AD])(\d+)( ([\s\S]*))?$/
+    if (!matcher.matches()) {
+        if (logEnable) log.debug "Ignoring datagram '${datagram}'"
+        return null
+    }
+    def seq = matcher.group(2).toInteger()
+
+    if (matcher.group(1) == "A") {
+        //the Arduino has received the command with this sequence number - stop retransmitting it
+        if (state.udpPending) state.udpPending.remove(seq.toString())
+        return null
+    }
+
+    //acknowledge every update, even a retransmitted one - the Arduino resends it until our acknowledgement arrives
+    sendUdp("A${seq}")
+    def received = state.udpReceived ?: []
+    if (received.contains(seq)) {
+        if (logEnable) log.debug "Ignoring retransmitted datagram ${seq}"
+        return null
+    }
+    received << seq
+    state.udpReceived = received.takeRight(16)
+    return matcher.group(4)
+}
+
+private sendUdp(String datagram) {
+    if (logEnable) log.debug "Sending datagram '${datagram}'"
+    sendHubCommand(new hubitat.device.HubAction(datagram, hubitat.device.Protocol.LAN,
+        [type: hubitat.device.HubAction.Type.LAN_TYPE_UDPCLIENT,
+         destinationAddress: getHostAddress(),
+         encoding: hubitat.device.HubAction.Encoding.NONE,
+         ignoreResponse: true]))
+}
+
+//Sends a command to an Arduino using st::SmartThingsUdp - it is sent again every second until acknowledged, at most 8 times
+private sendCommandUdp(message) {
+    def seq = state.udpNextSeq ?: 0
+    state.udpNextSeq = (seq + 1) & 0xFFFF
+    def pending = state.udpPending ?: [:]
+    pending[seq.toString()] = [message: message, retransmits: 0]
+    state.udpPending = pending
+    sendUdp("D${seq} ${message}")
+    runIn(1, "retransmitUdp")
+}
+
+def retransmitUdp() {
+    def pending = state.udpPending ?: [:]
+    pending.keySet().toList().each { seq ->
+        def entry = pending[seq]
+        if (entry.retransmits >= 8) {
+            log.warn "No acknowledgement from the HubDuino device - command '${entry.message}' lost"
+            pending.remove(seq)
+        }
+        else {
+            entry.retransmits = entry.retransmits + 1
+            sendUdp("D${seq} ${entry.message}")
+        }
+    }
+    state.udpPending = pending
+    if (pending) runIn(1, "retransmitUdp")
 }
 
 private getHostAddress() {
@@ -208,6 +311,15 @@ def sendData(message) {
 }
 
 def sendEthernet(message) {
+    if (settings.protocol == "UDP") {
+        if (settings.ip != null && settings.port != null) {
+            sendCommandUdp(message)
+        }
+        else {
+            log.warn "Parent HubDuino Ethernet Device: Please verify IP address and Port are configured."
+        }
+        return
+    }
     if (message.contains(" ")) {
         def parts = message.split(" ")
         def name  = parts.length>0?parts[0].trim():null
@@ -265,6 +377,10 @@ def updated() {
     
     unschedule()
     
+    //start from a random sequence number, so the Arduino does not take the first commands after a change for retransmissions
+    state.udpNextSeq = new Random().nextInt(65536)
+    state.udpPending = [:]
+    
     if (logEnable) {
         log.info "Enabling Debug Logging for 30 minutes" 
         runIn(1800,logsOff)